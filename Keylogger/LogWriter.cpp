@@ -0,0 +1,258 @@
+#include "LogWriter.h"
+#include <charconv>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::string currentDateTimeString() {
+        auto now = std::time(nullptr);
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &now);
+#else
+        localtime_r(&now, &tm);
+#endif
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y%m%d_%H%M%S");
+        return oss.str();
+    }
+
+    int openForWrite(const std::string& filename) {
+#ifdef _WIN32
+        int fd = -1;
+        _sopen_s(&fd, filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _SH_DENYWR, _S_IREAD | _S_IWRITE);
+        return fd;
+#else
+        return ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    }
+
+    bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+#ifdef _WIN32
+            int written = _write(fd, data, static_cast<unsigned int>(size > 0x40000000 ? 0x40000000 : size));
+#else
+            ssize_t written = ::write(fd, data, size);
+#endif
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    void syncFile(int fd) {
+#ifdef _WIN32
+        _commit(fd);
+#else
+        ::fsync(fd);
+#endif
+    }
+
+    void closeFile(int fd) {
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+}
+
+LogWriter::LogWriter(const Options& options)
+    : options_(options), echoWindowStart_(std::chrono::steady_clock::now()) {
+    buffer_.reserve(options_.bufferBytes + BinaryEventLog::FILE_HEADER_SIZE +
+        BinaryEventLog::DEFAULT_BLOCK_EVENTS * BinaryEventLog::MAX_EVENT_SIZE + 64);
+    openNextFile();
+}
+
+LogWriter::~LogWriter() {
+    close();
+}
+
+void LogWriter::openNextFile() {
+    const char* extension = options_.format == Format::BINARY ? ".kmdl" : ".csv";
+    filename_ = options_.filePrefix + currentDateTimeString();
+    if (fileSequence_ > 0) {
+        filename_ += "_" + std::to_string(fileSequence_);
+    }
+    filename_ += extension;
+    fileSequence_++;
+
+    fd_ = openForWrite(filename_);
+    if (fd_ < 0) {
+        throw std::runtime_error("Could not open file: " + filename_);
+    }
+    stats_.filesOpened++;
+    fileBytes_ = 0;
+    fileOpenedAt_ = std::chrono::steady_clock::now();
+
+    if (options_.format == Format::BINARY) {
+        buffer_ += BinaryEventLog::fileHeader();
+    }
+    else {
+        buffer_ += "Timestamp,EventType,KeyCode\n";
+    }
+    if (!hasBufferedData_) {
+        oldestBuffered_ = fileOpenedAt_;
+        hasBufferedData_ = true;
+    }
+}
+
+void LogWriter::write(const InputEvent* events, size_t count) {
+    if (fd_ < 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const InputEvent& event = events[i];
+        const long long timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            event.timestamp.time_since_epoch()).count();
+
+        if (!hasBufferedData_) {
+            oldestBuffered_ = std::chrono::steady_clock::now();
+            hasBufferedData_ = true;
+        }
+
+        if (options_.format == Format::BINARY) {
+            binaryEncoder_.add({timestampMs, event.type == EventType::KEY_UP, event.keyCode}, buffer_);
+        }
+        else {
+            char row[48];
+            char* cursor = std::to_chars(row, row + 24, timestampMs).ptr;
+            const char* typeText = event.type == EventType::KEY_DOWN ? ",KEY_DOWN," : ",KEY_UP,";
+            while (*typeText) {
+                *cursor++ = *typeText++;
+            }
+            cursor = std::to_chars(cursor, row + sizeof(row) - 1, event.keyCode).ptr;
+            *cursor++ = '\n';
+            buffer_.append(row, cursor);
+        }
+        bufferedEvents_++;
+
+        if (options_.consoleEcho) {
+            echo(event, timestampMs);
+        }
+
+        // 크기 로테이션은 버퍼가 차기를 기다리지 않고 이벤트마다 확인 (버퍼 크기만큼 넘지 않도록)
+        if (buffer_.size() >= options_.bufferBytes ||
+            (options_.rotateBytes > 0 && fileBytes_ + buffer_.size() >= options_.rotateBytes)) {
+            writeBuffer();
+            rotateIfNeeded();
+        }
+    }
+
+    if (options_.consoleEcho) {
+        std::cout.flush();
+    }
+}
+
+void LogWriter::poll() {
+    if (fd_ < 0) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if ((hasBufferedData_ || binaryEncoder_.pendingEvents() > 0) &&
+        now - oldestBuffered_ >= options_.flushInterval) {
+        flush();
+    }
+    rotateIfNeeded();
+
+    if (options_.consoleEcho && suppressedInWindow_ > 0 && now - echoWindowStart_ >= std::chrono::seconds(1)) {
+        std::cout << "... " << suppressedInWindow_ << " events not echoed\n" << std::flush;
+        suppressedInWindow_ = 0;
+    }
+}
+
+void LogWriter::flush() {
+    if (fd_ < 0) {
+        return;
+    }
+    // 이진 형식은 가득 차지 않은 블록도 닫아서 기록
+    binaryEncoder_.flushBlock(buffer_);
+    writeBuffer();
+    if (options_.fsyncOnFlush) {
+        syncFile(fd_);
+    }
+}
+
+void LogWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    binaryEncoder_.flushBlock(buffer_);
+    writeBuffer();
+    if (options_.fsyncOnFlush) {
+        syncFile(fd_);
+    }
+    closeFile(fd_);
+    fd_ = -1;
+}
+
+void LogWriter::writeBuffer() {
+    if (!buffer_.empty()) {
+        // 이진 형식에서 아직 닫히지 않은 블록의 이벤트는 버퍼에 없으므로 다음 기록으로 넘김
+        const uint64_t pendingEvents = binaryEncoder_.pendingEvents();
+        const uint64_t events = bufferedEvents_ - pendingEvents;
+        stats_.writeCalls++;
+        if (writeAll(fd_, buffer_.data(), buffer_.size())) {
+            stats_.eventsWritten += events;
+            stats_.bytesWritten += buffer_.size();
+            fileBytes_ += buffer_.size();
+        }
+        else {
+            std::cerr << "Warning: Failed to write " << buffer_.size() << " bytes to " << filename_
+                << ", " << events << " events dropped" << std::endl;
+            stats_.eventsDropped += events;
+            stats_.bytesFailed += buffer_.size();
+        }
+        buffer_.clear();
+        bufferedEvents_ = pendingEvents;
+    }
+    hasBufferedData_ = false;
+}
+
+void LogWriter::rotateIfNeeded() {
+    const bool sizeExceeded = options_.rotateBytes > 0 && fileBytes_ >= options_.rotateBytes;
+    const bool timeExceeded = options_.rotateInterval.count() > 0 &&
+        std::chrono::steady_clock::now() - fileOpenedAt_ >= options_.rotateInterval;
+    if (!sizeExceeded && !timeExceeded) {
+        return;
+    }
+    close();
+    openNextFile();
+}
+
+void LogWriter::echo(const InputEvent& event, long long timestampMs) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - echoWindowStart_ >= std::chrono::seconds(1)) {
+        if (suppressedInWindow_ > 0) {
+            std::cout << "... " << suppressedInWindow_ << " events not echoed\n";
+        }
+        echoWindowStart_ = now;
+        echoedInWindow_ = 0;
+        suppressedInWindow_ = 0;
+    }
+    if (echoedInWindow_ >= options_.consoleEchoPerSecond) {
+        suppressedInWindow_++;
+        stats_.echoSuppressed++;
+        return;
+    }
+    echoedInWindow_++;
+    std::cout << "Time: " << timestampMs << "ms, "
+        << "Type: " << (event.type == EventType::KEY_DOWN ? "KEY_DOWN" : "KEY_UP")
+        << ", KeyCode: " << event.keyCode << '\n';
+}
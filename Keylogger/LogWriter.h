@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "InputEvent.h"
+#include "../Parser/include/BinaryEventLog.h"
+
+// 키 이벤트 로그 기록기 (플랫폼 독립)
+// - 재사용 버퍼에 행을 포맷하고 버퍼가 차거나 flushInterval이 지나면 한 번에 기록
+// - 크기/시간 기준 파일 로테이션, flush마다 fsync 선택 가능
+// - 콘솔 출력은 초당 개수를 제한하는 디버그 모드
+class LogWriter {
+public:
+    enum class Format {
+        CSV,
+        BINARY
+    };
+
+    struct Options {
+        Format format = Format::CSV;
+        std::string filePrefix = "keyboard_log_";
+        size_t bufferBytes = 1 << 20;
+        uint64_t rotateBytes = 0;                          // 0이면 크기 로테이션 없음 (CSV는 한 행, 이진 형식은 한 블록까지 넘을 수 있음)
+        std::chrono::seconds rotateInterval{0};            // 0이면 시간 로테이션 없음
+        std::chrono::milliseconds flushInterval{1000};     // 버퍼에 머무를 수 있는 최대 시간
+        bool fsyncOnFlush = false;
+        bool consoleEcho = false;
+        unsigned int consoleEchoPerSecond = 20;
+    };
+
+    struct Stats {
+        uint64_t eventsWritten = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t writeCalls = 0;
+        uint64_t filesOpened = 0;
+        uint64_t echoSuppressed = 0;
+        // 기록에 실패하여 버린 이벤트/바이트 (위의 기록 통계에는 포함하지 않음)
+        uint64_t eventsDropped = 0;
+        uint64_t bytesFailed = 0;
+    };
+
+    explicit LogWriter(const Options& options);
+    ~LogWriter();
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    void write(const InputEvent* events, size_t count);
+    // 시간 기준 flush/로테이션 확인 (기록 스레드가 주기적으로 호출)
+    void poll();
+    void flush();
+    void close();
+
+    bool isOpen() const { return fd_ >= 0; }
+    const std::string& currentFilename() const { return filename_; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    void openNextFile();
+    void writeBuffer();
+    void rotateIfNeeded();
+    void echo(const InputEvent& event, long long timestampMs);
+
+    Options options_;
+    Stats stats_;
+    int fd_ = -1;
+    std::string filename_;
+    unsigned int fileSequence_ = 0;
+    uint64_t fileBytes_ = 0;
+    std::chrono::steady_clock::time_point fileOpenedAt_;
+
+    std::string buffer_;
+    std::chrono::steady_clock::time_point oldestBuffered_;
+    bool hasBufferedData_ = false;
+    uint64_t bufferedEvents_ = 0; // 포맷했지만 아직 기록하지 않은 이벤트 (이진 형식은 열린 블록 포함)
+    BinaryEventLog::BlockEncoder binaryEncoder_;
+
+    std::chrono::steady_clock::time_point echoWindowStart_;
+    unsigned int echoedInWindow_ = 0;
+    uint64_t suppressedInWindow_ = 0;
+};
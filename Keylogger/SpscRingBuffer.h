@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+#endif
+
+// 생산자가 한 번 신호하면 소비자가 깨어날 때까지 상태가 유지되는 자동 리셋 이벤트
+// (Windows: 자동 리셋 Event, POSIX: 세마포어) - signal()은 락을 잡지 않음
+class WakeupEvent {
+public:
+#ifdef _WIN32
+    WakeupEvent() : handle_(CreateEvent(NULL, FALSE, FALSE, NULL)) {}
+    ~WakeupEvent() { CloseHandle(handle_); }
+    void signal() { SetEvent(handle_); }
+    bool wait(std::chrono::milliseconds timeout) {
+        return WaitForSingleObject(handle_, static_cast<DWORD>(timeout.count())) == WAIT_OBJECT_0;
+    }
+private:
+    HANDLE handle_;
+#else
+    WakeupEvent() { sem_init(&semaphore_, 0, 0); }
+    ~WakeupEvent() { sem_destroy(&semaphore_); }
+    void signal() { sem_post(&semaphore_); }
+    bool wait(std::chrono::milliseconds timeout) {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        long long nanoseconds = deadline.tv_nsec + static_cast<long long>(timeout.count()) * 1000000LL;
+        deadline.tv_sec += static_cast<time_t>(nanoseconds / 1000000000LL);
+        deadline.tv_nsec = static_cast<long>(nanoseconds % 1000000000LL);
+        while (sem_timedwait(&semaphore_, &deadline) != 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+private:
+    sem_t semaphore_;
+#endif
+public:
+    WakeupEvent(const WakeupEvent&) = delete;
+    WakeupEvent& operator=(const WakeupEvent&) = delete;
+};
+
+// 단일 생산자/단일 소비자 링 버퍼 (플랫폼 독립)
+// - 생산자(키보드 훅)는 할당/락 없이 tryPush만 호출, 가득 차면 버리고 overflow 카운트 증가
+// - 소비자(기록 스레드)는 waitForData로 잠들었다가 생산자의 신호로 깨어나 popBatch로 일괄 수거
+template <typename T, size_t Capacity>
+class SpscRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscRingBuffer() : buffer_(new T[Capacity]) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // 생산자 전용
+    bool tryPush(const T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ == Capacity) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ == Capacity) {
+                overflowCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buffer_[head & (Capacity - 1)] = item;
+        head_.store(head + 1, std::memory_order_seq_cst);
+
+        // 소비자가 잠들어 있을 때만 깨움 (head_ 저장과 consumerWaiting_ 확인 모두 seq_cst)
+        if (consumerWaiting_.load(std::memory_order_seq_cst)) {
+            consumerWaiting_.store(false, std::memory_order_relaxed);
+            wakeup_.signal();
+        }
+        return true;
+    }
+
+    // 소비자 전용: 최대 maxItems개를 out에 복사하고 개수 반환
+    size_t popBatch(T* out, size_t maxItems) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        size_t count = head - tail;
+        if (count > maxItems) {
+            count = maxItems;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = buffer_[(tail + i) & (Capacity - 1)];
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // 소비자 전용: 데이터가 들어오거나 timeout이 지날 때까지 대기. 데이터가 있으면 true
+    bool waitForData(std::chrono::milliseconds timeout) {
+        if (!empty()) {
+            return true;
+        }
+        consumerWaiting_.store(true, std::memory_order_seq_cst);
+        if (empty()) {
+            wakeup_.wait(timeout);
+        }
+        consumerWaiting_.store(false, std::memory_order_relaxed);
+        return !empty();
+    }
+
+    // 소비자 대기를 외부에서 깨움 (종료 시)
+    void wakeConsumer() { wakeup_.signal(); }
+
+    bool empty() const {
+        return head_.load(std::memory_order_seq_cst) == tail_.load(std::memory_order_relaxed);
+    }
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() { return Capacity; }
+
+    uint64_t overflowCount() const { return overflowCount_.load(std::memory_order_relaxed); }
+    uint64_t pushedCount() const { return head_.load(std::memory_order_relaxed); }
+
+private:
+    std::unique_ptr<T[]> buffer_;
+
+    // 생산자/소비자 변수를 서로 다른 캐시 라인에 배치
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<bool> consumerWaiting_{false};
+    std::atomic<uint64_t> overflowCount_{0};
+    WakeupEvent wakeup_;
+};
@@ -4,32 +4,24 @@
 #include <vector>
 #include <iostream>
 #include <thread>
-#include <mutex>
-#include <fstream>
-#include <ctime>
-#include <sstream>
-#include <iomanip>
+#include <atomic>
+#include <memory>
+#include "InputEvent.h"
+#include "SpscRingBuffer.h"
+#include "LogWriter.h"
 
 
-enum class EventType {
-    KEY_DOWN,
-    KEY_UP
-};
-
-struct InputEvent {
-    std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
-    EventType type;
-    unsigned int keyCode;
-};
-
 class KeyboardLogger {
 private:
-    std::vector<InputEvent> events;
-    bool isRunning;
+    // 훅 -> 기록 스레드: 락/할당 없는 SPSC 링 버퍼 (가득 차면 버리고 overflow 카운트)
+    SpscRingBuffer<InputEvent, 1 << 16> eventQueue;
+    std::vector<InputEvent> events; // 기록 스레드 전용 수거 버퍼 (큐 용량만큼 미리 할당)
+    std::atomic<bool> isRunning;
     HHOOK keyboardHook;
-    std::mutex eventsMutex;
-    std::ofstream logFile;
-    std::string filename;
+
+    // 기록 단계: 버퍼링/로테이션/콘솔 출력 정책은 LogWriter::Options로 설정
+    LogWriter::Options writerOptions;
+    std::unique_ptr<LogWriter> writer;
 
     static KeyboardLogger* instance;
     static LRESULT CALLBACK KeyboardProc(int nCode, WPARAM wParam, LPARAM lParam) {
@@ -48,8 +40,7 @@ private:
                 //std::cout << "Key released: " << event.keyCode << std::endl;
             }
 
-            std::lock_guard<std::mutex> lock(instance->eventsMutex);
-            instance->events.push_back(event);
+            instance->eventQueue.tryPush(event);
 
             if (event.keyCode == VK_ESCAPE) {
                 instance->isRunning = false;
@@ -58,29 +49,15 @@ private:
         return CallNextHookEx(NULL, nCode, wParam, lParam);
     }
 
-    std::string getCurrentDateTimeString() {
-        auto now = std::time(nullptr);
-        std::tm tm;
-        localtime_s(&tm, &now);
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%Y%m%d_%H%M%S");
-        return oss.str();
-    }
-
 public:
-    KeyboardLogger() : isRunning(false), keyboardHook(NULL) {
+    explicit KeyboardLogger(const LogWriter::Options& options)
+        : events(eventQueue.capacity()), isRunning(false), keyboardHook(NULL), writerOptions(options) {
         instance = this;
-        filename = "keyboard_log_" + getCurrentDateTimeString() + ".csv";
-        logFile.open(filename, std::ios::out);
-        if (logFile.is_open()) {
-            logFile << "Timestamp,EventType,KeyCode\n";
-        }
+        writer = std::make_unique<LogWriter>(writerOptions);
     }
 
     ~KeyboardLogger() {
-        if (logFile.is_open()) {
-            logFile.close();
-        }
+        writer->close();
     }
 
     void start() {
@@ -92,15 +69,18 @@ public:
 
         isRunning = true;
         std::cout << "Keyboard logging started... (Press ESC to exit)" << std::endl;
-        std::cout << "Log file: " << filename << std::endl;
+        std::cout << "Log file: " << writer->currentFilename() << std::endl;
         std::cout << "Press any key to test if logging is working..." << std::endl;
 
-        // 이벤트 출력을 위한 별도 스레드 시작
-        std::thread printThread([this]() {
+        // 기록 스레드 시작 (이벤트가 들어오면 훅의 신호로 깨어남)
+        std::thread writerThread([this]() {
             while (isRunning) {
-                printEvents();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                eventQueue.waitForData(writerOptions.flushInterval);
+                writeEvents();
+                writer->poll();
             }
+            writeEvents(); // 남은 이벤트 기록
+            writer->flush();
             });
 
         // Message loop
@@ -114,39 +94,65 @@ public:
             UnhookWindowsHookEx(keyboardHook);
         }
 
-        // 출력 스레드 종료 대기
-        if (printThread.joinable()) {
-            printThread.join();
+        // 기록 스레드 종료 대기
+        eventQueue.wakeConsumer();
+        if (writerThread.joinable()) {
+            writerThread.join();
+        }
+
+        const LogWriter::Stats& stats = writer->stats();
+        std::cout << "Logged " << stats.eventsWritten << " events (" << stats.bytesWritten << " bytes, "
+            << stats.writeCalls << " writes, " << stats.filesOpened << " files)" << std::endl;
+        if (stats.eventsDropped > 0) {
+            std::cout << "Warning: " << stats.eventsDropped << " events (" << stats.bytesFailed
+                << " bytes) were dropped because writing the log file failed" << std::endl;
+        }
+        if (eventQueue.overflowCount() > 0) {
+            std::cout << "Warning: " << eventQueue.overflowCount()
+                << " events were dropped because the event queue was full" << std::endl;
         }
     }
 
-    void printEvents() {
-        std::lock_guard<std::mutex> lock(eventsMutex);
-        if (!events.empty()) {
-            //std::cout << "\nRecorded Events:" << std::endl;
-            for (const auto& event : events) {
-                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    event.timestamp.time_since_epoch());
-                std::cout << "Time: " << duration.count() << "ms, "
-                    << "Type: " << (event.type == EventType::KEY_DOWN ? "KEY_DOWN" : "KEY_UP")
-                    << ", KeyCode: " << event.keyCode << std::endl;
-
-                // 파일 저장
-                if (logFile.is_open()) {
-                    logFile << duration.count() << ","
-                        << (event.type == EventType::KEY_DOWN ? "KEY_DOWN" : "KEY_UP") << ","
-                        << event.keyCode << "\n";
-                }
-            }
-            events.clear(); // 출력한 이벤트는 삭제
+    void writeEvents() {
+        size_t eventCount;
+        while ((eventCount = eventQueue.popBatch(events.data(), events.size())) > 0) {
+            writer->write(events.data(), eventCount);
         }
     }
 };
 
 KeyboardLogger* KeyboardLogger::instance = nullptr;
 
-int main() {
-    KeyboardLogger logger;
+int main(int argc, char* argv[]) {
+    // --binary: CSV 대신 이진 로그(.kmdl)로 저장
+    // --echo: 입력 이벤트를 콘솔에 출력 (초당 20개 제한)
+    // --rotate-mb <n> / --rotate-min <n>: 파일 크기/시간 기준 로테이션
+    // --flush-ms <n>: 버퍼 최대 보관 시간, --fsync: flush마다 디스크 동기화
+    LogWriter::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--binary") {
+            options.format = LogWriter::Format::BINARY;
+        }
+        else if (arg == "--echo") {
+            options.consoleEcho = true;
+        }
+        else if (arg == "--rotate-mb" && hasValue) {
+            options.rotateBytes = std::stoull(argv[++i]) * 1024 * 1024;
+        }
+        else if (arg == "--rotate-min" && hasValue) {
+            options.rotateInterval = std::chrono::minutes(std::stoi(argv[++i]));
+        }
+        else if (arg == "--flush-ms" && hasValue) {
+            options.flushInterval = std::chrono::milliseconds(std::stoi(argv[++i]));
+        }
+        else if (arg == "--fsync") {
+            options.fsyncOnFlush = true;
+        }
+    }
+
+    KeyboardLogger logger(options);
     logger.start();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,141 @@
+// SpscRingBuffer / LogWriter 부하 테스트 (Linux/Windows 공통)
+// 사용법: CaptureStress [--events <n>] [--rate <events/s, 0=무제한>]
+//                       [--write <파일 접두사>] [--binary] [--rotate-mb <n>] [--fsync]
+// 합성 생산자가 훅 대신 이벤트를 밀어 넣고, 소비자가 일괄 수거하며 순서/누락을 검증
+// --write 지정 시 수거한 이벤트를 LogWriter로 파일에 기록
+#include "../InputEvent.h"
+#include "../SpscRingBuffer.h"
+#include "../LogWriter.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    unsigned long long totalEvents = 50000000ULL;
+    unsigned long long ratePerSecond = 0;
+    std::unique_ptr<LogWriter::Options> writerOptions;
+    LogWriter::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--events" && hasValue) {
+            totalEvents = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--rate" && hasValue) {
+            ratePerSecond = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--write" && hasValue) {
+            options.filePrefix = argv[++i];
+            writerOptions = std::make_unique<LogWriter::Options>();
+        }
+        else if (arg == "--binary") {
+            options.format = LogWriter::Format::BINARY;
+        }
+        else if (arg == "--rotate-mb" && hasValue) {
+            options.rotateBytes = std::strtoull(argv[++i], nullptr, 10) * 1024 * 1024;
+        }
+        else if (arg == "--fsync") {
+            options.fsyncOnFlush = true;
+        }
+    }
+    if (writerOptions) {
+        *writerOptions = options;
+    }
+
+    static SpscRingBuffer<InputEvent, 1 << 16> ring;
+    std::atomic<bool> producerDone{false};
+    std::unique_ptr<LogWriter> writer;
+    if (writerOptions) {
+        writer = std::make_unique<LogWriter>(*writerOptions);
+    }
+
+    unsigned long long received = 0;
+    unsigned long long orderErrors = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumer([&]() {
+        std::vector<InputEvent> batch(ring.capacity());
+        long long lastSequence = -1;
+        while (true) {
+            if (!ring.waitForData(std::chrono::milliseconds(100))) {
+                if (writer) {
+                    writer->poll();
+                }
+                if (producerDone && ring.empty()) {
+                    break;
+                }
+                continue;
+            }
+            size_t count = ring.popBatch(batch.data(), batch.size());
+            for (size_t i = 0; i < count; ++i) {
+                // 타임스탬프에 시퀀스 번호(ms)를 담아 순서 검증 (버려진 이벤트만큼 건너뛸 수 있음)
+                long long sequence = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    batch[i].timestamp.time_since_epoch()).count();
+                if (sequence <= lastSequence) {
+                    orderErrors++;
+                }
+                lastSequence = sequence;
+            }
+            if (writer) {
+                writer->write(batch.data(), count);
+                writer->poll();
+            }
+            received += count;
+        }
+        if (writer) {
+            writer->close();
+        }
+    });
+
+    std::thread producer([&]() {
+        auto producerStart = std::chrono::steady_clock::now();
+        for (unsigned long long i = 0; i < totalEvents; ++i) {
+            InputEvent event;
+            event.timestamp = std::chrono::high_resolution_clock::time_point(
+                std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                    std::chrono::milliseconds(static_cast<long long>(i))));
+            event.type = (i & 1) ? EventType::KEY_UP : EventType::KEY_DOWN;
+            event.keyCode = 0xA4;
+            ring.tryPush(event);
+
+            if (ratePerSecond > 0 && (i & 1023) == 0) {
+                auto due = producerStart + std::chrono::nanoseconds(i * 1000000000ULL / ratePerSecond);
+                std::this_thread::sleep_until(due);
+            }
+        }
+        producerDone = true;
+        ring.wakeConsumer();
+    });
+
+    producer.join();
+    consumer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const unsigned long long overflow = ring.overflowCount();
+    std::cout << "Produced:  " << totalEvents << std::endl;
+    std::cout << "Received:  " << received << std::endl;
+    std::cout << "Overflow:  " << overflow << std::endl;
+    std::cout << "Order errors: " << orderErrors << std::endl;
+    std::cout << "Throughput: " << std::fixed << std::setprecision(2)
+        << (totalEvents / seconds / 1e6) << " M events/s (" << seconds << " s)" << std::endl;
+
+    bool ok = received + overflow == totalEvents && orderErrors == 0;
+    if (writer) {
+        const LogWriter::Stats& stats = writer->stats();
+        std::cout << "Written:   " << stats.eventsWritten << " events, " << stats.bytesWritten << " bytes, "
+            << stats.writeCalls << " writes, " << stats.filesOpened << " files (last: "
+            << writer->currentFilename() << ")" << std::endl;
+        if (stats.eventsDropped > 0) {
+            std::cout << "Dropped:   " << stats.eventsDropped << " events, " << stats.bytesFailed
+                << " bytes (write failed)" << std::endl;
+        }
+        ok = ok && stats.eventsWritten == received;
+    }
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
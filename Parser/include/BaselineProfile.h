@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include "PatternAnalyzer.h"
+#include "MappedFile.h"
+
+// 플레이어별 사람 기준 프로필 (.kmbp, 버전 1). 한 번 만들고 새 세션을 증분 병합하며,
+// 시작 시 메모리 맵으로 열어 헤더만 검사하므로 항목 수와 무관하게 즉시 로드됨
+//
+// 파일 헤더 (160바이트, 리틀 엔디언)
+//   char[4] magic = "KMBP" | u16 version | u16 headerSize | u32 entrySize | u32 entriesCrc32
+//   u64 entryCount | u64 sessions | u64 events | u64 totalInstances
+//   f64 top2Concentration | f64 top5Concentration | u32 coverage50 | u32 reserved
+//   i64 timeThresholdMs | u8 minLength | u8 maxLength | u8[6] reserved
+//   u64[4] startKeys | u64[4] coreKeys (KeySet 비트맵)
+// 항목 (entryCount개, (hi, lo) 오름차순 -> 이진 탐색)
+//   u64 PatternKey.lo | u64 PatternKey.hi | u64 count
+// VK > 0xFF가 포함된 패턴은 압축 키로 표현할 수 없으므로 저장하지 않음
+class BaselineProfile {
+public:
+    static constexpr char MAGIC[4] = {'K', 'M', 'B', 'P'};
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 160;
+    static constexpr size_t ENTRY_SIZE = 24;
+
+    struct Stats {
+        uint64_t sessions = 0;
+        uint64_t events = 0;
+        uint64_t totalInstances = 0;
+        uint64_t distinctPatterns = 0;
+        double top2Concentration = 0.0;
+        double top5Concentration = 0.0;
+        uint32_t coveragePatternCount = 0;
+    };
+
+    struct Entry {
+        PatternKey key;
+        uint64_t count;
+    };
+
+    // 헤더만 검사하고 항목은 매핑된 페이지에서 필요할 때 읽음 (CRC 검사는 verify())
+    static BaselineProfile open(const std::string& filename);
+    static bool isProfileFile(const std::string& filename);
+
+    // 세션 빈도수를 기존 프로필에 병합하여 다시 기록 (파일이 없으면 새로 생성)
+    // 기존 로그를 다시 처리하지 않으며, 임시 파일에 쓴 뒤 교체하므로 중간에 실패해도 기존 프로필은 유지
+    static Stats merge(const std::string& filename, const PatternCounter& sessionFrequencies,
+        size_t sessionEvents, const ExtractionConfig& config = ExtractionConfig());
+
+    BaselineProfile(BaselineProfile&&) = default;
+    BaselineProfile& operator=(BaselineProfile&&) = default;
+
+    const Stats& stats() const { return stats_; }
+    const ExtractionConfig& config() const { return config_; }
+    size_t size() const { return static_cast<size_t>(stats_.distinctPatterns); }
+    bool empty() const { return size() == 0; }
+    bool verify() const;
+
+    Entry entryAt(size_t index) const;
+    uint64_t count(const PatternKey& key) const;
+    uint64_t count(const MicroPattern& pattern) const;
+
+    // 기준 프로필에서 빈도수 maxCount 이하인 패턴 = 의심 패턴 (main의 사람 로그 기준과 동일한 규칙)
+    bool isSuspicious(const PatternKey& key, uint64_t maxCount = 2) const;
+    // 세션의 의심 패턴 인스턴스 수. 세션 패턴마다 매핑된 항목을 이진 탐색하므로 프로필 크기와 무관
+    // (VK > 0xFF 패턴은 프로필에 없으므로 의심 패턴이 아님)
+    long long suspiciousInstances(const PatternCounter& frequencies, uint64_t maxCount = 2) const;
+    // 전체 항목을 집합으로 펼침 (이벤트 스트림용 오토마톤을 만들 때만 사용)
+    std::set<MicroPattern> suspiciousPatterns(uint64_t maxCount = 2) const;
+
+private:
+    BaselineProfile() = default;
+
+    static void write(const std::string& filename, const std::vector<Entry>& entries,
+        const Stats& stats, const ExtractionConfig& config);
+
+    std::unique_ptr<MappedFile> file_;
+    const uint8_t* entries_ = nullptr;
+    Stats stats_;
+    ExtractionConfig config_;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "PatternAnalyzer.h"
+#include "BaselineProfile.h"
+#include "SuspiciousPatternMatcher.h"
+#include "SessionSignature.h"
+
+// 세션(로그 파일) 하나의 분석 결과
+struct SessionResult {
+    std::string session;
+    size_t events = 0;
+    long long totalInstances = 0;
+    size_t uniquePatterns = 0;
+    // 스케치 모드에서 집중도는 상한, 커버리지 패턴 수는 하한 (아래 오차 범위 참고)
+    double top2Concentration = 0.0;
+    double top5Concentration = 0.0;
+    int coveragePatternCount = 0;
+    double suspiciousScore = 0.0;
+    double finalScore = 0.0;
+    bool suspected = false;
+    // 스케치 모드 오차 범위: 실제 집중도는 [top2Lower, top2Concentration] (정확 모드에서는 추정값과 동일)
+    double top2Lower = 0.0;
+    double top5Lower = 0.0;
+    int coverageLower = 0;
+    int coverageUpper = 0;
+    bool exact = true;
+    // 세션 클러스터링용 패턴 분포 서명 (Options::signatureHashes가 0이면 비어 있음)
+    SessionSignature signature;
+};
+
+struct BatchSummary {
+    size_t files = 0;
+    size_t failedFiles = 0;
+    long long events = 0;
+    double elapsedSeconds = 0.0;
+};
+
+// 다수의 세션 로그를 모든 코어에서 parse -> extract -> score 하고
+// 결과를 하나의 파일(CSV 또는 JSON lines)에 완료 순서대로 기록
+class BatchAnalyzer {
+public:
+    struct Options {
+        size_t threadCount = 0; // 0이면 코어 수
+        std::string outputFilename = "batch_results.csv"; // .jsonl / .ndjson이면 JSON lines
+        bool appendOutput = false; // 기존 결과 파일 뒤에 이어 쓰기
+        ExtractionConfig extraction;
+        size_t sketchCapacity = 0; // 0이면 정확 집계, 아니면 세션당 카운터 수 상한
+        size_t signatureHashes = 0; // 0이 아니면 세션 서명을 만들고 결과를 sessions()에 보관
+    };
+
+    explicit BatchAnalyzer(const Options& options);
+
+    // 디렉터리면 내부의 *.csv / *.kmdl, 아니면 한 줄에 경로 하나인 매니페스트('#' 주석)
+    static std::vector<std::string> collectInputs(const std::string& path);
+
+    void setSuspiciousPatterns(const std::set<MicroPattern>& suspiciousPatterns);
+    // 매핑된 기준 프로필의 항목을 세션 패턴마다 직접 조회 (집합으로 펼치지 않음)
+    void setBaselineProfile(std::shared_ptr<const BaselineProfile> profile);
+
+    BatchSummary run(const std::vector<std::string>& filenames);
+
+    SessionResult analyzeEvents(const std::string& session, const std::vector<InputEvent>& events) const;
+
+    // 마지막 run()에서 서명을 만든 세션 결과 (입력 순서, 스레드 수와 무관하게 같은 순서)
+    const std::vector<SessionResult>& sessions() const { return sessions_; }
+
+private:
+    SessionResult analyzeEventsSketch(const std::string& session, const std::vector<InputEvent>& events) const;
+
+    Options options_;
+    std::set<MicroPattern> suspiciousPatterns_;
+    std::unordered_set<PatternKey, PatternKeyHash> suspiciousKeys_;
+    std::shared_ptr<const BaselineProfile> baselineProfile_;
+    // 스케치 모드는 밀려난 패턴의 빈도수를 모르므로 이벤트에서 직접 의심 패턴을 집계
+    std::unique_ptr<SuspiciousPatternMatcher> suspiciousMatcher_;
+    std::mutex sessionsMutex_;
+    std::vector<SessionResult> sessions_;
+};
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// 이진 이벤트 로그 형식 (.kmdl, 버전 2). 키로거와 파서가 함께 사용하므로 InputEvent에 의존하지 않음
+//
+// 파일 헤더 (24바이트, 리틀 엔디언)
+//   char[4] magic = "KMDL" | u16 version | u16 headerSize | u32 timestampUnitUs (1000 = ms)
+//   u32 blockEvents (블록당 최대 이벤트 수) | u64 reserved
+// 블록 (반복)
+//   u32 eventCount | u32 payloadSize | u32 crc32 | i64 firstTimestamp
+//   crc32 = CRC 칸을 0으로 둔 블록 헤더 20바이트 + payload
+//   payload: 이벤트마다 varint(zigzag(이전 이벤트와의 시간차)) + varint((vk << 1) | isKeyUp)
+//            (첫 이벤트의 시간차는 firstTimestamp 기준, vk < 64면 1바이트 / < 8192면 2바이트)
+namespace BinaryEventLog {
+    constexpr char MAGIC[4] = {'K', 'M', 'D', 'L'};
+    constexpr uint16_t VERSION = 2;
+    constexpr size_t FILE_HEADER_SIZE = 24;
+    constexpr size_t BLOCK_HEADER_SIZE = 20;
+    constexpr uint32_t TIMESTAMP_UNIT_US = 1000;
+    constexpr uint32_t DEFAULT_BLOCK_EVENTS = 4096;
+    // 이벤트당 최대 크기: 시간차 varint 10바이트 + 코드 varint 5바이트
+    constexpr size_t MAX_EVENT_SIZE = 15;
+    // 이벤트당 최소 크기: varint 두 개
+    constexpr size_t MIN_EVENT_SIZE = 2;
+
+    struct Event {
+        int64_t timestamp;  // timestampUnitUs 단위
+        bool keyUp;
+        uint32_t keyCode;
+    };
+
+    // previous에 앞부분의 crc32를 넘기면 이어서 계산 (crc32(a + b) == crc32(b, crc32(a)))
+    inline uint32_t crc32(const uint8_t* data, size_t length, uint32_t previous = 0) {
+        static const struct Table {
+            uint32_t values[256];
+            Table() {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    uint32_t c = i;
+                    for (int k = 0; k < 8; ++k) {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    values[i] = c;
+                }
+            }
+        } table;
+
+        uint32_t crc = previous ^ 0xFFFFFFFFu;
+        for (size_t i = 0; i < length; ++i) {
+            crc = table.values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    // 블록 헤더(CRC 칸은 0으로 간주) + payload의 CRC
+    inline uint32_t blockChecksum(const uint8_t* header, const uint8_t* payload, size_t payloadSize) {
+        uint8_t zeroed[BLOCK_HEADER_SIZE];
+        std::memcpy(zeroed, header, BLOCK_HEADER_SIZE);
+        std::memset(zeroed + 8, 0, 4);
+        return crc32(payload, payloadSize, crc32(zeroed, BLOCK_HEADER_SIZE));
+    }
+
+    inline uint64_t zigzagEncode(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+    inline int64_t zigzagDecode(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    inline uint8_t* writeVarint(uint8_t* out, uint64_t value) {
+        while (value >= 0x80) {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+    // 실패(버퍼 끝 초과, 10바이트 초과) 시 nullptr
+    inline const uint8_t* readVarint(const uint8_t* in, const uint8_t* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && in < end; shift += 7) {
+            const uint8_t byte = *in++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return in;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    inline void storeLE(uint8_t* out, T value) {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out[i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+        }
+    }
+    template <typename T>
+    inline T loadLE(const uint8_t* in) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return static_cast<T>(value);
+    }
+
+    inline std::string fileHeader(uint32_t blockEvents = DEFAULT_BLOCK_EVENTS) {
+        uint8_t header[FILE_HEADER_SIZE] = {};
+        std::memcpy(header, MAGIC, 4);
+        storeLE<uint16_t>(header + 4, VERSION);
+        storeLE<uint16_t>(header + 6, static_cast<uint16_t>(FILE_HEADER_SIZE));
+        storeLE<uint32_t>(header + 8, TIMESTAMP_UNIT_US);
+        storeLE<uint32_t>(header + 12, blockEvents);
+        return std::string(reinterpret_cast<const char*>(header), FILE_HEADER_SIZE);
+    }
+
+    inline bool hasMagic(const char* data, size_t size) {
+        return size >= 4 && std::memcmp(data, MAGIC, 4) == 0;
+    }
+
+    // 이벤트를 블록 단위로 인코딩. 블록이 가득 차거나 flushBlock() 호출 시 out에 블록을 덧붙임
+    class BlockEncoder {
+    public:
+        explicit BlockEncoder(uint32_t blockEvents = DEFAULT_BLOCK_EVENTS)
+            : blockEvents_(blockEvents), payload_(new uint8_t[blockEvents * MAX_EVENT_SIZE]) {
+        }
+        ~BlockEncoder() { delete[] payload_; }
+
+        BlockEncoder(const BlockEncoder&) = delete;
+        BlockEncoder& operator=(const BlockEncoder&) = delete;
+
+        void add(const Event& event, std::string& out) {
+            if (eventCount_ == 0) {
+                firstTimestamp_ = event.timestamp;
+                previousTimestamp_ = event.timestamp;
+            }
+            uint8_t* cursor = payload_ + payloadSize_;
+            // 차이는 부호 없는 정수로 계산 (오버플로 시에도 디코더에서 같은 값으로 복원됨)
+            const uint64_t delta = static_cast<uint64_t>(event.timestamp) - static_cast<uint64_t>(previousTimestamp_);
+            cursor = writeVarint(cursor, zigzagEncode(static_cast<int64_t>(delta)));
+            cursor = writeVarint(cursor, (static_cast<uint64_t>(event.keyCode) << 1) | (event.keyUp ? 1u : 0u));
+            payloadSize_ = static_cast<size_t>(cursor - payload_);
+            previousTimestamp_ = event.timestamp;
+
+            if (++eventCount_ == blockEvents_) {
+                flushBlock(out);
+            }
+        }
+
+        void flushBlock(std::string& out) {
+            if (eventCount_ == 0) {
+                return;
+            }
+            uint8_t header[BLOCK_HEADER_SIZE];
+            storeLE<uint32_t>(header, eventCount_);
+            storeLE<uint32_t>(header + 4, static_cast<uint32_t>(payloadSize_));
+            storeLE<uint32_t>(header + 8, 0);
+            storeLE<int64_t>(header + 12, firstTimestamp_);
+            storeLE<uint32_t>(header + 8, blockChecksum(header, payload_, payloadSize_));
+            out.append(reinterpret_cast<const char*>(header), BLOCK_HEADER_SIZE);
+            out.append(reinterpret_cast<const char*>(payload_), payloadSize_);
+            eventCount_ = 0;
+            payloadSize_ = 0;
+        }
+
+        uint32_t pendingEvents() const { return eventCount_; }
+
+    private:
+        uint32_t blockEvents_;
+        uint8_t* payload_;
+        size_t payloadSize_ = 0;
+        uint32_t eventCount_ = 0;
+        int64_t firstTimestamp_ = 0;
+        int64_t previousTimestamp_ = 0;
+    };
+
+    enum class BlockStatus {
+        OK,
+        END,          // 더 이상 블록 없음
+        TRUNCATED,    // 블록 헤더/페이로드가 파일 끝을 넘음
+        BAD_CHECKSUM, // CRC 불일치 (블록 건너뜀)
+        CORRUPT       // CRC는 맞지만 이벤트 수가 payload 크기와 맞지 않거나 디코딩 실패 (블록 건너뜀)
+    };
+
+    struct BlockView {
+        uint32_t eventCount = 0;
+        int64_t firstTimestamp = 0;
+        const uint8_t* payload = nullptr;
+        const uint8_t* payloadEnd = nullptr;
+    };
+
+    // cursor 위치의 블록 헤더를 읽고 CRC 검사. 성공/CRC 불일치/손상 시 cursor를 다음 블록으로 이동
+    inline BlockStatus nextBlock(const uint8_t*& cursor, const uint8_t* end, BlockView& block) {
+        if (cursor == end) {
+            return BlockStatus::END;
+        }
+        if (static_cast<size_t>(end - cursor) < BLOCK_HEADER_SIZE) {
+            return BlockStatus::TRUNCATED;
+        }
+        block.eventCount = loadLE<uint32_t>(cursor);
+        const uint32_t payloadSize = loadLE<uint32_t>(cursor + 4);
+        const uint32_t checksum = loadLE<uint32_t>(cursor + 8);
+        block.firstTimestamp = loadLE<int64_t>(cursor + 12);
+        if (static_cast<size_t>(end - cursor - BLOCK_HEADER_SIZE) < payloadSize) {
+            return BlockStatus::TRUNCATED;
+        }
+        const uint8_t* header = cursor;
+        block.payload = cursor + BLOCK_HEADER_SIZE;
+        block.payloadEnd = block.payload + payloadSize;
+        cursor = block.payloadEnd;
+        if (blockChecksum(header, block.payload, payloadSize) != checksum) {
+            return BlockStatus::BAD_CHECKSUM;
+        }
+        // 기록기 오류 등으로 payload에 들어갈 수 없는 eventCount는 거부
+        return block.eventCount > payloadSize / MIN_EVENT_SIZE ? BlockStatus::CORRUPT : BlockStatus::OK;
+    }
+
+    // 블록의 이벤트를 순서대로 callback(const Event&)에 전달. 디코딩 실패 시 false
+    template <typename Callback>
+    inline bool decodeBlock(const BlockView& block, Callback callback) {
+        const uint8_t* cursor = block.payload;
+        // 시간차 누적은 부호 없는 정수로 (손상된 delta로 인한 부호 있는 오버플로 방지)
+        uint64_t timestamp = static_cast<uint64_t>(block.firstTimestamp);
+        for (uint32_t i = 0; i < block.eventCount; ++i) {
+            uint64_t delta;
+            uint64_t code;
+            cursor = readVarint(cursor, block.payloadEnd, delta);
+            if (cursor == nullptr) {
+                return false;
+            }
+            cursor = readVarint(cursor, block.payloadEnd, code);
+            if (cursor == nullptr || (code >> 1) > 0xFFFFFFFFu) {
+                return false;
+            }
+            timestamp += static_cast<uint64_t>(zigzagDecode(delta));
+            callback(Event{static_cast<int64_t>(timestamp), (code & 1) != 0, static_cast<uint32_t>(code >> 1)});
+        }
+        return cursor == block.payloadEnd;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "EventColumns.h"
+#include "KeySet.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// EventColumns를 한 번 훑어 두 개의 비트마스크를 만드는 벡터화 커널 (AVX2 / SSE / 스칼라)
+// - starts: bit i = 이벤트 i가 시작 이벤트(KEY_DOWN + 시작 키)
+// - breaks: bit i = 이벤트 i-1과 i 사이 간격이 임계값 초과 (bit 0은 항상 1)
+// 추출 단계는 starts의 세트 비트만 방문하고, breaks로 끊긴 창을 비트 연산으로 건너뜀
+namespace ColumnScan {
+    struct Masks {
+        size_t count = 0;
+        std::vector<uint64_t> starts;
+        std::vector<uint64_t> breaks;
+    };
+
+    // isWithinTimeWindow(밀리초 절삭 후 <= thresholdMs)와 같은 판정의 마이크로초 한계: gap > limit이면 끊김
+    int64_t gapLimitUs(long long thresholdMs);
+
+    // 빌드에 포함된 최선의 커널로 스캔
+    void scan(const EventColumns& columns, const KeySet& startKeys, long long thresholdMs, Masks& masks);
+    // 검증/비교용 스칼라 구현
+    void scanScalar(const EventColumns& columns, const KeySet& startKeys, long long thresholdMs, Masks& masks);
+    // "avx2", "sse2+sse4.2", "sse2", "scalar"
+    const char* kernelName();
+
+    inline int countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    // position부터 시작하는 최대 64비트를 꺼냄 (범위 밖은 0)
+    inline uint64_t bitsFrom(const std::vector<uint64_t>& mask, size_t position) {
+        const size_t word = position >> 6;
+        const unsigned offset = static_cast<unsigned>(position & 63);
+        if (word >= mask.size()) {
+            return 0;
+        }
+        uint64_t bits = mask[word] >> offset;
+        if (offset != 0 && word + 1 < mask.size()) {
+            bits |= mask[word + 1] << (64 - offset);
+        }
+        return bits;
+    }
+}
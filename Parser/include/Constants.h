@@ -1,9 +1,49 @@
 #pragma once
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include <windows.h>
+#else
+// windows.h가 없는 플랫폼(리눅스 탐지 데몬과 도구)용: 파서, 키 이름 표, 트레이스 생성기가 쓰는 가상 키 코드만 정의
+#define VK_BACK 0x08
+#define VK_TAB 0x09
+#define VK_RETURN 0x0D
+#define VK_SHIFT 0x10
+#define VK_CONTROL 0x11
+#define VK_MENU 0x12
+#define VK_CAPITAL 0x14
+#define VK_ESCAPE 0x1B
+#define VK_SPACE 0x20
+#define VK_LEFT 0x25
+#define VK_UP 0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN 0x28
+#define VK_DELETE 0x2E
+#define VK_F1 0x70
+#define VK_F2 0x71
+#define VK_F3 0x72
+#define VK_F4 0x73
+#define VK_F5 0x74
+#define VK_F6 0x75
+#define VK_F7 0x76
+#define VK_F8 0x77
+#define VK_F9 0x78
+#define VK_F10 0x79
+#define VK_F11 0x7A
+#define VK_F12 0x7B
+#define VK_LCONTROL 0xA2
+#define VK_LMENU 0xA4
+#endif
 #include <unordered_set>
+#include "KeySet.h"
 
 namespace Constants {
     const std::unordered_set<unsigned int> patternStartKeys = { VK_LMENU };
+
+    // 추출 루프용 비트맵: 패턴을 시작하는 키(KEY_DOWN)와 패턴에 포함되어야 하는 핵심 키
+    constexpr KeySet patternStartKeyBits = KeySet::of({ VK_LMENU });
+    constexpr KeySet patternCoreKeyBits = KeySet::of({ VK_LMENU });
     
     // 임계값 정의
     const double THRESH_CONC_TOP2_LOW = 30.0;
@@ -16,4 +56,8 @@ namespace Constants {
     const double WEIGHT_CONCENTRATION = 0.5;
     const double WEIGHT_FLATNESS = 0.4;
     const double WEIGHT_SUSPICIOUS = 0.1;
+
+    // 타이밍 변동 특징 (기본 가중치 0: 기존 판정과 동일)
+    const double THRESH_TIMING_VARIATION_LOW = 0.25;
+    const double WEIGHT_TIMING = 0.0;
 } 
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "BinaryEventLog.h"
+
+// 탐지 데몬(--serve)과 클라이언트 사이의 프레임 프로토콜 (리틀 엔디언)
+//
+// 프레임 헤더 (20바이트)
+//   u32 payloadSize | u16 type | u16 flags | u32 sequence | u64 sessionId
+// 클라이언트 -> 서버
+//   EVENTS       payload = 이진 이벤트 로그 블록 하나 (BinaryEventLog 블록 헤더 + CRC + 이벤트, 밀리초 단위)
+//   END_SESSION  payload 없음. 마지막 판정(FLAG_FINAL)을 받고 세션 상태 해제
+// 서버 -> 클라이언트 (sequence는 요청 프레임의 값을 그대로 돌려줌)
+//   VERDICT      payload 64바이트. 요청마다 하나씩, 처리 완료 순서대로 비동기 전송
+//                u64 eventsProcessed | u64 totalInstances | f64 top2 | f64 top5 | i32 coverage50
+//                | u32 distinctPatterns | f64 suspiciousScore | f64 finalScore | u8 suspected | u8[7] reserved
+//   PROTOCOL_ERROR  payload = 메시지 문자열. 보낸 뒤 연결 종료
+// 같은 세션의 프레임은 보낸 순서대로 처리되지만, 세션이 다르면 판정 순서는 보장하지 않음
+// 클라이언트가 쓰기를 닫으면(shutdown(SHUT_WR)) 서버는 이미 받은 프레임의 판정을 모두 보낸 뒤 연결을 닫음
+namespace DetectorProtocol {
+    constexpr size_t HEADER_SIZE = 20;
+    constexpr size_t VERDICT_SIZE = 64;
+    constexpr uint32_t DEFAULT_MAX_PAYLOAD = 1 << 20;
+
+    enum class MessageType : uint16_t {
+        EVENTS = 1,
+        END_SESSION = 2,
+        VERDICT = 3,
+        PROTOCOL_ERROR = 4
+    };
+
+    enum Flags : uint16_t {
+        FLAG_FINAL = 1,   // 세션의 마지막 판정 (END_SESSION 응답 또는 유휴 해제)
+        FLAG_EVICTED = 2, // 유휴 시간 초과로 서버가 세션 상태를 해제함
+        FLAG_DEGRADED = 4 // 세션 메모리 예산에 닿아 윈도우가 짧아진 상태의 판정
+    };
+
+    struct FrameHeader {
+        uint32_t payloadSize = 0;
+        MessageType type = MessageType::EVENTS;
+        uint16_t flags = 0;
+        uint32_t sequence = 0;
+        uint64_t sessionId = 0;
+    };
+
+    struct Verdict {
+        uint64_t eventsProcessed = 0;
+        uint64_t totalInstances = 0;
+        double top2Concentration = 0.0;
+        double top5Concentration = 0.0;
+        int32_t coveragePatternCount = 0;
+        uint32_t distinctPatterns = 0;
+        double suspiciousScore = 0.0;
+        double finalScore = 0.0;
+        bool suspected = false;
+    };
+
+    inline uint64_t doubleBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    inline double bitsDouble(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    inline void appendHeader(std::string& out, const FrameHeader& header) {
+        uint8_t bytes[HEADER_SIZE];
+        BinaryEventLog::storeLE<uint32_t>(bytes, header.payloadSize);
+        BinaryEventLog::storeLE<uint16_t>(bytes + 4, static_cast<uint16_t>(header.type));
+        BinaryEventLog::storeLE<uint16_t>(bytes + 6, header.flags);
+        BinaryEventLog::storeLE<uint32_t>(bytes + 8, header.sequence);
+        BinaryEventLog::storeLE<uint64_t>(bytes + 12, header.sessionId);
+        out.append(reinterpret_cast<const char*>(bytes), HEADER_SIZE);
+    }
+
+    inline FrameHeader readHeader(const uint8_t* bytes) {
+        FrameHeader header;
+        header.payloadSize = BinaryEventLog::loadLE<uint32_t>(bytes);
+        header.type = static_cast<MessageType>(BinaryEventLog::loadLE<uint16_t>(bytes + 4));
+        header.flags = BinaryEventLog::loadLE<uint16_t>(bytes + 6);
+        header.sequence = BinaryEventLog::loadLE<uint32_t>(bytes + 8);
+        header.sessionId = BinaryEventLog::loadLE<uint64_t>(bytes + 12);
+        return header;
+    }
+
+    // 이벤트 블록(BlockEncoder::flushBlock 결과)을 EVENTS 프레임으로 감쌈
+    inline void appendEventsFrame(std::string& out, uint64_t sessionId, uint32_t sequence, const std::string& block) {
+        FrameHeader header;
+        header.payloadSize = static_cast<uint32_t>(block.size());
+        header.type = MessageType::EVENTS;
+        header.sequence = sequence;
+        header.sessionId = sessionId;
+        appendHeader(out, header);
+        out.append(block);
+    }
+
+    inline void appendEndSessionFrame(std::string& out, uint64_t sessionId, uint32_t sequence) {
+        FrameHeader header;
+        header.type = MessageType::END_SESSION;
+        header.sequence = sequence;
+        header.sessionId = sessionId;
+        appendHeader(out, header);
+    }
+
+    inline void appendVerdictFrame(std::string& out, uint64_t sessionId, uint32_t sequence, uint16_t flags,
+        const Verdict& verdict) {
+        FrameHeader header;
+        header.payloadSize = static_cast<uint32_t>(VERDICT_SIZE);
+        header.type = MessageType::VERDICT;
+        header.flags = flags;
+        header.sequence = sequence;
+        header.sessionId = sessionId;
+        appendHeader(out, header);
+
+        uint8_t bytes[VERDICT_SIZE] = {};
+        BinaryEventLog::storeLE<uint64_t>(bytes, verdict.eventsProcessed);
+        BinaryEventLog::storeLE<uint64_t>(bytes + 8, verdict.totalInstances);
+        BinaryEventLog::storeLE<uint64_t>(bytes + 16, doubleBits(verdict.top2Concentration));
+        BinaryEventLog::storeLE<uint64_t>(bytes + 24, doubleBits(verdict.top5Concentration));
+        BinaryEventLog::storeLE<int32_t>(bytes + 32, verdict.coveragePatternCount);
+        BinaryEventLog::storeLE<uint32_t>(bytes + 36, verdict.distinctPatterns);
+        BinaryEventLog::storeLE<uint64_t>(bytes + 40, doubleBits(verdict.suspiciousScore));
+        BinaryEventLog::storeLE<uint64_t>(bytes + 48, doubleBits(verdict.finalScore));
+        bytes[56] = verdict.suspected ? 1 : 0;
+        out.append(reinterpret_cast<const char*>(bytes), VERDICT_SIZE);
+    }
+
+    inline Verdict readVerdict(const uint8_t* bytes) {
+        Verdict verdict;
+        verdict.eventsProcessed = BinaryEventLog::loadLE<uint64_t>(bytes);
+        verdict.totalInstances = BinaryEventLog::loadLE<uint64_t>(bytes + 8);
+        verdict.top2Concentration = bitsDouble(BinaryEventLog::loadLE<uint64_t>(bytes + 16));
+        verdict.top5Concentration = bitsDouble(BinaryEventLog::loadLE<uint64_t>(bytes + 24));
+        verdict.coveragePatternCount = BinaryEventLog::loadLE<int32_t>(bytes + 32);
+        verdict.distinctPatterns = BinaryEventLog::loadLE<uint32_t>(bytes + 36);
+        verdict.suspiciousScore = bitsDouble(BinaryEventLog::loadLE<uint64_t>(bytes + 40));
+        verdict.finalScore = bitsDouble(BinaryEventLog::loadLE<uint64_t>(bytes + 48));
+        verdict.suspected = bytes[56] != 0;
+        return verdict;
+    }
+
+    inline void appendErrorFrame(std::string& out, uint64_t sessionId, uint32_t sequence, const std::string& message) {
+        FrameHeader header;
+        header.payloadSize = static_cast<uint32_t>(message.size());
+        header.type = MessageType::PROTOCOL_ERROR;
+        header.sequence = sequence;
+        header.sessionId = sessionId;
+        appendHeader(out, header);
+        out.append(message);
+    }
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "DetectorProtocol.h"
+#include "SessionArena.h"
+#include "StreamingPatternAnalyzer.h"
+
+// 주소 형식: "unix:<경로>" (Unix 도메인 소켓) 또는 "[tcp:]<IPv4 주소|localhost>:<포트>"
+namespace DetectorEndpoint {
+    // 논블로킹 수신 소켓 (Unix 소켓 경로가 이미 있으면 지우고 다시 만듦)
+    int listenOn(const std::string& endpoint);
+    // 블로킹 연결 소켓
+    int connectTo(const std::string& endpoint);
+}
+
+// 다수 클라이언트의 이벤트 묶음을 받아 세션별 StreamingPatternAnalyzer로 판정하는 상주 서비스 (Linux)
+// - 입출력 스레드 하나가 epoll(레벨 트리거)로 accept / 프레임 분리 / 판정 전송을 담당
+// - 세션 ID 해시로 워커를 고정하므로 세션 상태는 한 워커만 접근 (잠금 없음, 세션 내 순서 보장)
+// - 워커는 처리한 판정을 완료 큐에 넣고 eventfd로 입출력 스레드를 깨움
+// - 역압: 연결의 처리 대기 프레임 수, 출력 버퍼 크기, 워커 큐 용량 중 하나라도 한도에 닿으면
+//   그 연결은 읽지 않으므로 커널 소켓 버퍼가 차서 클라이언트 send()가 막힘
+// - idleTimeoutMs 동안 이벤트가 없는 세션은 해제하고, 마지막 연결이 살아 있으면 FLAG_EVICTED 판정 전송
+// - 세션 상태는 워커의 SlabPool에서 받은 세션별 SessionArena에 할당 (세션 해제는 슬랩 목록 반환 한 번)
+// - sessionMemoryBudget에 닿은 세션은 StreamingPatternAnalyzer 축소 모드로 동작하고 판정에 FLAG_DEGRADED 표시
+// - checkpointFile이 있으면 워커가 checkpointIntervalMs마다 자기 세션 스냅샷을 만들고, 모든 워커가 새로 만들면
+//   마지막 워커가 SessionCheckpoint 파일 하나로 교체 기록. run()은 시작할 때 이 파일로 세션을 복원하고,
+//   stop() 후에는 워커를 멈춰 마지막 상태를 한 번 더 기록한 뒤 반환 (이후 run()을 다시 호출할 수 없음)
+class DetectorServer {
+public:
+    struct Options {
+        std::string endpoint = "unix:/tmp/keymacro-detector.sock";
+        size_t workerThreads = 0; // 0이면 코어 수
+        size_t maxQueuedFramesPerWorker = 1024;
+        size_t maxPendingFramesPerConnection = 64;
+        size_t maxOutputBytesPerConnection = 4 << 20;
+        uint32_t maxPayloadBytes = DetectorProtocol::DEFAULT_MAX_PAYLOAD;
+        long long idleTimeoutMs = 5 * 60 * 1000;
+        long long evictionIntervalMs = 1000;
+        size_t sessionMemoryBudget = 256 * 1024; // 0이면 제한 없음
+        std::string checkpointFile; // 비어 있으면 체크포인트 없음
+        long long checkpointIntervalMs = 60 * 1000;
+        StreamingPatternAnalyzer::Options analyzer;
+    };
+
+    struct Stats {
+        uint64_t connectionsAccepted = 0;
+        uint64_t activeConnections = 0;
+        uint64_t activeSessions = 0;
+        uint64_t sessionsEnded = 0;
+        uint64_t sessionsEvicted = 0;
+        uint64_t framesReceived = 0;
+        uint64_t eventsProcessed = 0;
+        uint64_t verdictsSent = 0;
+        uint64_t backpressurePauses = 0; // 연결 읽기를 멈춘 횟수
+        uint64_t protocolErrors = 0;
+        uint64_t degradedSessions = 0;       // 메모리 예산에 닿은 세션 수 (누적)
+        uint64_t sessionMemoryBytes = 0;     // 살아 있는 세션들이 점유 중인 바이트
+        uint64_t peakSessionMemoryBytes = 0;
+        uint64_t peakActiveSessions = 0;
+        uint64_t sessionsRestored = 0;   // 시작 시 체크포인트에서 복원한 세션 수
+        uint64_t checkpointsWritten = 0;
+        uint64_t checkpointBytes = 0;    // 마지막 체크포인트 파일 크기
+    };
+
+    explicit DetectorServer(const Options& options);
+    ~DetectorServer();
+
+    DetectorServer(const DetectorServer&) = delete;
+    DetectorServer& operator=(const DetectorServer&) = delete;
+
+    // 모든 세션이 같은 ExtractionConfig로 만든 매처를 공유 (run() 전에 설정)
+    void setSuspiciousMatcher(std::shared_ptr<const SuspiciousPatternMatcher> matcher);
+
+    // stop()이 호출될 때까지 현재 스레드에서 입출력 루프 실행 (체크포인트 파일이 손상되었거나 설정이 다르면 std::runtime_error)
+    // 복원된 세션에 다시 연결한 클라이언트는 이벤트 0개 블록으로 eventsProcessed를 받아 그 다음 이벤트부터 보내면 됨
+    void run();
+    // 다른 스레드나 시그널 처리기에서 호출 가능 (eventfd에 쓰기만 함)
+    void stop();
+
+    Stats stats() const;
+
+private:
+    struct Task {
+        uint64_t connectionId;
+        DetectorProtocol::FrameHeader header;
+        std::vector<uint8_t> payload;
+    };
+
+    struct Completion {
+        uint64_t connectionId;
+        bool releasesPending; // 요청 프레임에 대한 응답이면 연결의 대기 프레임 수 감소
+        bool closeConnection; // 잘못된 이벤트 블록 등으로 PROTOCOL_ERROR를 보낸 뒤 연결 종료
+        std::string bytes;
+    };
+
+    struct Session {
+        SessionArena arena; // analyzer가 먼저 소멸한 뒤 슬랩 반환
+        StreamingPatternAnalyzer analyzer;
+        uint64_t connectionId = 0;
+        std::chrono::steady_clock::time_point lastActive;
+        bool degradedReported = false;
+
+        Session(SlabPool& pool, size_t budgetBytes, const StreamingPatternAnalyzer::Options& options)
+            : arena(pool, budgetBytes), analyzer(options, &arena) {}
+    };
+
+    struct RestoredSession {
+        uint64_t sessionId;
+        std::string state;
+    };
+
+    class Worker {
+    public:
+        Worker(DetectorServer& server, size_t index);
+        ~Worker();
+
+        bool tryPush(Task& task);
+        void stop();
+        // 체크포인트에서 읽은 세션을 넘기고 이후 주기적 체크포인트 시작 (다음 프레임보다 먼저 복원)
+        void restore(std::vector<RestoredSession> sessions);
+
+    private:
+        void loop();
+        void process(Task& task, std::vector<Completion>& completions);
+        void evictIdle(std::vector<Completion>& completions);
+        void restoreSessions(std::vector<RestoredSession>& sessions);
+        // 이 워커의 세션 스냅샷을 서버에 전달 (finalCheckpoint면 파일은 서버 소멸자가 기록)
+        void checkpoint(bool finalCheckpoint);
+        // 풀 점유량 변화를 서버 통계에 반영
+        void publishMemory();
+
+        DetectorServer& server_;
+        size_t index_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque<Task> queue_;
+        std::vector<RestoredSession> restoring_;
+        bool restorePending_ = false;
+        bool stopping_ = false;
+        SlabPool pool_; // 워커 스레드 전용 (sessions_보다 먼저 선언하여 나중에 소멸)
+        size_t publishedMemory_ = 0;
+        std::unordered_map<uint64_t, std::unique_ptr<Session>> sessions_; // 워커 스레드 전용
+        std::thread thread_;
+    };
+
+    struct Connection {
+        uint64_t id;
+        int fd;
+        std::vector<uint8_t> input;
+        std::string output;
+        size_t outputOffset = 0;
+        size_t pendingFrames = 0;
+        std::deque<Task> deferred; // 워커 큐가 가득 차서 아직 넘기지 못한 프레임 (순서 유지)
+        bool reading = true;
+        bool writing = false;
+        bool peerClosed = false; // 상대가 쓰기를 닫음 (EOF): 더 읽지 않고 남은 판정을 모두 보낸 뒤 닫음
+    };
+
+    void acceptConnections();
+    void handleReadable(Connection& connection);
+    bool parseFrames(Connection& connection);
+    void dispatch(Connection& connection, Task task);
+    void retryDeferred(Connection& connection);
+    void drainCompletions();
+    bool flushOutput(Connection& connection);
+    void updateInterest(Connection& connection);
+    bool isPaused(const Connection& connection) const;
+    void sendErrorAndClose(Connection& connection, const std::string& message);
+    void closeConnection(uint64_t connectionId);
+    // EOF를 받은 연결의 처리 중/밀린 프레임과 출력이 모두 비었으면 닫음
+    bool closeIfFinished(Connection& connection);
+    size_t workerFor(uint64_t sessionId) const;
+    void complete(std::vector<Completion>& completions);
+    void restoreCheckpoint();
+    void storeCheckpoint(size_t workerIndex, std::string records, uint64_t sessions, bool finalCheckpoint);
+    // checkpointMutex_를 잡은 상태에서 호출
+    void writeCheckpoint();
+
+    Options options_;
+    std::shared_ptr<const SuspiciousPatternMatcher> matcher_;
+    int listenFd_ = -1;
+    int epollFd_ = -1;
+    int wakeFd_ = -1;
+    std::atomic<bool> stopping_{false};
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections_; // 입출력 스레드 전용
+    std::unordered_set<uint64_t> blockedConnections_; // deferred가 비어 있지 않은 연결
+    uint64_t nextConnectionId_ = 0;
+
+    std::mutex completionMutex_;
+    std::vector<Completion> completions_;
+
+    // 워커별 최신 세션 스냅샷 묶음 (모든 워커가 새로 만들면 파일로 기록)
+    std::mutex checkpointMutex_;
+    std::vector<std::string> checkpointRecords_;
+    std::vector<uint64_t> checkpointSessions_;
+    std::vector<bool> checkpointFresh_;
+    size_t freshCheckpoints_ = 0;
+    bool checkpointActive_ = false; // 복원을 마친 뒤에만 기록 (복원 실패 시 기존 파일 보존)
+
+    struct AtomicStats {
+        std::atomic<uint64_t> connectionsAccepted{0};
+        std::atomic<uint64_t> activeConnections{0};
+        std::atomic<uint64_t> activeSessions{0};
+        std::atomic<uint64_t> sessionsEnded{0};
+        std::atomic<uint64_t> sessionsEvicted{0};
+        std::atomic<uint64_t> framesReceived{0};
+        std::atomic<uint64_t> eventsProcessed{0};
+        std::atomic<uint64_t> verdictsSent{0};
+        std::atomic<uint64_t> backpressurePauses{0};
+        std::atomic<uint64_t> protocolErrors{0};
+        std::atomic<uint64_t> degradedSessions{0};
+        std::atomic<uint64_t> sessionMemoryBytes{0};
+        std::atomic<uint64_t> peakSessionMemoryBytes{0};
+        std::atomic<uint64_t> peakActiveSessions{0};
+        std::atomic<uint64_t> sessionsRestored{0};
+        std::atomic<uint64_t> checkpointsWritten{0};
+        std::atomic<uint64_t> checkpointBytes{0};
+    } stats_;
+};
+
+#endif
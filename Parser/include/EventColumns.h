@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "InputEvent.h"
+
+// 열 지향(struct-of-arrays) 이벤트 저장소
+// - 타임스탬프: int64 마이크로초 (ms로 절삭하지 않음)
+// - 코드: uint16 = (KeyUp << 8) | VK, PatternKey의 9비트 심볼과 같은 배치
+//   VK > 0xFF는 WIDE_FLAG를 세우고 실제 값은 별도 표에 보관 (정상 로그에는 없음)
+class EventColumns {
+public:
+    static constexpr uint16_t KEY_UP_FLAG = 0x100;
+    static constexpr uint16_t WIDE_FLAG = 0x8000;
+    static constexpr uint16_t SYMBOL_MASK = 0x1FF;
+
+    EventColumns() = default;
+
+    static EventColumns fromEvents(const std::vector<InputEvent>& events);
+    static uint16_t packCode(EventType type, unsigned int keyCode) {
+        return static_cast<uint16_t>((type == EventType::KEY_UP ? KEY_UP_FLAG : 0) |
+            (keyCode <= 0xFF ? keyCode : WIDE_FLAG));
+    }
+
+    void reserve(size_t count);
+    void push(int64_t timestampUs, EventType type, unsigned int keyCode);
+    void clear();
+
+    size_t size() const { return codes_.size(); }
+    bool empty() const { return codes_.empty(); }
+
+    const int64_t* timestamps() const { return timestampsUs_.data(); }
+    const uint16_t* codes() const { return codes_.data(); }
+
+    int64_t timestampUs(size_t index) const { return timestampsUs_[index]; }
+    EventType type(size_t index) const { return (codes_[index] & KEY_UP_FLAG) ? EventType::KEY_UP : EventType::KEY_DOWN; }
+    bool isWide(size_t index) const { return (codes_[index] & WIDE_FLAG) != 0; }
+    unsigned int keyCode(size_t index) const;
+
+private:
+    std::vector<int64_t> timestampsUs_;
+    std::vector<uint16_t> codes_;
+    std::unordered_map<size_t, unsigned int> wideKeyCodes_;
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "Constants.h"
+#include "InputEvent.h"
+#include "PatternKey.h"
+
+// 압축 키 기반 마이크로 패턴 추출 커널
+// - 길이 범위(Lengths)와 키 집합(Keys)을 정책 타입으로 받아, 자주 쓰는 설정은 컴파일 타임 상수로 특수화
+// - 키 소속 검사는 256비트 비트맵(KeySet), 시간 간격 검사는 정수 tick 비교 한 번
+// - dispatch()가 설정에 맞는 특수화를 고르고, 없으면 런타임 값을 쓰는 일반 경로로 처리
+namespace ExtractionKernel {
+    template <int MinLength, int MaxLength>
+    struct StaticLengths {
+        static_assert(MinLength >= 1 && MinLength <= MaxLength && MaxLength <= PatternKey::MAX_LENGTH,
+            "Invalid pattern length range");
+        constexpr int minLength() const { return MinLength; }
+        constexpr int maxLength() const { return MaxLength; }
+    };
+
+    struct RuntimeLengths {
+        int min;
+        int max;
+        int minLength() const { return min; }
+        int maxLength() const { return max; }
+    };
+
+    // 기본 키 설정 (Constants::patternStartKeyBits / patternCoreKeyBits)
+    struct DefaultKeys {
+        static constexpr bool isStart(unsigned int keyCode) { return Constants::patternStartKeyBits.contains(keyCode); }
+        static constexpr bool isCore(unsigned int keyCode) { return Constants::patternCoreKeyBits.contains(keyCode); }
+    };
+
+    struct RuntimeKeys {
+        KeySet start;
+        KeySet core;
+        bool isStart(unsigned int keyCode) const { return start.contains(keyCode); }
+        bool isCore(unsigned int keyCode) const { return core.contains(keyCode); }
+    };
+
+    // isWithinTimeWindow(밀리초 절삭 후 <= threshold)와 같은 판정을 절삭 없이 tick 비교로 수행
+    class GapLimit {
+    public:
+        using Duration = std::chrono::high_resolution_clock::duration;
+
+        explicit GapLimit(long long thresholdMs) : unlimited_(false), inclusive_(thresholdMs < 0), bound_(0) {
+            // tick 단위로 표현할 수 없을 만큼 큰 임계값은 제한 없음으로 처리
+            const long long maxMs = std::chrono::duration_cast<std::chrono::milliseconds>(Duration::max()).count() - 1;
+            if (thresholdMs >= maxMs || thresholdMs <= -maxMs) {
+                unlimited_ = thresholdMs > 0;
+                inclusive_ = true;
+                bound_ = thresholdMs > 0 ? Duration::max() : Duration::min();
+                return;
+            }
+            bound_ = std::chrono::duration_cast<Duration>(std::chrono::milliseconds(inclusive_ ? thresholdMs : thresholdMs + 1));
+        }
+
+        bool within(const InputEvent& previous, const InputEvent& next) const {
+            const Duration gap = next.timestamp - previous.timestamp;
+            return unlimited_ || (inclusive_ ? gap <= bound_ : gap < bound_);
+        }
+
+    private:
+        bool unlimited_;
+        bool inclusive_;
+        Duration bound_;
+    };
+
+    // 접두사 확장 알림을 받는 Sink (beginPattern/extendPattern, 예: TimedPatternSink)
+    template <typename Sink, typename = void>
+    struct TracksPrefix : std::false_type {};
+    template <typename Sink>
+    struct TracksPrefix<Sink, std::void_t<decltype(&Sink::extendPattern)>> : std::true_type {};
+
+    // [begin, end) 구간에서 시작 이벤트마다 한 번만 전진하며 접두사를 확장하고,
+    // 길이가 범위에 들어올 때마다 집계 (확장은 lookaheadEnd 이전까지, 그 뒤의 이벤트는 보지 않음)
+    // Sink: increment(PatternKey), incrementUnpacked(MicroPattern)
+    //       + 선택적으로 beginPattern(InputEvent), extendPattern(InputEvent, InputEvent) (다른 Sink는 비용 없음)
+    template <typename Lengths, typename Keys, typename Sink>
+    void run(const std::vector<InputEvent>& events, size_t begin, size_t end, size_t lookaheadEnd,
+        const Lengths& lengths, const Keys& keys, const GapLimit& gapLimit, Sink& frequencies) {
+        const int minLength = lengths.minLength();
+        const int maxLength = lengths.maxLength();
+
+        for (size_t i = begin; i < end; ++i) {
+            if (events[i].type != EventType::KEY_DOWN || !keys.isStart(events[i].keyCode)) {
+                continue;
+            }
+
+            PatternKey currentPattern;
+            bool packable = true;
+            bool containsCoreKey = false;
+            const size_t limit = lookaheadEnd - i;
+
+            for (int j = 0; j < maxLength && static_cast<size_t>(j) < limit; ++j) {
+                const InputEvent& event = events[i + j];
+                if (j > 0 && !gapLimit.within(events[i + j - 1], event)) {
+                    break;
+                }
+                if constexpr (TracksPrefix<Sink>::value) {
+                    if (j == 0) {
+                        frequencies.beginPattern(event);
+                    }
+                    else {
+                        frequencies.extendPattern(events[i + j - 1], event);
+                    }
+                }
+                if (PatternKey::canEncode(event.keyCode)) {
+                    currentPattern.push(event.type, event.keyCode);
+                }
+                else {
+                    packable = false;
+                }
+                containsCoreKey = containsCoreKey || keys.isCore(event.keyCode);
+
+                const int len = j + 1;
+                if (len >= minLength && containsCoreKey) {
+                    if (packable) {
+                        frequencies.increment(currentPattern);
+                    }
+                    else {
+                        // VK > 0xFF: 압축 불가 패턴은 기존 표현으로 집계
+                        MicroPattern unpacked;
+                        for (int k = 0; k < len; ++k) {
+                            unpacked.push_back({events[i + k].type, events[i + k].keyCode});
+                        }
+                        frequencies.incrementUnpacked(unpacked);
+                    }
+                }
+            }
+        }
+    }
+
+    // 미리 특수화된 길이 범위: 기본(6~8)과 자주 쓰는 변형
+    template <typename Keys, typename Sink>
+    bool runStaticLengths(const std::vector<InputEvent>& events, size_t begin, size_t end, size_t lookaheadEnd,
+        int minLength, int maxLength, const Keys& keys, const GapLimit& gapLimit, Sink& frequencies) {
+        if (minLength == 6 && maxLength == 8) {
+            run(events, begin, end, lookaheadEnd, StaticLengths<6, 8>(), keys, gapLimit, frequencies);
+        }
+        else if (minLength == 4 && maxLength == 8) {
+            run(events, begin, end, lookaheadEnd, StaticLengths<4, 8>(), keys, gapLimit, frequencies);
+        }
+        else if (minLength == 6 && maxLength == 6) {
+            run(events, begin, end, lookaheadEnd, StaticLengths<6, 6>(), keys, gapLimit, frequencies);
+        }
+        else if (minLength == 8 && maxLength == 8) {
+            run(events, begin, end, lookaheadEnd, StaticLengths<8, 8>(), keys, gapLimit, frequencies);
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    // 설정에 맞는 특수화 선택: (기본 키 | 런타임 키) x (특수화 길이 | 런타임 길이)
+    // lookaheadEnd: 구간 끝 이후로 패턴이 확장될 수 있는 한계 (청크 경계를 넘는 패턴 집계용, 보통 end)
+    template <typename Sink>
+    void dispatch(const std::vector<InputEvent>& events, size_t begin, size_t end, size_t lookaheadEnd,
+        int minLength, int maxLength, long long thresholdMs, const KeySet& startKeys, const KeySet& coreKeys,
+        Sink& frequencies) {
+        const GapLimit gapLimit(thresholdMs);
+        if (startKeys == Constants::patternStartKeyBits && coreKeys == Constants::patternCoreKeyBits) {
+            if (runStaticLengths(events, begin, end, lookaheadEnd, minLength, maxLength, DefaultKeys(), gapLimit, frequencies)) {
+                return;
+            }
+            run(events, begin, end, lookaheadEnd, RuntimeLengths{minLength, maxLength}, DefaultKeys(), gapLimit, frequencies);
+            return;
+        }
+
+        const RuntimeKeys keys{startKeys, coreKeys};
+        if (runStaticLengths(events, begin, end, lookaheadEnd, minLength, maxLength, keys, gapLimit, frequencies)) {
+            return;
+        }
+        run(events, begin, end, lookaheadEnd, RuntimeLengths{minLength, maxLength}, keys, gapLimit, frequencies);
+    }
+}
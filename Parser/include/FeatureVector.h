@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "PatternKey.h"
+#include "PatternCounter.h"
+
+// 세션 하나의 빈도수 분포 특징
+// - 빈도수 내림차순 정렬 목록 하나와 누적 빈도수 배열(prefix[k] = 상위 k개 합)을 한 번만 만듦
+// - 상위 N개 집중도는 O(1), 커버리지 패턴 수는 누적 배열 이진 탐색 O(log n)
+// - 패턴 목록 출력과 분석 결과 저장도 같은 정렬 목록을 읽음 (다시 정렬하거나 합산하지 않음)
+class FeatureVector {
+public:
+    FeatureVector();
+    // PatternCounter::toSortedPairs와 같은 순서
+    explicit FeatureVector(const PatternCounter& frequencies);
+    explicit FeatureVector(const PatternFrequencyMap& frequencies);
+    // 이미 빈도수 내림차순으로 정렬된 목록
+    explicit FeatureVector(std::vector<PatternCountPair> sortedFrequencies);
+
+    const std::vector<PatternCountPair>& sorted() const { return sorted_; }
+    size_t uniquePatterns() const { return sorted_.size(); }
+    long long totalInstances() const { return prefix_.back(); }
+    bool empty() const { return sorted_.empty(); }
+
+    // 상위 N개 패턴의 빈도수 합
+    long long topNCount(int N) const;
+    // 상위 N개 점유율(%)
+    double topNConcentration(int N) const;
+    // 누적 점유율이 coveragePercentage(%) 이상이 되는 최소 패턴 수
+    int coveragePatternCount(double coveragePercentage) const;
+
+    // 여러 N / 커버리지 비율을 한 번에 (특징 스윕용, 입력과 같은 순서)
+    std::vector<double> topNConcentrations(const std::vector<int>& Ns) const;
+    std::vector<int> coveragePatternCounts(const std::vector<double>& coveragePercentages) const;
+
+private:
+    void buildPrefix();
+
+    std::vector<PatternCountPair> sorted_;
+    std::vector<long long> prefix_; // 크기 sorted_.size() + 1
+};
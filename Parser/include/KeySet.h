@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+// 가상 키 코드(0~255) 집합을 256비트 비트맵으로 표현 (constexpr 생성 가능)
+// 추출 루프의 키 소속 검사를 해시 조회 대신 시프트/AND 한 번으로 처리
+struct KeySet {
+    uint64_t words[4] = {0, 0, 0, 0};
+
+    static constexpr KeySet of(std::initializer_list<unsigned int> keyCodes) {
+        KeySet keys;
+        for (unsigned int keyCode : keyCodes) {
+            keys.insert(keyCode);
+        }
+        return keys;
+    }
+
+    constexpr void insert(unsigned int keyCode) {
+        if (keyCode < 256) {
+            words[keyCode >> 6] |= uint64_t(1) << (keyCode & 63);
+        }
+    }
+
+    constexpr bool contains(unsigned int keyCode) const {
+        return keyCode < 256 && ((words[keyCode >> 6] >> (keyCode & 63)) & 1) != 0;
+    }
+
+    constexpr bool empty() const {
+        return (words[0] | words[1] | words[2] | words[3]) == 0;
+    }
+
+    constexpr bool operator==(const KeySet& other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1] &&
+            words[2] == other.words[2] && words[3] == other.words[3];
+    }
+
+    constexpr bool operator!=(const KeySet& other) const {
+        return !(*this == other);
+    }
+};
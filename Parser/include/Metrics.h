@@ -0,0 +1,89 @@
+#pragma once
+
+// 단계별 계측 (타이머/카운터/지연 히스토그램)
+// KMD_METRICS가 정의된 빌드에서만 동작하며, 정의되지 않으면 아래 매크로는 모두 빈 문장이 되어
+// 핫 루프에 아무 코드도 남지 않음
+//   METRICS_SCOPED_TIMER(Metrics::Stage::PARSE);     // 블록 종료 시 지연 시간 기록
+//   METRICS_COUNT(Metrics::Counter::MALFORMED_LINES, 1);
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Metrics {
+    enum class Stage {
+        PARSE,
+        EXTRACT,
+        SORT,
+        FEATURE,
+        SCORE,
+        SAVE,
+        SESSION,
+        COUNT
+    };
+
+    enum class Counter {
+        EVENTS_PARSED,
+        MALFORMED_LINES,
+        CORRUPT_BLOCKS,
+        EVENTS_EXTRACTED,
+        PATTERN_INSTANCES,
+        DISTINCT_PATTERNS,
+        SESSIONS,
+        ALLOCATIONS,
+        ALLOCATED_BYTES,
+        COUNT
+    };
+
+    // 지연 시간 히스토그램 버킷 상한 (초, Prometheus `le`): 10us ~ 100s, 마지막은 +Inf
+    constexpr size_t HISTOGRAM_BUCKETS = 15;
+
+    struct StageSnapshot {
+        uint64_t count = 0;
+        double sumSeconds = 0.0;
+        uint64_t buckets[HISTOGRAM_BUCKETS + 1] = {};
+    };
+
+    const char* stageName(Stage stage);
+    const char* counterName(Counter counter);
+    double bucketBound(size_t bucket);
+
+    bool enabled();
+    void recordStage(Stage stage, std::chrono::nanoseconds elapsed);
+    void add(Counter counter, uint64_t value);
+    uint64_t value(Counter counter);
+    StageSnapshot stage(Stage stage);
+    void reset();
+
+    // Prometheus 텍스트 형식으로 덮어쓰기 / JSON 한 줄(스냅샷) 추가
+    void writePrometheus(const std::string& filename);
+    void appendJsonLine(const std::string& filename, const std::string& label);
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Stage stage) : stage_(stage), start_(std::chrono::steady_clock::now()) {
+        }
+        ~ScopedTimer() {
+            recordStage(stage_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_));
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Stage stage_;
+        std::chrono::steady_clock::time_point start_;
+    };
+}
+
+#ifdef KMD_METRICS
+#define METRICS_CONCAT_INNER(a, b) a##b
+#define METRICS_CONCAT(a, b) METRICS_CONCAT_INNER(a, b)
+#define METRICS_SCOPED_TIMER(stage) ::Metrics::ScopedTimer METRICS_CONCAT(metricsTimer_, __LINE__)(stage)
+#define METRICS_COUNT(counter, amount) ::Metrics::add((counter), static_cast<uint64_t>(amount))
+#else
+#define METRICS_SCOPED_TIMER(stage) ((void)0)
+#define METRICS_COUNT(counter, amount) ((void)0)
+#endif
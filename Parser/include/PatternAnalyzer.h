@@ -6,39 +6,131 @@
 #include <set>
 #include <chrono>
 #include "InputEvent.h"
+#include "Constants.h"
+#include "KeySet.h"
+#include "PatternKey.h"
+#include "PatternCounter.h"
+#include "PatternTrie.h"
+#include "SpaceSavingSketch.h"
+#include "EventColumns.h"
+#include "PatternTiming.h"
+#include "FeatureVector.h"
 
-// 패턴 정의: [(DOWN, ALT), (UP, ALT), ...]
-using MicroPattern = std::vector<std::pair<EventType, unsigned int>>;
+// 마이크로 패턴 추출 설정: 길이 범위, 인접 이벤트 간 최대 간격,
+// 패턴을 시작하는 키(KEY_DOWN)와 패턴에 하나 이상 포함되어야 하는 핵심 키
+struct ExtractionConfig {
+    int minLength = 6;
+    int maxLength = 8;
+    long long timeThresholdMs = 300;
+    KeySet startKeys = Constants::patternStartKeyBits;
+    KeySet coreKeys = Constants::patternCoreKeyBits;
+};
 
-// 패턴 빈도수 맵: Pattern -> Count
-using PatternFrequencyMap = std::map<MicroPattern, int>;
+// 점수/판정 임계값과 가중치 (기본값은 Constants, 튜닝 모드에서 바꿔 가며 평가)
+struct ScoringParams {
+    double top5ConcentrationLow = Constants::THRESH_CONC_TOP5_LOW;
+    double coverageHigh = Constants::THRESH_COVERAGE_HIGH;
+    double suspiciousHigh = Constants::THRESH_SUSPICIOUS_HIGH;
+    double timingVariationLow = Constants::THRESH_TIMING_VARIATION_LOW;
+    double weightConcentration = Constants::WEIGHT_CONCENTRATION;
+    double weightFlatness = Constants::WEIGHT_FLATNESS;
+    double weightSuspicious = Constants::WEIGHT_SUSPICIOUS;
+    double weightTiming = Constants::WEIGHT_TIMING;
+    double decisionThreshold = Constants::FINAL_DECISION_THRESHOLD;
+};
 
-// 정렬된 빈도수 쌍: {Pattern, Count}
-using PatternCountPair = std::pair<MicroPattern, int>;
+class SuspiciousPatternMatcher;
 
 class PatternAnalyzer {
 public:
     // 파일 파싱
     static std::vector<InputEvent> parseLogFile(const std::string& filename);
+    // 메모리 맵 기반 파싱 (parseLogFile과 동일한 결과/경고, 줄 단위 할당 없음)
+    static std::vector<InputEvent> parseLogFileMapped(const std::string& filename);
+    // 이진 로그(.kmdl) 파싱: 메모리 맵에서 바로 디코딩, 블록 CRC 불일치 시 해당 블록만 건너뜀
+    static std::vector<InputEvent> parseBinaryLogFile(const std::string& filename);
+    // 파일 앞 4바이트로 이진/CSV 형식을 판별하여 파싱
+    static std::vector<InputEvent> parseEventLogFile(const std::string& filename);
+    // CSV 헤더 줄 [begin, end) 확인 (다르면 경고만 출력)
+    static void checkLogHeader(const char* begin, const char* end, const std::string& filename);
+    // CSV 한 줄 [begin, end)를 파싱하여 events에 추가 (정상 줄은 할당 없이, 비정상 줄은 경고 출력 후 무시)
+    static void appendLogLine(const char* begin, const char* end, int lineNumber, const std::string& filename,
+        std::vector<InputEvent>& events);
     
     // 패턴 분석
     static PatternFrequencyMap calculateMicroPatternFrequencies(const std::vector<InputEvent>& events);
+    static PatternFrequencyMap calculateMicroPatternFrequencies(const std::vector<InputEvent>& events,
+        const ExtractionConfig& config);
+    // 압축 키 기반 빈도수 계산 (maxLength <= PatternKey::MAX_LENGTH)
+    static PatternCounter calculatePackedPatternFrequencies(const std::vector<InputEvent>& events,
+        const ExtractionConfig& config = ExtractionConfig());
+    // 빈도수와 함께 같은 패스에서 패턴 내부 간격/누름 시간 통계를 timing에 누적
+    static PatternCounter calculatePackedPatternFrequencies(const std::vector<InputEvent>& events,
+        const ExtractionConfig& config, PatternTimingTable& timing);
+    // 열 지향 저장소 기반 빈도수 계산: 벡터화 스캔으로 시작 위치/간격 끊김 비트마스크를 만든 뒤
+    // 유효한 시작 위치만 방문 (타임스탬프는 마이크로초 단위로 비교)
+    static PatternCounter calculatePackedPatternFrequencies(const EventColumns& columns,
+        const ExtractionConfig& config = ExtractionConfig());
+    // 임계값보다 긴 간격에서 이벤트를 나눠 스레드별로 집계 후 병렬 병합 (순차 결과와 동일)
+    static PatternCounter calculatePackedPatternFrequenciesParallel(const std::vector<InputEvent>& events,
+        const ExtractionConfig& config = ExtractionConfig(), size_t threadCount = 0);
+    // 약 chunkCount개로 나누는 경계 인덱스 [0, ..., size] (경계는 항상 임계값 초과 간격 위치)
+    static std::vector<size_t> splitAtIdleGaps(const std::vector<InputEvent>& events,
+        size_t chunkCount, long long timeThresholdMs);
+    // 트라이 기반 빈도수 계산 (길이 제한 없음)
+    static PatternTrie calculateTriePatternFrequencies(const std::vector<InputEvent>& events,
+        const ExtractionConfig& config);
+    // 고정 용량 Space-Saving 스케치로 집계 (세션당 메모리 상한, 상위 패턴은 오차 범위와 함께 근사)
+    static SpaceSavingSketch calculatePatternSketch(const std::vector<InputEvent>& events,
+        const ExtractionConfig& config, size_t capacity);
     static bool isWithinTimeWindow(const InputEvent& event1, const InputEvent& event2, long long threshold_ms);
     static std::string getVirtualKeyName(unsigned int keyCode);
     static void printFrequencies(const PatternFrequencyMap& frequencies, const std::string& label);
+    static void printFrequencies(const PatternCounter& frequencies, const std::string& label);
+    // 특징 벡터의 정렬 목록 출력 (저장/특징 계산과 같은 정렬 결과를 공유)
+    static void printFrequencies(const FeatureVector& features, const std::string& label);
+    // 이미 정렬된 목록 출력 (기존 호출부 호환용, 고유 패턴 수는 받은 값을 그대로 출력)
+    static void printFrequencies(const std::vector<PatternCountPair>& sortedFrequencies,
+        size_t uniquePatterns, const std::string& label);
     
     // 봇 탐지 기능
+    // 정렬된 목록을 복사 없이 훑음 (기존 호출부 호환용). 분모는 totalInstances이므로 잘린 목록도 전체 대비 값
     static double calculateTopNConcentration(const std::vector<PatternCountPair>& sortedFrequencies,
         long long totalInstances, int N);
     static int calculateCoveragePatternCount(const std::vector<PatternCountPair>& sortedFrequencies,
         long long totalInstances, double coveragePercentage);
+    // 정렬된 패턴 목록 없이 빈도수만으로 계산 (nth_element/partial_sort, 결과는 FeatureVector와 동일)
+    static double calculateTopNConcentration(const PatternCounter& frequencies, int N);
+    static int calculateCoveragePatternCount(const PatternCounter& frequencies, double coveragePercentage);
     static double calculateSuspiciousPatternScore(const PatternFrequencyMap& frequencies,
         long long totalInstances, const std::set<MicroPattern>& suspiciousPatterns);
+    static double calculateSuspiciousPatternScore(const PatternCounter& frequencies,
+        long long totalInstances, const std::set<MicroPattern>& suspiciousPatterns);
+    // 빈도수 맵 없이 이벤트 스트림을 한 번 훑어 계산 (컴파일된 의심 패턴 오토마톤 사용)
+    static double calculateSuspiciousPatternScore(const std::vector<InputEvent>& events,
+        long long totalInstances, const SuspiciousPatternMatcher& matcher);
+    // 상위 N개 패턴 내부 간격의 변동 계수(stddev / mean), 인스턴스 수 가중 평균
+    static double calculateDominantTimingVariation(const PatternCounter& frequencies,
+        const PatternTimingTable& timing, int N = 5);
+    static double calculateBotSuspicionScore(double top2Concentration,
+        double top5Concentration, int patternsFor50Coverage, double suspiciousScore,
+        const ScoringParams& params = ScoringParams());
+    // 타이밍 변동 특징 포함 (기본 가중치 0: 기존 판정과 동일)
     static double calculateBotSuspicionScore(double top2Concentration,
-        double top5Concentration, int patternsFor50Coverage, double suspiciousScore);
-    static bool isBotSuspected(double finalScore);
+        double top5Concentration, int patternsFor50Coverage, double suspiciousScore, double timingVariation,
+        const ScoringParams& params = ScoringParams());
+    static bool isBotSuspected(double finalScore, const ScoringParams& params = ScoringParams());
 
     // 분석 결과를 JSON 파일로 저장
+    static void saveAnalysisResults(
+        const std::string& filename,
+        const FeatureVector& features,
+        double top2Concentration,
+        double top5Concentration,
+        int coveragePatternCount,
+        double suspiciousScore,
+        double finalScore);
+    // 정렬된 목록을 받는 기존 형식 (전체 인스턴스 수는 목록 합계)
     static void saveAnalysisResults(
         const std::string& filename,
         const std::vector<PatternCountPair>& sortedFrequencies,
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "PatternKey.h"
+
+// PatternKey -> Count 개방 주소법(선형 탐사) 해시 테이블
+// 압축할 수 없는 패턴(VK > 0xFF)은 overflow 맵에 따로 저장하여 결과를 동일하게 유지
+class PatternCounter {
+public:
+    explicit PatternCounter(size_t initialCapacity = 1024);
+
+    void increment(const PatternKey& key, int amount = 1) {
+        if ((distinct_ + 1) * 4 > slots_.size() * 3) {
+            grow();
+        }
+        Slot& slot = findSlot(key);
+        if (slot.key.empty()) {
+            slot.key = key;
+            distinct_++;
+        }
+        slot.count += amount;
+        totalInstances_ += amount;
+    }
+    void incrementUnpacked(const MicroPattern& pattern, int amount = 1);
+
+    int count(const PatternKey& key) const;
+    int count(const MicroPattern& pattern) const;
+
+    // 고유 패턴 수 / 전체 패턴 인스턴스 수
+    size_t size() const { return distinct_ + overflow_.size(); }
+    bool empty() const { return size() == 0; }
+    long long totalInstances() const { return totalInstances_; }
+
+    void merge(const PatternCounter& other);
+    void clear();
+
+    // 압축된 패턴 순회: f(const PatternKey&, int)
+    template <typename Func>
+    void forEachPacked(Func func) const {
+        for (const Slot& slot : slots_) {
+            if (!slot.key.empty()) {
+                func(slot.key, slot.count);
+            }
+        }
+    }
+    const PatternFrequencyMap& overflow() const { return overflow_; }
+
+    // 보고 시점 변환: MicroPattern 기반 표현
+    PatternFrequencyMap toFrequencyMap() const;
+    // 빈도수 내림차순 정렬 (맵 순서 -> std::sort, 기존 결과와 동일한 순서)
+    std::vector<PatternCountPair> toSortedPairs() const;
+
+private:
+    struct Slot {
+        PatternKey key;
+        int count = 0;
+    };
+
+    Slot& findSlot(const PatternKey& key) {
+        size_t index = static_cast<size_t>(key.hash()) & mask_;
+        while (!slots_[index].key.empty() && slots_[index].key != key) {
+            index = (index + 1) & mask_;
+        }
+        return slots_[index];
+    }
+    const Slot& findSlot(const PatternKey& key) const {
+        return const_cast<PatternCounter*>(this)->findSlot(key);
+    }
+    void grow();
+
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    size_t distinct_ = 0;
+    long long totalInstances_ = 0;
+    PatternFrequencyMap overflow_;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "InputEvent.h"
+
+// 패턴 정의: [(DOWN, ALT), (UP, ALT), ...]
+using MicroPattern = std::vector<std::pair<EventType, unsigned int>>;
+
+// 패턴 빈도수 맵: Pattern -> Count
+using PatternFrequencyMap = std::map<MicroPattern, int>;
+
+// 정렬된 빈도수 쌍: {Pattern, Count}
+using PatternCountPair = std::pair<MicroPattern, int>;
+
+// 최대 8개 이벤트의 패턴을 128비트 값으로 압축한 키
+// 이벤트당 9비트(타입 1비트 + VK 8비트): 0~5번은 lo, 6~7번은 hi, 길이는 hi 상위 4비트
+struct PatternKey {
+    static constexpr int MAX_LENGTH = 8;
+    static constexpr int BITS_PER_EVENT = 9;
+    static constexpr int EVENTS_IN_LO = 6;
+    static constexpr int LENGTH_SHIFT = 60;
+
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    // VK 코드가 8비트를 넘으면 압축 불가 (정상 VK 코드는 1~254)
+    static bool canEncode(unsigned int keyCode) { return keyCode <= 0xFF; }
+
+    int length() const { return static_cast<int>(hi >> LENGTH_SHIFT); }
+    bool empty() const { return hi == 0; }
+
+    // 패턴 끝에 이벤트 추가 (length() < MAX_LENGTH, canEncode(keyCode) 가정)
+    void push(EventType type, unsigned int keyCode) {
+        pushSymbol((static_cast<unsigned int>(type == EventType::KEY_UP) << 8) | (keyCode & 0xFF));
+    }
+
+    // 9비트 심볼((KeyUp << 8) | VK)을 그대로 추가
+    void pushSymbol(unsigned int symbolBits) {
+        const int index = length();
+        const uint64_t symbol = symbolBits & 0x1FF;
+        if (index < EVENTS_IN_LO) {
+            lo |= symbol << (index * BITS_PER_EVENT);
+        }
+        else {
+            hi |= symbol << ((index - EVENTS_IN_LO) * BITS_PER_EVENT);
+        }
+        hi = (hi & ~(uint64_t(0xF) << LENGTH_SHIFT)) | (static_cast<uint64_t>(index + 1) << LENGTH_SHIFT);
+    }
+
+    unsigned int symbolAt(int index) const {
+        const uint64_t bits = index < EVENTS_IN_LO
+            ? lo >> (index * BITS_PER_EVENT)
+            : hi >> ((index - EVENTS_IN_LO) * BITS_PER_EVENT);
+        return static_cast<unsigned int>(bits & 0x1FF);
+    }
+    EventType typeAt(int index) const { return (symbolAt(index) & 0x100) ? EventType::KEY_UP : EventType::KEY_DOWN; }
+    unsigned int keyCodeAt(int index) const { return symbolAt(index) & 0xFF; }
+
+    MicroPattern toMicroPattern() const {
+        MicroPattern pattern;
+        pattern.reserve(length());
+        for (int i = 0; i < length(); ++i) {
+            pattern.push_back({typeAt(i), keyCodeAt(i)});
+        }
+        return pattern;
+    }
+
+    // 압축 불가(길이 초과, VK > 0xFF)면 false
+    static bool fromMicroPattern(const MicroPattern& pattern, PatternKey& key) {
+        if (pattern.empty() || pattern.size() > static_cast<size_t>(MAX_LENGTH)) {
+            return false;
+        }
+        key = PatternKey();
+        for (const auto& eventPair : pattern) {
+            if (!canEncode(eventPair.second)) {
+                return false;
+            }
+            key.push(eventPair.first, eventPair.second);
+        }
+        return true;
+    }
+
+    bool operator==(const PatternKey& other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const PatternKey& other) const { return !(*this == other); }
+
+    // MicroPattern(std::vector)의 사전순 비교와 동일한 순서
+    bool operator<(const PatternKey& other) const {
+        const int commonLength = (std::min)(length(), other.length());
+        for (int i = 0; i < commonLength; ++i) {
+            const unsigned int a = symbolAt(i);
+            const unsigned int b = other.symbolAt(i);
+            if (a != b) {
+                return a < b;
+            }
+        }
+        return length() < other.length();
+    }
+
+    uint64_t hash() const {
+        uint64_t h = lo * 0x9E3779B97F4A7C15ULL ^ (hi + 0x632BE59BD9B4E019ULL + (lo >> 29));
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ULL;
+        h ^= h >> 32;
+        return h;
+    }
+};
+
+struct PatternKeyHash {
+    size_t operator()(const PatternKey& key) const { return static_cast<size_t>(key.hash()); }
+};
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InputEvent.h"
+#include "PatternCounter.h"
+
+// 온라인 평균/분산 (Welford). merge()는 두 부분 집합의 통계를 합침 (Chan et al.)
+struct RunningStats {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double value) {
+        count++;
+        const double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+    }
+
+    void merge(const RunningStats& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const double total = static_cast<double>(count + other.count);
+        const double delta = other.mean - mean;
+        mean += delta * (static_cast<double>(other.count) / total);
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * static_cast<double>(other.count) / total);
+        count += other.count;
+    }
+
+    // 모분산 (표본이 1개 이하면 0)
+    double variance() const { return count > 1 ? m2 / static_cast<double>(count) : 0.0; }
+    double stddev() const;
+    // 변동 계수 (stddev / mean, 평균이 0이면 0)
+    double coefficientOfVariation() const;
+};
+
+// 고정 구간 히스토그램 (밀리초): [0,10) [10,20) [20,40) [40,60) [60,100) [100,150) [150,300) [300,∞)
+struct TimingHistogram {
+    static constexpr int BUCKETS = 8;
+    uint32_t counts[BUCKETS] = {};
+
+    static int bucketOf(double ms) {
+        static const double upperBounds[BUCKETS - 1] = {10.0, 20.0, 40.0, 60.0, 100.0, 150.0, 300.0};
+        int bucket = 0;
+        while (bucket < BUCKETS - 1 && ms >= upperBounds[bucket]) {
+            bucket++;
+        }
+        return bucket;
+    }
+
+    void add(double ms) { counts[bucketOf(ms)]++; }
+    void merge(const TimingHistogram& other) {
+        for (int i = 0; i < BUCKETS; ++i) {
+            counts[i] += other.counts[i];
+        }
+    }
+};
+
+// 패턴 하나의 타이밍 통계: 패턴 내부 인접 이벤트 간격과 키 누름 시간(같은 키의 DOWN -> UP)
+struct PatternTiming {
+    uint64_t instances = 0;
+    RunningStats gaps;
+    RunningStats holds;
+    TimingHistogram gapHistogram;
+    TimingHistogram holdHistogram;
+
+    void merge(const PatternTiming& other, bool histograms = true) {
+        instances += other.instances;
+        gaps.merge(other.gaps);
+        holds.merge(other.holds);
+        if (histograms) {
+            gapHistogram.merge(other.gapHistogram);
+            holdHistogram.merge(other.holdHistogram);
+        }
+    }
+};
+
+// PatternKey -> PatternTiming (개방 주소법). 최대 maxPatterns개 패턴만 개별 추적하고,
+// 그 이후 새 패턴은 세션 전체 통계(overall)에만 반영하여 메모리 상한 유지
+class PatternTimingTable {
+public:
+    struct Options {
+        bool histograms = false;
+        size_t maxPatterns = 4096;
+    };
+
+    PatternTimingTable();
+    explicit PatternTimingTable(const Options& options);
+
+    void record(const PatternKey& key, const PatternTiming& instance);
+
+    // 추적 중이 아니면 nullptr
+    const PatternTiming* find(const PatternKey& key) const;
+    // 세션 전체 통계 (추적 패턴 + 상한 초과 패턴, 호출 시 합산)
+    PatternTiming overall() const;
+    const Options& options() const { return options_; }
+    size_t size() const { return timings_.size(); }
+    uint64_t untrackedInstances() const { return untracked_.instances; }
+
+    void merge(const PatternTimingTable& other);
+
+    // 추적 중인 패턴 순회: f(const PatternKey&, const PatternTiming&)
+    template <typename Func>
+    void forEach(Func func) const {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            func(keys_[i], timings_[i]);
+        }
+    }
+
+private:
+    struct Slot {
+        PatternKey key;
+        uint32_t index = 0; // timings_ 인덱스 (key가 비어 있으면 빈 슬롯)
+    };
+
+    Slot& findSlot(const PatternKey& key) {
+        size_t index = static_cast<size_t>(key.hash()) & mask_;
+        while (!slots_[index].key.empty() && slots_[index].key != key) {
+            index = (index + 1) & mask_;
+        }
+        return slots_[index];
+    }
+    // 새 패턴이면 추적 항목을 추가, 상한에 도달했으면 nullptr
+    PatternTiming* findOrInsert(const PatternKey& key);
+    void grow();
+
+    Options options_;
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    std::vector<PatternKey> keys_;
+    std::vector<PatternTiming> timings_;
+    PatternTiming untracked_;
+};
+
+// 추출 커널 Sink: 빈도수를 PatternCounter에 집계하면서 같은 패스에서 패턴 내부 타이밍을 누적
+// 접두사를 한 이벤트씩 확장할 때 간격/누름 시간의 (이동된) 합과 제곱합만 갱신하고,
+// 패턴 집계 시 평균/분산으로 바꿔 합치므로 패턴 길이만큼 다시 훑지 않음
+// VK > 0xFF가 포함된 패턴은 빈도수만 집계
+class TimedPatternSink {
+public:
+    TimedPatternSink(PatternCounter& frequencies, PatternTimingTable& timing)
+        : frequencies_(frequencies), timing_(timing), histograms_(timing.options().histograms) {
+        instance_.instances = 1;
+    }
+
+    void beginPattern(const InputEvent& event) {
+        gapSums_ = PrefixSums();
+        holdSums_ = PrefixSums();
+        if (histograms_) {
+            instance_.gapHistogram = TimingHistogram();
+            instance_.holdHistogram = TimingHistogram();
+        }
+        pressedCount_ = 0;
+        pressed_[pressedCount_++] = {event.keyCode, event.timestamp};
+    }
+
+    void extendPattern(const InputEvent& previous, const InputEvent& event) {
+        const double gapMs = toMilliseconds(event.timestamp - previous.timestamp);
+        gapSums_.add(gapMs);
+        if (histograms_) {
+            instance_.gapHistogram.add(gapMs);
+        }
+
+        if (event.type == EventType::KEY_DOWN) {
+            pressed_[pressedCount_++] = {event.keyCode, event.timestamp};
+            return;
+        }
+        // 접두사 안에서 가장 최근에 눌린 같은 키와 짝지음
+        for (int i = pressedCount_ - 1; i >= 0; --i) {
+            if (pressed_[i].keyCode == event.keyCode) {
+                const double holdMs = toMilliseconds(event.timestamp - pressed_[i].timestamp);
+                holdSums_.add(holdMs);
+                if (histograms_) {
+                    instance_.holdHistogram.add(holdMs);
+                }
+                for (int k = i + 1; k < pressedCount_; ++k) {
+                    pressed_[k - 1] = pressed_[k];
+                }
+                pressedCount_--;
+                break;
+            }
+        }
+    }
+
+    void increment(const PatternKey& key) {
+        frequencies_.increment(key);
+        instance_.gaps = gapSums_.toRunningStats();
+        instance_.holds = holdSums_.toRunningStats();
+        timing_.record(key, instance_);
+    }
+    void incrementUnpacked(const MicroPattern& pattern) { frequencies_.incrementUnpacked(pattern); }
+
+private:
+    using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+    // 첫 값만큼 이동한 합/제곱합 (접두사는 값이 최대 7개이므로 상쇄 오차 없이 분산 계산 가능)
+    struct PrefixSums {
+        uint64_t count = 0;
+        double shift = 0.0;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+
+        void add(double value) {
+            if (count == 0) {
+                shift = value;
+            }
+            const double shifted = value - shift;
+            count++;
+            sum += shifted;
+            sumSquares += shifted * shifted;
+        }
+
+        RunningStats toRunningStats() const {
+            RunningStats stats;
+            if (count > 0) {
+                const double n = static_cast<double>(count);
+                stats.count = count;
+                stats.mean = shift + sum / n;
+                stats.m2 = std::max(0.0, sumSquares - sum * sum / n);
+            }
+            return stats;
+        }
+    };
+
+    struct PressedKey {
+        unsigned int keyCode;
+        TimePoint timestamp;
+    };
+
+    static double toMilliseconds(TimePoint::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    PatternCounter& frequencies_;
+    PatternTimingTable& timing_;
+    const bool histograms_;
+    PatternTiming instance_;
+    PrefixSums gapSums_;
+    PrefixSums holdSums_;
+    PressedKey pressed_[PatternKey::MAX_LENGTH];
+    int pressedCount_ = 0;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "PatternKey.h"
+
+// 접두사 공유 트라이 카운터
+// 시작 위치마다 한 번만 전진하며 (노드, 다음 이벤트) -> 자식 노드로 이동하므로
+// 길이 범위가 넓어도(예: 4~16) 비용이 패턴 길이에 선형으로 증가
+class PatternTrie {
+public:
+    using NodeId = uint32_t;
+    static constexpr NodeId ROOT = 0;
+
+    PatternTrie();
+
+    // node의 자식 중 (type, keyCode) 노드를 반환 (없으면 생성)
+    NodeId child(NodeId node, EventType type, unsigned int keyCode) {
+        if ((edgeCount_ + 1) * 4 > edges_.size() * 3) {
+            growEdges();
+        }
+        Edge& edge = findEdge(node, type, keyCode);
+        if (edge.child == ROOT) {
+            edge.parent = node;
+            edge.keyCode = keyCode;
+            edge.type = type;
+            edge.child = static_cast<NodeId>(nodes_.size());
+            nodes_.push_back({node, type, keyCode, depth(node) + 1, 0});
+            edgeCount_++;
+        }
+        return edge.child;
+    }
+
+    void increment(NodeId node, int amount = 1) {
+        if (nodes_[node].count == 0) {
+            distinct_++;
+        }
+        nodes_[node].count += amount;
+        totalInstances_ += amount;
+    }
+
+    int depth(NodeId node) const { return nodes_[node].depth; }
+    int count(NodeId node) const { return nodes_[node].count; }
+    MicroPattern patternOf(NodeId node) const;
+
+    // 카운트가 있는 패턴 수 / 전체 패턴 인스턴스 수 / 트라이 노드 수
+    size_t size() const { return distinct_; }
+    bool empty() const { return distinct_ == 0; }
+    long long totalInstances() const { return totalInstances_; }
+    size_t nodeCount() const { return nodes_.size(); }
+
+    PatternFrequencyMap toFrequencyMap() const;
+    std::vector<PatternCountPair> toSortedPairs() const;
+
+private:
+    struct Node {
+        NodeId parent;
+        EventType type;
+        unsigned int keyCode;
+        int depth;
+        int count;
+    };
+    struct Edge {
+        NodeId parent = ROOT;
+        unsigned int keyCode = 0;
+        EventType type = EventType::KEY_DOWN;
+        NodeId child = ROOT; // ROOT면 빈 슬롯
+    };
+
+    static size_t edgeHash(NodeId node, EventType type, unsigned int keyCode) {
+        uint64_t h = (static_cast<uint64_t>(node) << 33) ^ (static_cast<uint64_t>(keyCode) << 1) ^
+            static_cast<uint64_t>(type == EventType::KEY_UP);
+        h *= 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+    Edge& findEdge(NodeId node, EventType type, unsigned int keyCode) {
+        size_t index = edgeHash(node, type, keyCode) & edgeMask_;
+        while (edges_[index].child != ROOT &&
+               !(edges_[index].parent == node && edges_[index].keyCode == keyCode && edges_[index].type == type)) {
+            index = (index + 1) & edgeMask_;
+        }
+        return edges_[index];
+    }
+    void growEdges();
+
+    std::vector<Node> nodes_;
+    std::vector<Edge> edges_;
+    size_t edgeMask_ = 0;
+    size_t edgeCount_ = 0;
+    size_t distinct_ = 0;
+    long long totalInstances_ = 0;
+};
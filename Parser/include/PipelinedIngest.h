@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include "PatternAnalyzer.h"
+#include "SuspiciousPatternMatcher.h"
+
+struct PipelinedIngestSummary {
+    size_t bytesRead = 0;
+    size_t chunks = 0;
+    size_t events = 0;
+    long long suspiciousMatches = 0;
+    // 읽기 버퍼 + 이벤트 블록 + 이월 문맥의 최대 용량 (입력 크기와 무관하게 일정)
+    size_t bufferBytes = 0;
+    double parseSeconds = 0.0;   // 파서 단계가 일한 시간 (큐 대기 제외)
+    double extractSeconds = 0.0; // 추출 단계가 일한 시간 (큐 대기 제외)
+    double elapsedSeconds = 0.0;
+};
+
+// 파일 / 표준 입력 / 파이프를 고정 크기 청크로 읽으며 파싱과 패턴 추출을 두 스레드에서 겹쳐 수행
+// - 파서 스레드: chunkBytes씩 읽어 완성된 줄만 이벤트 블록으로 파싱 (잘린 줄은 다음 청크 앞으로 이월)
+// - 추출 단계(호출 스레드): 제한된 큐에서 블록을 꺼내 빈도수 / 의심 패턴 수를 집계하고 블록을 파서에 반환
+//   블록 사이에는 아직 시작 위치로 쓰지 않은 마지막 maxLength - 1개(기본 7개) 이벤트만 넘기므로
+//   경계를 넘는 패턴도 로그 전체를 한 번에 읽은 경우와 같게 집계
+// - 블록은 queueDepth + 2개를 재사용하므로 메모리는 입력 크기와 무관 (빈도수 테이블만 고유 패턴 수에 비례)
+class PipelinedIngest {
+public:
+    struct Options {
+        ExtractionConfig extraction;
+        size_t chunkBytes = 1 << 20;
+        size_t queueDepth = 4; // 파서가 추출 단계보다 앞서 채워 둘 수 있는 블록 수
+    };
+
+    PipelinedIngest();
+    explicit PipelinedIngest(const Options& options);
+
+    // 의심 패턴 오토마톤 (추출 설정과 같은 간격 임계값을 사용해야 함)
+    void setSuspiciousMatcher(std::shared_ptr<const SuspiciousPatternMatcher> matcher);
+
+    // "-"면 표준 입력. 결과 빈도수는 frequencies()
+    PipelinedIngestSummary run(const std::string& filename);
+    PipelinedIngestSummary run(std::istream& input, const std::string& name);
+
+    const PatternCounter& frequencies() const { return frequencies_; }
+
+private:
+    Options options_;
+    std::shared_ptr<const SuspiciousPatternMatcher> suspiciousMatcher_;
+    PatternCounter frequencies_;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "PatternKey.h"
+
+// 빈도수 내림차순 정렬 상태를 +1/-1 갱신마다 O(log n)으로 유지하는 카운터
+// - order_: 빈도수 내림차순으로 정렬된 패턴 배열 (같은 빈도수끼리는 연속 구간)
+// - 갱신 시 같은 빈도수 구간의 경계 원소와 자리를 바꾼 뒤 값만 변경하므로 전체 재정렬 없음
+// - Fenwick 트리(순위 위치 -> 빈도수)로 상위 N개 합과 커버리지 순위를 O(log n)에 계산
+// - 키 -> 순위 위치는 개방 주소법 테이블에 위치(4바이트)만 저장하고 키는 order_에서 비교
+// - 모든 저장소는 memory가 가리키는 자원의 연속 배열 (노드 할당 없음, 해제는 배열 수만큼)
+// - 할당 실패(std::bad_alloc) 시 increment는 아무것도 바꾸지 않음 (강한 예외 보장)
+class RankedPatternCounts {
+public:
+    explicit RankedPatternCounts(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    void increment(const PatternKey& key);
+    void decrement(const PatternKey& key);
+    void clear();
+    // clear() 뒤 순위 순서대로 하나씩 넣어 정렬 상태를 그대로 복원 (스냅샷 로드용, O(log n))
+    // count가 직전 항목보다 크거나 0 이하, 또는 이미 있는 key면 false (내용은 그대로)
+    bool appendRanked(const PatternKey& key, int count);
+
+    int count(const PatternKey& key) const;
+    // key의 현재 순위 (없으면 -1)
+    int rank(const PatternKey& key) const;
+    size_t size() const { return order_.size(); }
+    long long totalInstances() const { return totalInstances_; }
+
+    // 상위 N개 패턴의 빈도수 합
+    long long topNCount(int N) const;
+    // 누적 빈도수가 targetCount 이상이 되는 최소 패턴 수 (도달 불가 시 size())
+    int patternsToReach(long long targetCount) const;
+
+    // rank(0부터)번째 패턴과 빈도수
+    const PatternKey& keyAt(size_t rank) const { return order_[rank]; }
+    int countAt(size_t rank) const { return counts_[rank]; }
+
+private:
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+    static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+    // key가 있는 칸 또는 넣을 빈 칸 (테이블이 비어 있으면 NOT_FOUND)
+    size_t findSlot(const PatternKey& key) const;
+    // 새 패턴 하나를 넣을 용량을 미리 확보 (실패해도 내용은 그대로)
+    void reserveForInsert();
+    void rebuildTable(size_t capacity);
+    void eraseSlot(size_t slot);
+    void swapPositions(size_t a, size_t b);
+    void fenwickAdd(size_t position, int delta);
+    long long fenwickPrefix(size_t length) const;
+    void ensureFenwickCapacity(size_t length);
+
+    std::pmr::vector<uint32_t> slots_; // 순위 위치 (EMPTY_SLOT이면 빈 칸)
+    size_t mask_ = 0;
+    std::pmr::vector<PatternKey> order_;
+    std::pmr::vector<int> counts_;
+    // 빈도수 c인 구간의 시작 위치와 크기
+    std::pmr::vector<uint32_t> bucketFirst_;
+    std::pmr::vector<uint32_t> bucketSize_;
+    std::pmr::vector<long long> fenwick_; // 1-based
+    long long totalInstances_ = 0;
+};
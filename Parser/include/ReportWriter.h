@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Constants.h"
+#include "PatternKey.h"
+#include "FeatureVector.h"
+
+// 배치 / 클러스터 / 튜닝 결과는 참조로만 받으므로 전방 선언 (각 헤더는 ReportWriter.cpp에서 포함)
+struct SessionResult;
+struct SessionCluster;
+struct TuningPoint;
+struct TuningCurvePoint;
+
+// 보고서 출력 계층: 재사용 버퍼에 문자열을 덧붙이고 한 번에 기록 (패턴/이벤트마다 임시 문자열을 만들지 않음)
+namespace ReportWriter {
+    // VK 코드(0~255) -> 이름. 이름이 없는 키는 "VK_<코드>" (컴파일 타임에 생성)
+    struct KeyNameTable {
+        static constexpr size_t MAX_NAME_LENGTH = 10;
+        char names[256][MAX_NAME_LENGTH] = {};
+        uint8_t lengths[256] = {};
+
+        constexpr KeyNameTable() {
+            for (unsigned int keyCode = 0; keyCode < 256; ++keyCode) {
+                char digits[3] = {};
+                int digitCount = 0;
+                unsigned int value = keyCode;
+                do {
+                    digits[digitCount++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value != 0);
+
+                names[keyCode][0] = 'V';
+                names[keyCode][1] = 'K';
+                names[keyCode][2] = '_';
+                for (int i = 0; i < digitCount; ++i) {
+                    names[keyCode][3 + i] = digits[digitCount - 1 - i];
+                }
+                lengths[keyCode] = static_cast<uint8_t>(3 + digitCount);
+            }
+
+            const struct { unsigned int keyCode; const char* name; } namedKeys[] = {
+                {VK_F1, "F1"}, {VK_F2, "F2"}, {VK_F3, "F3"}, {VK_F4, "F4"}, {VK_F5, "F5"}, {VK_F6, "F6"},
+                {VK_F7, "F7"}, {VK_F8, "F8"}, {VK_F9, "F9"}, {VK_F10, "F10"}, {VK_F11, "F11"}, {VK_F12, "F12"},
+                {VK_RETURN, "ENTER"}, {VK_ESCAPE, "ESC"}, {VK_TAB, "TAB"}, {VK_SPACE, "SPACE"},
+                {VK_BACK, "BACKSPACE"}, {VK_DELETE, "DELETE"}, {VK_CONTROL, "CTRL"}, {VK_MENU, "ALT"},
+                {VK_SHIFT, "SHIFT"}, {VK_CAPITAL, "CAPS"}, {VK_LMENU, "LALT"},
+                {VK_UP, "UP"}, {VK_DOWN, "DOWN"}, {VK_LEFT, "LEFT"}, {VK_RIGHT, "RIGHT"},
+            };
+            for (const auto& namedKey : namedKeys) {
+                setName(namedKey.keyCode, namedKey.name);
+            }
+            // 숫자 0~9 (0x30~0x39), 문자 A~Z (0x41~0x5A)
+            for (unsigned int keyCode = 0x30; keyCode <= 0x39; ++keyCode) {
+                names[keyCode][0] = static_cast<char>(keyCode);
+                lengths[keyCode] = 1;
+            }
+            for (unsigned int keyCode = 0x41; keyCode <= 0x5A; ++keyCode) {
+                names[keyCode][0] = static_cast<char>(keyCode);
+                lengths[keyCode] = 1;
+            }
+        }
+
+        constexpr void setName(unsigned int keyCode, const char* name) {
+            uint8_t length = 0;
+            while (name[length] != '\0') {
+                names[keyCode][length] = name[length];
+                length++;
+            }
+            lengths[keyCode] = length;
+        }
+
+        constexpr std::string_view operator[](unsigned int keyCode) const {
+            return std::string_view(names[keyCode], lengths[keyCode]);
+        }
+    };
+
+    inline constexpr KeyNameTable keyNames{};
+
+    void appendKeyName(std::string& out, unsigned int keyCode);
+    void appendInteger(std::string& out, long long value);
+    // std::fixed << std::setprecision(precision)과 같은 형식
+    void appendFixed(std::string& out, double value, int precision);
+    // 기본 스트림 형식 (%g, 유효숫자 6자리)과 같은 형식
+    void appendGeneral(std::string& out, double value);
+    void appendJsonString(std::string& out, std::string_view value);
+    // CSV 필드: ',' '"' 줄바꿈이 있으면 따옴표로 감싸고 '"'는 두 번 씀 (RFC 4180)
+    void appendCsvField(std::string& out, std::string_view value);
+
+    // printFrequencies 형식의 패턴 목록 (특징 벡터의 정렬 목록과 합계를 그대로 사용)
+    void appendFrequencyListing(std::string& out, const FeatureVector& features, const std::string& label);
+    // 이미 정렬된 목록 (고유 패턴 수와 전체 인스턴스 수는 호출자가 준 값을 그대로 출력)
+    void appendFrequencyListing(std::string& out, const std::vector<PatternCountPair>& sortedFrequencies,
+        size_t uniquePatterns, long long totalPatterns, const std::string& label);
+
+    // saveAnalysisResults 형식의 CSV (visualizer.py가 읽는 형식)
+    struct AnalysisMetrics {
+        double top2Concentration = 0.0;
+        double top5Concentration = 0.0;
+        int coveragePatternCount = 0;
+        double suspiciousScore = 0.0;
+        double finalScore = 0.0;
+    };
+    void appendAnalysisCsv(std::string& out, const FeatureVector& features, const AnalysisMetrics& metrics);
+    void appendAnalysisCsv(std::string& out, const std::vector<PatternCountPair>& sortedFrequencies,
+        long long totalPatterns, const AnalysisMetrics& metrics);
+
+    // 세션 클러스터 목록: CSV는 구성원 한 줄씩, JSON lines는 클러스터 한 줄씩 (members는 sessions의 인덱스)
+    void appendClusterCsv(std::string& out, const std::vector<SessionCluster>& clusters,
+        const std::vector<SessionResult>& sessions);
+    void appendClusterJsonLines(std::string& out, const std::vector<SessionCluster>& clusters,
+        const std::vector<SessionResult>& sessions);
+
+    // 튜닝 격자 결과 (한 줄에 격자 한 점)와 ROC / PR 곡선
+    void appendTuningCsv(std::string& out, const std::vector<TuningPoint>& points);
+    void appendTuningCurveCsv(std::string& out, const std::vector<TuningCurvePoint>& curve);
+
+    void writeFile(const std::string& filename, const std::string& contents);
+}
+
+// 다수 세션 결과를 하나의 파일에 스트리밍 기록 (CSV 또는 JSON lines)
+// - 결과를 버퍼에 덧붙이고 일정 크기마다 기록하므로 세션당 시스템 호출이 없음
+// - append 모드면 기존 파일 뒤에 이어 쓰고, CSV 헤더는 빈 파일일 때만 기록
+// - 여러 스레드에서 write() 호출 가능
+class FleetReportWriter {
+public:
+    enum class Format {
+        CSV,
+        JSON_LINES
+    };
+
+    struct Options {
+        Format format = Format::CSV;
+        bool append = false;
+        bool sketchColumns = false; // 스케치 모드 오차 범위 열 포함
+        size_t flushBytes = 1 << 20;
+    };
+
+    FleetReportWriter(const std::string& filename, const Options& options);
+    ~FleetReportWriter();
+
+    FleetReportWriter(const FleetReportWriter&) = delete;
+    FleetReportWriter& operator=(const FleetReportWriter&) = delete;
+
+    // 확장자가 .jsonl / .ndjson이면 JSON lines, 아니면 CSV
+    static Format formatFor(const std::string& filename);
+
+    void write(const SessionResult& result);
+    void flush();
+    size_t sessionsWritten() const { return sessionsWritten_; }
+
+private:
+    void appendCsv(const SessionResult& result);
+    void appendJsonLine(const SessionResult& result);
+    void flushLocked();
+
+    Options options_;
+    std::string filename_;
+    std::ofstream file_;
+    std::mutex mutex_;
+    std::string buffer_;
+    size_t sessionsWritten_ = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// 세션 상태용 슬랩 풀: 고정 크기 슬랩을 큰 청크에서 잘라 주고, 돌려받은 슬랩은 자유 목록으로 재사용
+// - 세션이 끝나도 운영체제에 반환하지 않으므로 세션 생성/해제가 반복되어도 힙이 조각나지 않음
+// - 스레드 안전하지 않음 (탐지 데몬 워커마다 하나)
+class SlabPool {
+public:
+    static constexpr size_t SLAB_SIZE = 2048;
+
+    explicit SlabPool(size_t slabsPerChunk = 512);
+    ~SlabPool();
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void* acquire();
+    // first부터 next 포인터로 이어진 count개의 슬랩(마지막은 last)을 한 번에 반환 (O(1))
+    void releaseChain(void* first, void* last, size_t count);
+
+    // 세션 아레나가 슬랩 대신 상위 자원에서 직접 받은 큰 블록 (통계용)
+    void addLargeBytes(size_t bytes) { largeBytes_ += bytes; }
+    void removeLargeBytes(size_t bytes) { largeBytes_ -= bytes; }
+
+    size_t slabsInUse() const { return slabsInUse_; }
+    // 세션들이 현재 점유 중인 바이트 (사용 중인 슬랩 + 큰 블록)
+    size_t bytesInUse() const { return slabsInUse_ * SLAB_SIZE + largeBytes_; }
+    // 운영체제에서 받은 바이트 (청크 + 큰 블록)
+    size_t bytesReserved() const { return chunks_.size() * slabsPerChunk_ * SLAB_SIZE + largeBytes_; }
+
+private:
+    struct FreeSlab {
+        FreeSlab* next;
+    };
+
+    size_t slabsPerChunk_;
+    std::vector<void*> chunks_;
+    FreeSlab* free_ = nullptr;
+    size_t slabsInUse_ = 0;
+    size_t largeBytes_ = 0;
+};
+
+// 세션 하나의 메모리 자원 (std::pmr 컨테이너에 전달)
+// - 작은 블록(256바이트 이하)은 슬랩 안에서 포인터 증가로 할당하고, 해제된 블록은 크기 등급별 자유 목록으로 재사용
+//   (2의 거듭제곱과 그 1.5배 -> 반올림 낭비 33% 이하)
+// - 큰 블록(윈도우 링 버퍼, 패턴 배열)은 상위 자원(new/delete)에서 직접 할당
+//   배열이 커지며 남기는 이전 블록이 세션 안의 자유 목록에 묶이지 않고 다른 세션에서 재사용되도록
+//   (작은 블록 상한을 2KB로 두면 세션당 슬랩 점유가 약 2배)
+// - 예산(budgetBytes)을 넘게 되는 슬랩/큰 블록 요청은 std::bad_alloc (분석기가 받아 정해진 방식으로 축소)
+// - release()는 슬랩 목록을 풀에 통째로 돌려주므로 세션 크기와 무관하게 O(1)
+//   (큰 블록은 컨테이너마다 하나 정도라 개별 해제)
+class SessionArena : public std::pmr::memory_resource {
+public:
+    explicit SessionArena(SlabPool& pool, size_t budgetBytes = 0);
+    ~SessionArena() override;
+
+    SessionArena(const SessionArena&) = delete;
+    SessionArena& operator=(const SessionArena&) = delete;
+
+    // 모든 블록을 한 번에 해제 (이후 이 자원에서 받은 포인터는 사용할 수 없음)
+    void release();
+
+    size_t budgetBytes() const { return budgetBytes_; }
+    // 이 세션이 점유 중인 바이트 (슬랩 + 큰 블록)
+    size_t bytesInUse() const { return slabCount_ * SlabPool::SLAB_SIZE + largeBytes_; }
+    // 현재 살아 있는 블록의 요청 크기 합
+    size_t bytesAllocated() const { return bytesAllocated_; }
+
+private:
+    static constexpr size_t MIN_BLOCK = 16;
+    static constexpr size_t MAX_SMALL_BLOCK = 256;
+    static constexpr size_t SIZE_CLASSES = 8; // 16, 32, 48, 64, 96, 128, 192, 256
+    // 슬랩 앞부분: 같은 세션의 슬랩을 잇는 포인터 (MIN_BLOCK 정렬 유지)
+    static constexpr size_t SLAB_HEADER = MIN_BLOCK;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    struct LargeBlock {
+        void* pointer;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    static size_t sizeClass(size_t bytes);
+    static size_t classBytes(size_t index);
+    void checkBudget(size_t additionalBytes) const;
+    void* allocateLarge(size_t bytes, size_t alignment);
+    void deallocateLarge(void* pointer);
+
+    SlabPool& pool_;
+    size_t budgetBytes_;
+    std::array<FreeBlock*, SIZE_CLASSES> free_ = {};
+    void* firstSlab_ = nullptr;
+    void* lastSlab_ = nullptr;
+    size_t slabCount_ = 0;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+    std::vector<LargeBlock> large_;
+    size_t largeBytes_ = 0;
+    size_t bytesAllocated_ = 0;
+};
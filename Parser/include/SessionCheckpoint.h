@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "StreamingPatternAnalyzer.h"
+
+// 세션별 StreamingPatternAnalyzer 스냅샷 묶음 파일 (.kmck, 버전 1). 탐지 데몬이 주기적으로 쓰고 재시작 시 읽음
+// 복원 시간은 로그 길이가 아니라 스냅샷 크기(세션별 고유 패턴 수 + 윈도우 인스턴스 수)에 비례
+//
+// 파일 헤더 (120바이트, 리틀 엔디언)
+//   char[4] magic = "KMCK" | u16 version | u16 headerSize | u32 recordsCrc32 | u32 reserved
+//   u64 sessionCount | u64 recordsBytes | i64 windowMs
+//   i64 timeThresholdMs | u8 minLength | u8 maxLength | u8[6] reserved
+//   u64[4] startKeys | u64[4] coreKeys (KeySet 비트맵)
+// 레코드 (sessionCount개)
+//   u64 sessionId | u32 stateBytes | StreamingPatternAnalyzer::saveState 스냅샷
+namespace SessionCheckpoint {
+    constexpr char MAGIC[4] = {'K', 'M', 'C', 'K'};
+    constexpr uint16_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = 120;
+    constexpr size_t RECORD_HEADER_SIZE = 12;
+
+    // 세션 하나의 레코드를 out 뒤에 덧붙임
+    void appendRecord(std::string& out, uint64_t sessionId, const StreamingPatternAnalyzer& analyzer);
+
+    // 레코드 묶음(워커별 등)을 이어 붙여 기록. 임시 파일에 쓴 뒤 교체하므로 중간에 실패해도 이전 체크포인트는 유지
+    // 기록한 바이트 수를 돌려줌
+    size_t write(const std::string& filename, const StreamingPatternAnalyzer::Options& options,
+        const std::vector<std::string>& records, uint64_t sessionCount);
+
+    // 헤더 / CRC / 추출 설정을 검사한 뒤 레코드마다 callback(sessionId, state, stateBytes)
+    // 파일이 없으면 0, 손상되었거나 설정이 다르면 std::runtime_error. 읽은 세션 수를 돌려줌
+    size_t read(const std::string& filename, const StreamingPatternAnalyzer::Options& options,
+        const std::function<void(uint64_t sessionId, const uint8_t* state, size_t stateBytes)>& callback);
+}
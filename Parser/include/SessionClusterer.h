@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SessionSignature.h"
+
+// 같은 스크립트를 돌리는 것으로 보이는 세션 묶음
+struct SessionCluster {
+    // 입력 인덱스. 첫 원소가 대표, 나머지는 대표와의 유사도 내림차순
+    std::vector<size_t> members;
+    // members와 같은 순서의 대표와의 추정 유사도 (대표는 1)
+    std::vector<double> similarities;
+    double meanSimilarity = 0.0; // 대표를 뺀 구성원의 평균
+};
+
+// 세션 서명 LSH 밴딩으로 거의 같은 분포의 세션을 묶음 (모든 쌍을 비교하지 않음)
+// - 서명을 bands개의 구간(행 hashCount / bands개)으로 나누고, 구간 해시가 같은 세션끼리 후보
+//   유사도 s인 두 세션이 후보가 될 확률 1 - (1 - s^rows)^bands
+// - 밴드마다 (구간 해시, 인덱스)를 정렬하여 같은 해시 구간의 세션을 첫 세션과만 비교 (구간 크기에 선형)
+//   추정 유사도가 similarityThreshold 이상이면 union-find로 합침
+// - 시간 O(bands * N log N + bands * N * hashCount), 메모리는 서명 외에 O(N)
+class SessionClusterer {
+public:
+    struct Options {
+        size_t bands = 32;
+        double similarityThreshold = 0.7;
+        size_t minClusterSize = 3;
+    };
+
+    SessionClusterer();
+    explicit SessionClusterer(const Options& options);
+
+    // 빈 서명은 건너뜀. 모든 서명은 같은 hashCount여야 하고 hashCount는 bands로 나누어떨어져야 함
+    // 결과는 크기 내림차순
+    std::vector<SessionCluster> cluster(const std::vector<const SessionSignature*>& signatures) const;
+
+private:
+    Options options_;
+};
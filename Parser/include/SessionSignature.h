@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "PatternCounter.h"
+#include "SpaceSavingSketch.h"
+
+// 세션 패턴 빈도 분포의 가중 MinHash 서명 (Ioffe ICWS, 칸마다 선택된 원소와 양자화 단계를 32비트로 해시)
+// - 빈도수를 전체 인스턴스 수로 나눈 분포 p, q에 대해 두 서명의 같은 칸 비율은
+//   가중 자카드 유사도 sum(min(p, q)) / sum(max(p, q))의 추정값 (표준 오차 약 0.5 / sqrt(hashCount))
+// - 세션 길이와 무관하게 hashCount * 4바이트
+// - 같은 hashCount와 seed로 만든 서명끼리만 비교 가능
+class SessionSignature {
+public:
+    static constexpr size_t DEFAULT_HASHES = 128;
+
+    SessionSignature() = default;
+
+    // (원소 ID, 가중치 > 0) 목록으로 생성. 가중치 합으로 정규화하므로 빈도수를 그대로 넘겨도 됨
+    static SessionSignature fromWeights(const std::vector<std::pair<uint64_t, double>>& weights,
+        size_t hashCount = DEFAULT_HASHES, uint64_t seed = 0);
+    static SessionSignature fromCounter(const PatternCounter& frequencies,
+        size_t hashCount = DEFAULT_HASHES, uint64_t seed = 0);
+    // 스케치 모드: 추적 중인 카운터의 빈도수 추정값 사용
+    static SessionSignature fromSketch(const SpaceSavingSketch& sketch,
+        size_t hashCount = DEFAULT_HASHES, uint64_t seed = 0);
+
+    // 패턴이 하나도 없는 세션은 빈 서명 (누구와도 유사도 0)
+    bool empty() const { return values_.empty(); }
+    size_t size() const { return values_.size(); }
+    const std::vector<uint32_t>& values() const { return values_; }
+
+    // 추정 가중 자카드 유사도 [0, 1]
+    double similarity(const SessionSignature& other) const;
+
+private:
+    std::vector<uint32_t> values_;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "PatternKey.h"
+
+// 근사값과 오차 범위: 실제 값은 [lower, upper] 안에 있음
+// (빈도수와 상위 N개 점유율의 value는 upper, 커버리지 패턴 수의 value는 lower와 같음)
+struct SketchEstimate {
+    double value = 0.0;
+    double lower = 0.0;
+    double upper = 0.0;
+};
+
+// Space-Saving 헤비 히터 스케치 (고정 용량, 세션당 메모리 상한)
+// - 추적 중인 패턴 p: count - error <= 실제 빈도수 <= count
+// - 추적되지 않은 패턴: 실제 빈도수 <= minCount() <= totalInstances / capacity
+class SpaceSavingSketch {
+public:
+    struct Counter {
+        PatternKey key;
+        long long count;
+        long long error;
+    };
+
+    explicit SpaceSavingSketch(size_t capacity);
+
+    void increment(const PatternKey& key);
+    // 압축할 수 없는 패턴 (VK > 0xFF): 전체 수에만 포함하고 추적하지 않음
+    void incrementUnpacked(const MicroPattern&) { totalInstances_++; untrackedInstances_++; }
+
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return counters_.size(); }
+    long long totalInstances() const { return totalInstances_; }
+    // 추적되지 않은 패턴의 최대 가능 빈도수
+    long long minCount() const;
+    bool isExact() const { return evictions_ == 0 && untrackedInstances_ == 0; }
+
+    // 추적 중인 카운터 (순서 없음)
+    const std::vector<Counter>& counters() const { return counters_; }
+    // 빈도수 내림차순으로 정렬된 카운터
+    std::vector<Counter> sortedCounters() const;
+    SketchEstimate count(const PatternKey& key) const;
+
+    // 상위 N개 점유율(%)과 coveragePercentage 커버리지에 필요한 패턴 수 (오차 범위 포함)
+    // 압축 불가 패턴 인스턴스도 목표에 포함하며, 범위는 그 분포를 모르는 만큼 넓어짐 (값은 항상 1 이상)
+    SketchEstimate topNConcentration(int N) const;
+    SketchEstimate coveragePatternCount(double coveragePercentage) const;
+
+private:
+    void siftDown(size_t heapIndex);
+    void swapHeap(size_t a, size_t b);
+
+    size_t capacity_;
+    std::vector<Counter> counters_;
+    std::vector<size_t> heap_;          // counters_ 인덱스의 최소 힙 (count 기준)
+    std::vector<size_t> heapPosition_;  // counters_ 인덱스 -> heap_ 위치
+    std::unordered_map<PatternKey, size_t, PatternKeyHash> index_;
+    long long totalInstances_ = 0;
+    long long untrackedInstances_ = 0;
+    long long evictions_ = 0;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+#include "PatternAnalyzer.h"
+#include "ExtractionKernel.h"
+#include "RankedPatternCounts.h"
+#include "SuspiciousPatternMatcher.h"
+
+// 이벤트를 하나씩 받아 최근 windowMs 동안의 패턴 빈도수와 탐지 특징을 실시간으로 유지
+// - 완성 대기 중인 패턴은 최대 maxLength개의 접두사만 보관
+// - 빈도수/순위는 RankedPatternCounts로 증분 갱신 (전체 재정렬 없음)
+// - 메모리는 윈도우 안의 패턴 인스턴스 수에만 비례 (세션 길이와 무관)
+// - 의심 패턴 여부는 이벤트마다 한 번 전진하는 Aho-Corasick 상태로 판정 (패턴 집합 조회 없음)
+// - 윈도우와 빈도수 저장소는 memory 자원의 연속 배열 몇 개뿐 (세션별 SessionArena 사용 가능)
+// 메모리 자원이 할당을 거부하면 (std::bad_alloc, 예: SessionArena 예산 초과) 축소 모드로 전환
+// - 윈도우 배열을 더 늘리지 않고, 가득 차면 가장 오래된 인스턴스를 windowMs 전에 만료 (윈도우가 짧아짐)
+// - 새 패턴을 넣을 공간이 없으면 가장 오래된 인스턴스부터 1/8씩 만료하며 재시도
+// - 윈도우가 비어도 공간이 없으면 그 인스턴스는 집계하지 않음 (droppedInstances)
+// VK > 0xFF가 포함된 패턴은 압축 키로 표현할 수 없으므로 집계하지 않음
+class StreamingPatternAnalyzer {
+public:
+    struct Options {
+        ExtractionConfig extraction;
+        long long windowMs = 10 * 60 * 1000; // 0 이하면 윈도우 없이 누적
+    };
+
+    StreamingPatternAnalyzer();
+    explicit StreamingPatternAnalyzer(const Options& options,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    void setSuspiciousPatterns(const std::set<MicroPattern>& suspiciousPatterns);
+    // 여러 세션이 하나의 컴파일된 매처를 공유 (같은 ExtractionConfig로 만든 매처여야 함)
+    void setSuspiciousMatcher(std::shared_ptr<const SuspiciousPatternMatcher> matcher);
+
+    void addEvent(const InputEvent& event);
+    void reset();
+
+    // 현재 상태를 이진 스냅샷으로 out 뒤에 덧붙임 (체크포인트용)
+    // 대기 중인 접두사, 마지막 타임스탬프, 순위 순서 그대로의 빈도수, 윈도우 인스턴스(순위 번호 + 시간차 varint)를 담으므로
+    // 크기는 고유 패턴 수와 윈도우 인스턴스 수에 비례 (지금까지 받은 이벤트 수와 무관)
+    void saveState(std::string& out) const;
+    // 같은 Options로 만든 분석기에 스냅샷을 복원. 이후 addEvent 결과는 끊김 없이 이어서 받은 경우와 같음
+    // 매처는 직접 설정 (설정되어 있으면 최근 이벤트로 매칭 상태를 다시 계산)
+    // 손상되었거나 Options가 다른 스냅샷이면 std::runtime_error, 메모리 자원이 거부하면 std::bad_alloc (둘 다 reset 상태)
+    void loadState(const uint8_t* data, size_t size);
+
+    // 윈도우 기준 특징 (모두 O(log n) 이하)
+    long long totalInstances() const { return counts_.totalInstances(); }
+    size_t distinctPatterns() const { return counts_.size(); }
+    double topNConcentration(int N) const;
+    int coveragePatternCount(double coveragePercentage) const;
+    double suspiciousScore() const;
+    double botSuspicionScore() const;
+    bool isBotSuspected() const;
+
+    std::vector<PatternCountPair> topPatterns(int N) const;
+    long long eventsProcessed() const { return eventsProcessed_; }
+    size_t windowInstances() const { return windowSize_; }
+
+    // 메모리 한도로 축소 모드에 들어갔는지와 그로 인해 달라진 인스턴스 수
+    bool isDegraded() const { return degraded_; }
+    long long earlyExpiredInstances() const { return earlyExpiredInstances_; }
+    long long droppedInstances() const { return droppedInstances_; }
+
+private:
+    struct PendingPattern {
+        PatternKey key;
+        bool packable;
+        bool containsCoreKey;
+    };
+    // 24바이트 (의심 여부를 타임스탬프의 남는 비트에 저장)
+    struct Instance {
+        PatternKey key;
+        long long timestampMs : 63;
+        unsigned long long suspicious : 1;
+    };
+    struct RecentEvent {
+        EventType type;
+        unsigned int keyCode;
+    };
+
+    void countPattern(const PatternKey& key, long long timestampMs, bool suspicious);
+    // 최근 이벤트로 매칭 상태 복원
+    void restoreMatchState();
+    void readState(const uint8_t* data, size_t size);
+    void expire(long long nowMs);
+    // 윈도우에 인스턴스 하나를 넣을 칸 확보 (실패 시 false)
+    bool reserveWindowSlot();
+    void growWindow();
+    void popOldest();
+    void expireOldest(size_t count);
+    size_t windowIndex(size_t offset) const {
+        const size_t index = windowHead_ + offset;
+        return index < window_.size() ? index : index - window_.size();
+    }
+
+    Options options_;
+    // 배치 추출과 같은 간격 판정 (밀리초로 자르지 않은 타임스탬프 차이)
+    ExtractionKernel::GapLimit gapLimit_;
+    std::array<PendingPattern, PatternKey::MAX_LENGTH> pending_;
+    size_t pendingCount_ = 0;
+    bool hasLastEvent_ = false;
+    InputEvent lastEvent_ = {};
+    long long eventsProcessed_ = 0;
+
+    RankedPatternCounts counts_;
+    // 윈도우 링 버퍼 (오래된 것부터 windowHead_에서 windowSize_개, 가득 차면 1.5배로 늘림)
+    std::pmr::vector<Instance> window_;
+    size_t windowHead_ = 0;
+    size_t windowSize_ = 0;
+    bool windowCapped_ = false;
+    bool degraded_ = false;
+    long long earlyExpiredInstances_ = 0;
+    long long droppedInstances_ = 0;
+    std::shared_ptr<const SuspiciousPatternMatcher> matcher_;
+    SuspiciousPatternMatcher::NodeId matchState_ = SuspiciousPatternMatcher::ROOT;
+    // 마지막 끊김 이후 최근 maxLength개 이벤트 (매처 교체 시 상태 복원용)
+    std::array<RecentEvent, PatternKey::MAX_LENGTH> recent_;
+    size_t recentCount_ = 0;
+    long long suspiciousCount_ = 0;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "PatternAnalyzer.h"
+
+// 의심 패턴 집합을 (타입, VK) 알파벳 위의 Aho-Corasick 오토마톤으로 컴파일하여
+// 이벤트 스트림을 한 번 지나가며 의심 패턴 인스턴스를 직접 집계 (빈도수 맵 불필요)
+// - 추출 규칙상 집계될 수 없는 패턴(시작 키 KEY_DOWN으로 시작하지 않음, 길이 범위 밖, 핵심 키 없음)은 제외
+// - 노드마다 "이 위치에서 끝나는 의심 패턴 길이" 비트마스크를 미리 계산하므로 이벤트당 비용은 상수
+// - 간격이 임계값을 넘으면 상태를 루트로 되돌림 (끊긴 창을 넘는 일치는 생기지 않음)
+// 불변 객체이므로 여러 세션/스레드가 하나를 공유할 수 있음
+class SuspiciousPatternMatcher {
+public:
+    using NodeId = uint32_t;
+    static constexpr NodeId ROOT = 0;
+    static constexpr int MAX_PATTERN_LENGTH = 64;
+
+    SuspiciousPatternMatcher();
+    SuspiciousPatternMatcher(const std::set<MicroPattern>& patterns, const ExtractionConfig& config = ExtractionConfig());
+
+    // 다음 상태 (실패 링크를 따라 이동, 분할 상환 O(1))
+    NodeId next(NodeId state, EventType type, unsigned int keyCode) const;
+    // bit (L - 1): 현재 위치에서 끝나는 길이 L의 접미사가 의심 패턴
+    uint64_t matchedLengths(NodeId state) const { return outputs_[state]; }
+    int matchCount(NodeId state) const;
+
+    bool contains(const MicroPattern& pattern) const;
+    bool contains(const PatternKey& key) const;
+
+    // 이벤트 전체를 훑어 의심 패턴 인스턴스 수를 계산 (calculateSuspiciousPatternScore의 분자와 동일)
+    long long countMatches(const std::vector<InputEvent>& events) const;
+
+    const ExtractionConfig& config() const { return config_; }
+    size_t patternCount() const { return patternCount_; }
+    size_t skippedPatterns() const { return skippedPatterns_; }
+    size_t nodeCount() const { return fail_.size(); }
+    bool empty() const { return patternCount_ == 0; }
+
+private:
+    struct Edge {
+        uint64_t key = 0; // (parent << 32) | symbol, 0이면 빈 슬롯 (루트 외 노드는 부모가 있으므로 key != 0)
+        NodeId child = ROOT;
+    };
+
+    static uint32_t symbolOf(EventType type, unsigned int keyCode) {
+        return (keyCode << 1) | static_cast<uint32_t>(type == EventType::KEY_UP);
+    }
+    static uint64_t edgeKey(NodeId parent, uint32_t symbol) {
+        return (static_cast<uint64_t>(parent) << 32) | symbol;
+    }
+
+    bool accepts(const MicroPattern& pattern) const;
+    NodeId findChild(NodeId node, uint32_t symbol) const;
+    NodeId addChild(NodeId node, uint32_t symbol);
+    void insertEdge(uint64_t key, NodeId child);
+    void buildFailureLinks(const std::vector<std::vector<std::pair<uint32_t, NodeId>>>& children);
+
+    ExtractionConfig config_;
+    size_t patternCount_ = 0;
+    size_t skippedPatterns_ = 0;
+
+    // 루트 전이는 VK <= 0xFF에 대해 직접 인덱싱, 나머지 간선은 개방 주소법 해시
+    std::vector<NodeId> rootTransitions_;
+    std::vector<Edge> edges_;
+    size_t edgeMask_ = 0;
+    size_t edgeCount_ = 0;
+
+    std::vector<NodeId> fail_;
+    std::vector<uint64_t> outputs_;
+};
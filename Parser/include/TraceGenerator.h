@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include "InputEvent.h"
+
+// 벤치마크/튜닝용 합성 입력 로그 생성기 (기존 CSV 형식과 동일)
+// - BOT: README의 더블 점프 랜덤화 봇. press(alt) press(alt) press(공격키)를 반복하되
+//        각 press의 key_down/key_up 순서와 공격키를 균등하게 섞어 패턴 분포가 평탄함
+// - HUMAN: 선호하는 공격키/입력 순서가 뚜렷하고(상위 패턴 집중), 간격에 지터와 휴식이 있음
+class TraceGenerator {
+public:
+    enum class Profile {
+        BOT,
+        HUMAN
+    };
+
+    struct Options {
+        Profile profile = Profile::HUMAN;
+        uint64_t seed = 1;
+        long long startTimestampMs = 1712345678000LL;
+    };
+
+    explicit TraceGenerator(const Options& options);
+
+    // count개의 이벤트를 이어서 생성 (호출을 나눠도 하나의 연속된 트레이스)
+    void generate(size_t count, std::vector<InputEvent>& events);
+    std::vector<InputEvent> generate(size_t count);
+
+    // count개의 이벤트를 CSV 로그로 저장 (고정 크기 버퍼로 나눠 생성하므로 크기 제한 없음)
+    void writeCsv(const std::string& filename, size_t count);
+
+    static bool parseProfile(const std::string& name, Profile& profile);
+
+private:
+    struct PendingEvent {
+        long long delayMs;
+        EventType type;
+        unsigned int keyCode;
+    };
+
+    void queueBotAction();
+    void queueHumanAction();
+    void queuePress(unsigned int keyCode, bool keyUpFirst, long long holdMs);
+    long long humanDelay(double meanMs, double jitterMs);
+
+    Options options_;
+    std::mt19937_64 random_;
+    long long timestampMs_;
+    std::deque<PendingEvent> pending_;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "PatternAnalyzer.h"
+
+// 라벨이 붙은 세션 로그 하나
+struct LabeledSession {
+    std::string filename;
+    bool bot = false;
+};
+
+// 튜닝 격자: 추출 설정(길이 범위 x 간격 임계값) x 점수 설정의 모든 조합을 평가
+struct TuningGrid {
+    std::vector<std::pair<int, int>> lengthRanges = {{6, 8}, {5, 8}, {6, 7}};
+    std::vector<long long> gapThresholdsMs = {150, 200, 250, 300, 350, 400};
+    std::vector<double> top5ConcentrationLow = {35.0, 45.0, 55.0};
+    std::vector<double> coverageHigh = {8.0, 12.0, 16.0};
+    std::vector<double> suspiciousHigh = {4.0, 8.0, 12.0};
+    // 의심 패턴 가중치는 1 - 집중도 - 평탄도 (합이 1을 넘는 조합은 제외)
+    std::vector<double> weightConcentration = {0.3, 0.4, 0.5, 0.6, 0.7};
+    std::vector<double> weightFlatness = {0.2, 0.3, 0.4, 0.5, 0.6};
+    std::vector<double> decisionThresholds = {0.5, 0.6, 0.7};
+
+    // 한 줄에 "이름 값 값 ..." ('#' 주석), 길이 범위는 "6-8". 파일에 없는 항목은 기본값 유지
+    static TuningGrid load(const std::string& filename);
+
+    size_t extractionCount() const { return lengthRanges.size() * gapThresholdsMs.size(); }
+    std::vector<ScoringParams> scoringParams() const;
+};
+
+// 격자 한 점의 평가 결과
+struct TuningPoint {
+    ExtractionConfig extraction;
+    ScoringParams scoring;
+    double auc = 0.0; // ROC 곡선 아래 면적 (점수 순위 기준, 결정 임계값과 무관)
+    double averagePrecision = 0.0;
+    // decisionThreshold에서의 판정
+    double truePositiveRate = 0.0;
+    double falsePositiveRate = 0.0;
+    double precision = 0.0;
+    double f1 = 0.0;
+};
+
+// ROC / 정밀도-재현율 곡선의 한 점 (score >= threshold를 봇으로 판정)
+struct TuningCurvePoint {
+    double threshold = 0.0;
+    double truePositiveRate = 0.0;
+    double falsePositiveRate = 0.0;
+    double precision = 0.0;
+};
+
+struct TuningSummary {
+    size_t humanSessions = 0;
+    size_t botSessions = 0;
+    size_t failedFiles = 0;
+    long long events = 0;
+    double extractionSeconds = 0.0;
+    double scoringSeconds = 0.0;
+};
+
+// 라벨이 붙은 코퍼스로 추출/점수 파라미터를 격자 탐색하여 ROC / PR을 보고
+// - 로그는 한 번만 파싱하고, 길이 범위마다 (패턴 키, 패턴 내부 최대 간격) 후보를 한 번 만든 뒤
+//   최대 간격 순으로 정렬하여 간격 임계값을 오름차순으로 훑으며 RankedPatternCounts에 누적
+//   (임계값마다 다시 추출하지 않음, 임계값 T의 빈도수 = 최대 간격이 T 이하인 후보)
+// - 세션 특징(집중도, 커버리지, 의심 패턴 %)은 추출 설정마다 캐시하고 점수 격자는 특징만으로 평가
+// - 압축 키로 표현할 수 없는 패턴(VK > 0xFF)은 스트리밍 분석기와 같이 제외
+class TuningEngine {
+public:
+    struct Options {
+        size_t threadCount = 0; // 0이면 코어 수
+        TuningGrid grid;
+    };
+
+    explicit TuningEngine(const Options& options);
+
+    // 디렉터리면 human/, bot/ 하위 디렉터리의 로그, 아니면 한 줄에 "human <경로>" / "bot <경로>"인 매니페스트
+    static std::vector<LabeledSession> loadCorpus(const std::string& path);
+
+    // 사람 기준 로그: 추출 설정마다 빈도수 2 이하인 패턴을 의심 패턴으로 사용 (main의 규칙과 동일)
+    void setBaselineEvents(const std::vector<InputEvent>& events);
+
+    TuningSummary run(const std::vector<LabeledSession>& sessions);
+
+    // run() 결과: 격자 순서 (추출 설정 -> 점수 설정)
+    const std::vector<TuningPoint>& points() const { return points_; }
+    // AUC가 가장 높은 점 (같으면 F1이 높은 점)
+    const TuningPoint* best() const;
+    // 주어진 점의 ROC / PR 곡선 (세션 점수 내림차순, 서로 다른 점수마다 한 점)
+    std::vector<TuningCurvePoint> curve(const TuningPoint& point) const;
+
+private:
+    struct SessionFeatures {
+        double top2Concentration = 0.0;
+        double top5Concentration = 0.0;
+        int coveragePatternCount = 0;
+        double suspiciousScore = 0.0;
+    };
+
+    size_t extractionIndex(const ExtractionConfig& config) const;
+    ExtractionConfig extractionAt(size_t index) const;
+    std::vector<double> scoreSessions(size_t extraction, const ScoringParams& params) const;
+
+    Options options_;
+    std::vector<long long> gapThresholdsMs_; // 오름차순
+    // 추출 설정별 의심 패턴 (기준 로그에서 빈도수 2 이하)
+    std::vector<std::unordered_set<PatternKey, PatternKeyHash>> suspiciousKeys_;
+    std::vector<bool> labels_;
+    // features_[추출 설정][세션]
+    std::vector<std::vector<SessionFeatures>> features_;
+    std::vector<TuningPoint> points_;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 워커별 작업 큐 + 작업 훔치기 스레드 풀
+// - 워커는 자기 큐의 앞에서 꺼내고, 비면 다른 워커 큐의 뒤에서 훔침
+// - 큰 작업을 앞쪽에 넣으면 주인 워커는 큰 작업을, 놀고 있는 워커는 작은 작업을 가져감
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // worker 큐 뒤에 추가 (worker 생략 시 라운드 로빈)
+    void submit(Task task);
+    void submit(size_t worker, Task task);
+
+    // 제출된 작업이 모두 끝날 때까지 대기
+    void wait();
+
+    size_t threadCount() const { return queues_.size(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<size_t> pending_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::mutex wakeMutex_;
+    size_t generation_ = 0; // wakeMutex_로 보호
+    std::condition_variable wakeCondition_;
+    std::condition_variable idleCondition_;
+};
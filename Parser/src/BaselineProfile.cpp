@@ -0,0 +1,294 @@
+#include "../include/BaselineProfile.h"
+#include "../include/BinaryEventLog.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+using BinaryEventLog::loadLE;
+using BinaryEventLog::storeLE;
+
+namespace {
+    bool keyLess(const PatternKey& a, const PatternKey& b) {
+        return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo;
+    }
+
+    uint64_t doubleBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    double bitsDouble(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    bool sameConfig(const ExtractionConfig& a, const ExtractionConfig& b) {
+        return a.minLength == b.minLength && a.maxLength == b.maxLength &&
+            a.timeThresholdMs == b.timeThresholdMs && a.startKeys == b.startKeys && a.coreKeys == b.coreKeys;
+    }
+
+    // PatternAnalyzer의 상위 N 집중도 / 50% 커버리지와 같은 규칙
+    void computeDistributionStats(std::vector<uint64_t> counts, BaselineProfile::Stats& stats) {
+        std::sort(counts.begin(), counts.end(), std::greater<uint64_t>());
+        stats.distinctPatterns = counts.size();
+        stats.top2Concentration = 0.0;
+        stats.top5Concentration = 0.0;
+        stats.coveragePatternCount = 0;
+        if (stats.totalInstances == 0) {
+            return;
+        }
+
+        auto topNConcentration = [&](size_t N) {
+            const uint64_t topSum = std::accumulate(counts.begin(), counts.begin() + std::min(N, counts.size()), uint64_t(0));
+            return (static_cast<double>(topSum) / stats.totalInstances) * 100.0;
+        };
+        stats.top2Concentration = topNConcentration(2);
+        stats.top5Concentration = topNConcentration(5);
+
+        const uint64_t targetCount = static_cast<uint64_t>(stats.totalInstances * 0.5);
+        if (targetCount == 0) {
+            stats.coveragePatternCount = 1;
+            return;
+        }
+        uint64_t currentCount = 0;
+        for (uint64_t count : counts) {
+            currentCount += count;
+            stats.coveragePatternCount++;
+            if (currentCount >= targetCount) {
+                break;
+            }
+        }
+    }
+}
+
+bool BaselineProfile::isProfileFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[4] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+BaselineProfile BaselineProfile::open(const std::string& filename) {
+    BaselineProfile profile;
+    profile.file_.reset(new MappedFile(filename));
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(profile.file_->data());
+    const size_t size = profile.file_->size();
+
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Error: Not a baseline profile " + filename);
+    }
+    const uint16_t version = loadLE<uint16_t>(data + 4);
+    const uint16_t headerSize = loadLE<uint16_t>(data + 6);
+    const uint32_t entrySize = loadLE<uint32_t>(data + 8);
+    if (version != VERSION || headerSize < HEADER_SIZE || entrySize != ENTRY_SIZE) {
+        throw std::runtime_error("Error: Unsupported baseline profile version in " + filename);
+    }
+
+    Stats& stats = profile.stats_;
+    stats.distinctPatterns = loadLE<uint64_t>(data + 16);
+    stats.sessions = loadLE<uint64_t>(data + 24);
+    stats.events = loadLE<uint64_t>(data + 32);
+    stats.totalInstances = loadLE<uint64_t>(data + 40);
+    stats.top2Concentration = bitsDouble(loadLE<uint64_t>(data + 48));
+    stats.top5Concentration = bitsDouble(loadLE<uint64_t>(data + 56));
+    stats.coveragePatternCount = loadLE<uint32_t>(data + 64);
+    // 헤더 크기는 파일에서 읽은 값이므로 빼기 전에 범위를 확인 (항목 영역 = size - headerSize)
+    if (headerSize > size || (size - headerSize) / ENTRY_SIZE < stats.distinctPatterns) {
+        throw std::runtime_error("Error: Truncated baseline profile " + filename);
+    }
+
+    ExtractionConfig& config = profile.config_;
+    config.timeThresholdMs = loadLE<int64_t>(data + 72);
+    config.minLength = data[80];
+    config.maxLength = data[81];
+    for (int word = 0; word < 4; ++word) {
+        config.startKeys.words[word] = loadLE<uint64_t>(data + 88 + word * 8);
+        config.coreKeys.words[word] = loadLE<uint64_t>(data + 120 + word * 8);
+    }
+
+    profile.entries_ = data + headerSize;
+    return profile;
+}
+
+bool BaselineProfile::verify() const {
+    const uint8_t* header = reinterpret_cast<const uint8_t*>(file_->data());
+    return BinaryEventLog::crc32(entries_, size() * ENTRY_SIZE) == loadLE<uint32_t>(header + 12);
+}
+
+BaselineProfile::Entry BaselineProfile::entryAt(size_t index) const {
+    const uint8_t* entry = entries_ + index * ENTRY_SIZE;
+    Entry result;
+    result.key.lo = loadLE<uint64_t>(entry);
+    result.key.hi = loadLE<uint64_t>(entry + 8);
+    result.count = loadLE<uint64_t>(entry + 16);
+    return result;
+}
+
+uint64_t BaselineProfile::count(const PatternKey& key) const {
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const Entry entry = entryAt(middle);
+        if (keyLess(entry.key, key)) {
+            low = middle + 1;
+        }
+        else if (keyLess(key, entry.key)) {
+            high = middle;
+        }
+        else {
+            return entry.count;
+        }
+    }
+    return 0;
+}
+
+uint64_t BaselineProfile::count(const MicroPattern& pattern) const {
+    PatternKey key;
+    return PatternKey::fromMicroPattern(pattern, key) ? count(key) : 0;
+}
+
+bool BaselineProfile::isSuspicious(const PatternKey& key, uint64_t maxCount) const {
+    const uint64_t baselineCount = count(key);
+    return baselineCount > 0 && baselineCount <= maxCount;
+}
+
+long long BaselineProfile::suspiciousInstances(const PatternCounter& frequencies, uint64_t maxCount) const {
+    long long instances = 0;
+    frequencies.forEachPacked([&](const PatternKey& key, int sessionCount) {
+        if (isSuspicious(key, maxCount)) {
+            instances += sessionCount;
+        }
+    });
+    return instances;
+}
+
+std::set<MicroPattern> BaselineProfile::suspiciousPatterns(uint64_t maxCount) const {
+    std::set<MicroPattern> patterns;
+    for (size_t i = 0; i < size(); ++i) {
+        const Entry entry = entryAt(i);
+        if (entry.count <= maxCount) {
+            patterns.insert(entry.key.toMicroPattern());
+        }
+    }
+    return patterns;
+}
+
+BaselineProfile::Stats BaselineProfile::merge(const std::string& filename, const PatternCounter& sessionFrequencies,
+    size_t sessionEvents, const ExtractionConfig& config) {
+    std::vector<Entry> sessionEntries;
+    sessionEntries.reserve(sessionFrequencies.size());
+    sessionFrequencies.forEachPacked([&](const PatternKey& key, int count) {
+        sessionEntries.push_back({key, static_cast<uint64_t>(count)});
+    });
+    std::sort(sessionEntries.begin(), sessionEntries.end(),
+              [](const Entry& a, const Entry& b) { return keyLess(a.key, b.key); });
+
+    Stats stats;
+    std::vector<Entry> merged;
+    if (fs::exists(filename)) {
+        // 정렬된 두 목록을 한 번에 병합 (기존 항목은 매핑된 파일에서 순서대로 읽음)
+        BaselineProfile existing = open(filename);
+        if (!sameConfig(existing.config(), config)) {
+            throw std::runtime_error("Error: Extraction settings differ from baseline profile " + filename);
+        }
+        stats = existing.stats();
+        merged.reserve(existing.size() + sessionEntries.size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < existing.size() || j < sessionEntries.size()) {
+            if (j == sessionEntries.size()) {
+                merged.push_back(existing.entryAt(i++));
+                continue;
+            }
+            if (i == existing.size()) {
+                merged.push_back(sessionEntries[j++]);
+                continue;
+            }
+            Entry entry = existing.entryAt(i);
+            if (keyLess(entry.key, sessionEntries[j].key)) {
+                i++;
+            }
+            else if (keyLess(sessionEntries[j].key, entry.key)) {
+                entry = sessionEntries[j++];
+            }
+            else {
+                entry.count += sessionEntries[j++].count;
+                i++;
+            }
+            merged.push_back(entry);
+        }
+    }
+    else {
+        merged = std::move(sessionEntries);
+    }
+
+    stats.sessions++;
+    stats.events += sessionEvents;
+    std::vector<uint64_t> counts;
+    counts.reserve(merged.size());
+    stats.totalInstances = 0;
+    for (const Entry& entry : merged) {
+        counts.push_back(entry.count);
+        stats.totalInstances += entry.count;
+    }
+    computeDistributionStats(std::move(counts), stats);
+
+    const std::string temporaryFilename = filename + ".tmp";
+    write(temporaryFilename, merged, stats, config);
+    std::error_code error;
+    fs::rename(temporaryFilename, filename, error);
+    if (error) {
+        fs::remove(temporaryFilename);
+        throw std::runtime_error("Error: Could not replace baseline profile " + filename + " - " + error.message());
+    }
+    return stats;
+}
+
+void BaselineProfile::write(const std::string& filename, const std::vector<Entry>& entries,
+    const Stats& stats, const ExtractionConfig& config) {
+    std::string body(entries.size() * ENTRY_SIZE, '\0');
+    uint8_t* out = reinterpret_cast<uint8_t*>(&body[0]);
+    for (const Entry& entry : entries) {
+        storeLE<uint64_t>(out, entry.key.lo);
+        storeLE<uint64_t>(out + 8, entry.key.hi);
+        storeLE<uint64_t>(out + 16, entry.count);
+        out += ENTRY_SIZE;
+    }
+
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    storeLE<uint16_t>(header + 4, VERSION);
+    storeLE<uint16_t>(header + 6, static_cast<uint16_t>(HEADER_SIZE));
+    storeLE<uint32_t>(header + 8, static_cast<uint32_t>(ENTRY_SIZE));
+    storeLE<uint32_t>(header + 12, BinaryEventLog::crc32(reinterpret_cast<const uint8_t*>(body.data()), body.size()));
+    storeLE<uint64_t>(header + 16, entries.size());
+    storeLE<uint64_t>(header + 24, stats.sessions);
+    storeLE<uint64_t>(header + 32, stats.events);
+    storeLE<uint64_t>(header + 40, stats.totalInstances);
+    storeLE<uint64_t>(header + 48, doubleBits(stats.top2Concentration));
+    storeLE<uint64_t>(header + 56, doubleBits(stats.top5Concentration));
+    storeLE<uint32_t>(header + 64, stats.coveragePatternCount);
+    storeLE<int64_t>(header + 72, config.timeThresholdMs);
+    header[80] = static_cast<uint8_t>(config.minLength);
+    header[81] = static_cast<uint8_t>(config.maxLength);
+    for (int word = 0; word < 4; ++word) {
+        storeLE<uint64_t>(header + 88 + word * 8, config.startKeys.words[word]);
+        storeLE<uint64_t>(header + 120 + word * 8, config.coreKeys.words[word]);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    file.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    file.write(body.data(), static_cast<std::streamsize>(body.size()));
+    if (!file) {
+        throw std::runtime_error("Error: Could not write baseline profile " + filename);
+    }
+}
@@ -0,0 +1,215 @@
+#include "../include/BatchAnalyzer.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/Metrics.h"
+#include "../include/ReportWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+BatchAnalyzer::BatchAnalyzer(const Options& options) : options_(options) {
+}
+
+std::vector<std::string> BatchAnalyzer::collectInputs(const std::string& path) {
+    std::vector<std::string> filenames;
+
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            const auto extension = entry.path().extension();
+            if (entry.is_regular_file() && (extension == ".csv" || extension == ".kmdl")) {
+                filenames.push_back(entry.path().string());
+            }
+        }
+        std::sort(filenames.begin(), filenames.end());
+        return filenames;
+    }
+
+    std::ifstream manifest(path);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Error: Could not open manifest " + path);
+    }
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        filenames.push_back(line);
+    }
+    return filenames;
+}
+
+void BatchAnalyzer::setSuspiciousPatterns(const std::set<MicroPattern>& suspiciousPatterns) {
+    suspiciousPatterns_ = suspiciousPatterns;
+    baselineProfile_.reset();
+    suspiciousKeys_.clear();
+    for (const MicroPattern& pattern : suspiciousPatterns) {
+        PatternKey key;
+        if (PatternKey::fromMicroPattern(pattern, key)) {
+            suspiciousKeys_.insert(key);
+        }
+    }
+    suspiciousMatcher_.reset(new SuspiciousPatternMatcher(suspiciousPatterns, options_.extraction));
+}
+
+void BatchAnalyzer::setBaselineProfile(std::shared_ptr<const BaselineProfile> profile) {
+    baselineProfile_ = std::move(profile);
+    suspiciousPatterns_.clear();
+    suspiciousKeys_.clear();
+    // 스케치 모드는 세션 빈도수가 없어 이벤트 스트림용 오토마톤이 필요하므로 그때만 항목을 펼침
+    suspiciousMatcher_.reset(options_.sketchCapacity > 0
+        ? new SuspiciousPatternMatcher(baselineProfile_->suspiciousPatterns(), options_.extraction) : nullptr);
+}
+
+SessionResult BatchAnalyzer::analyzeEvents(const std::string& session, const std::vector<InputEvent>& events) const {
+    if (options_.sketchCapacity > 0) {
+        return analyzeEventsSketch(session, events);
+    }
+
+    SessionResult result;
+    result.session = session;
+    result.events = events.size();
+
+    PatternCounter frequencies = PatternAnalyzer::calculatePackedPatternFrequencies(events, options_.extraction);
+    result.totalInstances = frequencies.totalInstances();
+    result.uniquePatterns = frequencies.size();
+
+    // 배치 결과에는 패턴 목록이 필요 없으므로 전체 정렬 없이 빈도수만으로 계산
+    result.top2Concentration = PatternAnalyzer::calculateTopNConcentration(frequencies, 2);
+    result.top5Concentration = PatternAnalyzer::calculateTopNConcentration(frequencies, 5);
+    result.coveragePatternCount = PatternAnalyzer::calculateCoveragePatternCount(frequencies, 50.0);
+    result.top2Lower = result.top2Concentration;
+    result.top5Lower = result.top5Concentration;
+    result.coverageLower = result.coverageUpper = result.coveragePatternCount;
+
+    // 의심 패턴 점유율: 세션의 패턴을 한 번 순회하며 기준 프로필 또는 해시 집합 조회
+    long long suspiciousCount = baselineProfile_ ? baselineProfile_->suspiciousInstances(frequencies) : 0;
+    frequencies.forEachPacked([&](const PatternKey& key, int count) {
+        if (suspiciousKeys_.count(key)) {
+            suspiciousCount += count;
+        }
+    });
+    for (const auto& pair : frequencies.overflow()) {
+        if (suspiciousPatterns_.count(pair.first)) {
+            suspiciousCount += pair.second;
+        }
+    }
+    result.suspiciousScore = result.totalInstances > 0
+        ? (static_cast<double>(suspiciousCount) / result.totalInstances) * 100.0 : 0.0;
+
+    result.finalScore = PatternAnalyzer::calculateBotSuspicionScore(result.top2Concentration,
+        result.top5Concentration, result.coveragePatternCount, result.suspiciousScore);
+    result.suspected = PatternAnalyzer::isBotSuspected(result.finalScore);
+    if (options_.signatureHashes > 0) {
+        result.signature = SessionSignature::fromCounter(frequencies, options_.signatureHashes);
+    }
+    return result;
+}
+
+SessionResult BatchAnalyzer::analyzeEventsSketch(const std::string& session, const std::vector<InputEvent>& events) const {
+    SessionResult result;
+    result.session = session;
+    result.events = events.size();
+
+    SpaceSavingSketch sketch = PatternAnalyzer::calculatePatternSketch(events, options_.extraction, options_.sketchCapacity);
+    result.totalInstances = sketch.totalInstances();
+    result.uniquePatterns = sketch.size();
+    result.exact = sketch.isExact();
+
+    // 점수는 추정값으로 계산하고, 오차 범위는 결과 파일에 함께 기록
+    const SketchEstimate top2 = sketch.topNConcentration(2);
+    const SketchEstimate top5 = sketch.topNConcentration(5);
+    const SketchEstimate coverage = sketch.coveragePatternCount(50.0);
+    result.top2Concentration = top2.value;
+    result.top5Concentration = top5.value;
+    result.coveragePatternCount = static_cast<int>(coverage.value);
+    result.top2Lower = top2.lower;
+    result.top5Lower = top5.lower;
+    result.coverageLower = static_cast<int>(coverage.lower);
+    result.coverageUpper = static_cast<int>(coverage.upper);
+
+    result.suspiciousScore = suspiciousMatcher_
+        ? PatternAnalyzer::calculateSuspiciousPatternScore(events, result.totalInstances, *suspiciousMatcher_) : 0.0;
+
+    result.finalScore = PatternAnalyzer::calculateBotSuspicionScore(result.top2Concentration,
+        result.top5Concentration, result.coveragePatternCount, result.suspiciousScore);
+    result.suspected = PatternAnalyzer::isBotSuspected(result.finalScore);
+    if (options_.signatureHashes > 0) {
+        result.signature = SessionSignature::fromSketch(sketch, options_.signatureHashes);
+    }
+    return result;
+}
+
+BatchSummary BatchAnalyzer::run(const std::vector<std::string>& filenames) {
+    FleetReportWriter::Options outputOptions;
+    outputOptions.format = FleetReportWriter::formatFor(options_.outputFilename);
+    outputOptions.append = options_.appendOutput;
+    outputOptions.sketchColumns = options_.sketchCapacity > 0;
+    FleetReportWriter output(options_.outputFilename, outputOptions);
+    sessions_.clear();
+
+    // 큰 파일부터 워커별 큐에 라운드 로빈 분배:
+    // 주인 워커는 큐 앞(큰 파일), 훔치는 워커는 큐 뒤(작은 파일)를 가져가므로 서로 막지 않음
+    std::vector<std::pair<uintmax_t, size_t>> jobs; // (파일 크기, 입력 순서)
+    jobs.reserve(filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        std::error_code error;
+        uintmax_t size = fs::file_size(filenames[i], error);
+        jobs.emplace_back(error ? 0 : size, i);
+    }
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::atomic<size_t> failedFiles{0};
+    std::atomic<long long> totalEvents{0};
+    std::vector<std::pair<size_t, SessionResult>> completed; // (입력 순서, 결과), 완료 순서로 쌓임
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(options_.threadCount);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            const size_t inputIndex = jobs[i].second;
+            const std::string filename = filenames[inputIndex];
+            pool.submit(i % pool.threadCount(), [this, inputIndex, filename, &output, &failedFiles, &totalEvents, &completed]() {
+                try {
+                    METRICS_SCOPED_TIMER(Metrics::Stage::SESSION);
+                    METRICS_COUNT(Metrics::Counter::SESSIONS, 1);
+                    std::vector<InputEvent> events = PatternAnalyzer::parseEventLogFile(filename);
+                    totalEvents += static_cast<long long>(events.size());
+                    SessionResult result = analyzeEvents(filename, events);
+                    output.write(result);
+                    if (options_.signatureHashes > 0) {
+                        std::lock_guard<std::mutex> lock(sessionsMutex_);
+                        completed.emplace_back(inputIndex, std::move(result));
+                    }
+                }
+                catch (const std::exception& e) {
+                    failedFiles++;
+                    std::cerr << "Warning: Skipping " << filename << " - " << e.what() << std::endl;
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    // 클러스터 대표와 유사도가 실행마다 같도록 완료 순서가 아닌 입력 순서로 보관
+    std::sort(completed.begin(), completed.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    sessions_.reserve(completed.size());
+    for (auto& entry : completed) {
+        sessions_.push_back(std::move(entry.second));
+    }
+
+    BatchSummary summary;
+    summary.files = jobs.size();
+    summary.failedFiles = failedFiles;
+    summary.events = totalEvents;
+    summary.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return summary;
+}
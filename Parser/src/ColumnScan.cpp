@@ -0,0 +1,185 @@
+#include "../include/ColumnScan.h"
+#include <limits>
+
+#if defined(__AVX2__)
+#define COLUMN_SCAN_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLUMN_SCAN_SSE2
+#include <emmintrin.h>
+#if defined(__SSE4_2__) || defined(__AVX__)
+#define COLUMN_SCAN_SSE42
+#include <nmmintrin.h>
+#endif
+#endif
+
+namespace {
+    constexpr size_t kMaxVectorStartCodes = 4;
+
+    // 시작 키가 적으면 (KEY_DOWN | VK) 코드와의 동등 비교로 벡터화, 많으면 스칼라 비트맵 조회
+    size_t collectStartCodes(const KeySet& startKeys, uint16_t* codes) {
+        size_t count = 0;
+        for (unsigned int keyCode = 0; keyCode < 256; ++keyCode) {
+            if (startKeys.contains(keyCode)) {
+                if (count == kMaxVectorStartCodes) {
+                    return kMaxVectorStartCodes + 1;
+                }
+                codes[count++] = static_cast<uint16_t>(keyCode);
+            }
+        }
+        return count;
+    }
+
+    void prepare(const EventColumns& columns, ColumnScan::Masks& masks) {
+        masks.count = columns.size();
+        const size_t words = (columns.size() + 63) / 64;
+        masks.starts.assign(words, 0);
+        masks.breaks.assign(words, 0);
+        if (words > 0) {
+            masks.breaks[0] = 1;
+        }
+    }
+
+    inline void setBit(std::vector<uint64_t>& mask, size_t index) {
+        mask[index >> 6] |= uint64_t(1) << (index & 63);
+    }
+
+    void scanStartsScalar(const uint16_t* codes, size_t begin, size_t end, const KeySet& startKeys,
+        std::vector<uint64_t>& starts) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint16_t code = codes[i];
+            // KEY_UP/WIDE 플래그가 있으면 8비트를 넘으므로 contains가 false
+            if (startKeys.contains(code)) {
+                setBit(starts, i);
+            }
+        }
+    }
+
+    void scanBreaksScalar(const int64_t* timestamps, size_t begin, size_t end, int64_t limitUs,
+        std::vector<uint64_t>& breaks) {
+        for (size_t i = begin < 1 ? 1 : begin; i < end; ++i) {
+            if (timestamps[i] - timestamps[i - 1] > limitUs) {
+                setBit(breaks, i);
+            }
+        }
+    }
+}
+
+int64_t ColumnScan::gapLimitUs(long long thresholdMs) {
+    const long long maxMs = std::numeric_limits<int64_t>::max() / 1000 - 1;
+    if (thresholdMs >= maxMs) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    if (thresholdMs <= -maxMs) {
+        return std::numeric_limits<int64_t>::min();
+    }
+    // 정수 마이크로초 gap에 대해: trunc(gap / 1000) <= t  <=>  gap <= (t + 1) * 1000 - 1  (t >= 0)
+    //                                                     <=>  gap <= t * 1000            (t < 0)
+    return thresholdMs >= 0 ? (thresholdMs + 1) * 1000 - 1 : thresholdMs * 1000;
+}
+
+void ColumnScan::scanScalar(const EventColumns& columns, const KeySet& startKeys, long long thresholdMs, Masks& masks) {
+    prepare(columns, masks);
+    scanStartsScalar(columns.codes(), 0, columns.size(), startKeys, masks.starts);
+    scanBreaksScalar(columns.timestamps(), 0, columns.size(), gapLimitUs(thresholdMs), masks.breaks);
+}
+
+const char* ColumnScan::kernelName() {
+#if defined(COLUMN_SCAN_AVX2)
+    return "avx2";
+#elif defined(COLUMN_SCAN_SSE42)
+    return "sse2+sse4.2";
+#elif defined(COLUMN_SCAN_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void ColumnScan::scan(const EventColumns& columns, const KeySet& startKeys, long long thresholdMs, Masks& masks) {
+    prepare(columns, masks);
+    const size_t n = columns.size();
+    const uint16_t* codes = columns.codes();
+    const int64_t* timestamps = columns.timestamps();
+    const int64_t limitUs = gapLimitUs(thresholdMs);
+
+    uint16_t startCodes[kMaxVectorStartCodes];
+    const size_t startCodeCount = collectStartCodes(startKeys, startCodes);
+    size_t i = 0;
+
+#if defined(COLUMN_SCAN_AVX2)
+    if (startCodeCount >= 1 && startCodeCount <= kMaxVectorStartCodes) {
+        __m256i targets[kMaxVectorStartCodes];
+        for (size_t k = 0; k < startCodeCount; ++k) {
+            targets[k] = _mm256_set1_epi16(static_cast<short>(startCodes[k]));
+        }
+        // 32개씩: 16비트 비교 결과 두 벡터를 8비트로 묶은 뒤 movemask
+        for (; i + 32 <= n; i += 32) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 16));
+            __m256i matchA = _mm256_cmpeq_epi16(a, targets[0]);
+            __m256i matchB = _mm256_cmpeq_epi16(b, targets[0]);
+            for (size_t k = 1; k < startCodeCount; ++k) {
+                matchA = _mm256_or_si256(matchA, _mm256_cmpeq_epi16(a, targets[k]));
+                matchB = _mm256_or_si256(matchB, _mm256_cmpeq_epi16(b, targets[k]));
+            }
+            // packs는 128비트 레인 단위로 섞이므로 64비트 단위 재배치로 원래 순서 복원
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(matchA, matchB), 0xD8);
+            const uint64_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(packed));
+            masks.starts[i >> 6] |= bits << (i & 63);
+        }
+    }
+#elif defined(COLUMN_SCAN_SSE2)
+    if (startCodeCount >= 1 && startCodeCount <= kMaxVectorStartCodes) {
+        __m128i targets[kMaxVectorStartCodes];
+        for (size_t k = 0; k < startCodeCount; ++k) {
+            targets[k] = _mm_set1_epi16(static_cast<short>(startCodes[k]));
+        }
+        for (; i + 16 <= n; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i + 8));
+            __m128i matchA = _mm_cmpeq_epi16(a, targets[0]);
+            __m128i matchB = _mm_cmpeq_epi16(b, targets[0]);
+            for (size_t k = 1; k < startCodeCount; ++k) {
+                matchA = _mm_or_si128(matchA, _mm_cmpeq_epi16(a, targets[k]));
+                matchB = _mm_or_si128(matchB, _mm_cmpeq_epi16(b, targets[k]));
+            }
+            const uint64_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(matchA, matchB)));
+            masks.starts[i >> 6] |= bits << (i & 63);
+        }
+    }
+#endif
+    if (startCodeCount > 0) {
+        scanStartsScalar(codes, i, n, startKeys, masks.starts);
+    }
+
+    // 간격: 4개(AVX2) / 2개(SSE4.2)씩 인접 차이를 한계값과 비교. 벡터 구간은 4의 배수 위치에서 시작하여
+    // 한 번에 만드는 비트가 워드 경계를 넘지 않게 함
+    size_t j = 1;
+#if defined(COLUMN_SCAN_AVX2)
+    if (n > 4) {
+        scanBreaksScalar(timestamps, 1, 4, limitUs, masks.breaks);
+        const __m256i limit = _mm256_set1_epi64x(limitUs);
+        for (j = 4; j + 4 <= n; j += 4) {
+            const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timestamps + j));
+            const __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timestamps + j - 1));
+            const __m256i exceeded = _mm256_cmpgt_epi64(_mm256_sub_epi64(current, previous), limit);
+            const uint64_t bits = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(exceeded)));
+            masks.breaks[j >> 6] |= bits << (j & 63);
+        }
+    }
+#elif defined(COLUMN_SCAN_SSE42)
+    if (n > 2) {
+        scanBreaksScalar(timestamps, 1, 2, limitUs, masks.breaks);
+        const __m128i limit = _mm_set1_epi64x(limitUs);
+        for (j = 2; j + 2 <= n; j += 2) {
+            const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(timestamps + j));
+            const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(timestamps + j - 1));
+            const __m128i exceeded = _mm_cmpgt_epi64(_mm_sub_epi64(current, previous), limit);
+            const uint64_t bits = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(exceeded)));
+            masks.breaks[j >> 6] |= bits << (j & 63);
+        }
+    }
+#endif
+    scanBreaksScalar(timestamps, j, n, limitUs, masks.breaks);
+}
@@ -0,0 +1,854 @@
+#include "../include/DetectorServer.h"
+
+#ifdef __linux__
+
+#include "../include/SessionCheckpoint.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    constexpr uint64_t LISTEN_TAG = UINT64_MAX;
+    constexpr uint64_t WAKE_TAG = UINT64_MAX - 1;
+    constexpr size_t READ_CHUNK = 64 * 1024;
+    constexpr int MAX_EPOLL_EVENTS = 256;
+
+    std::string systemError(const std::string& message) {
+        return "Error: " + message + " - " + std::strerror(errno);
+    }
+
+    struct SocketAddress {
+        sockaddr_storage storage = {};
+        socklen_t length = 0;
+        int family = AF_UNSPEC;
+        std::string unixPath;
+    };
+
+    SocketAddress parseEndpoint(const std::string& endpoint) {
+        SocketAddress address;
+        if (endpoint.compare(0, 5, "unix:") == 0) {
+            address.unixPath = endpoint.substr(5);
+            sockaddr_un* unixAddress = reinterpret_cast<sockaddr_un*>(&address.storage);
+            if (address.unixPath.empty() || address.unixPath.size() >= sizeof(unixAddress->sun_path)) {
+                throw std::runtime_error("Error: Invalid Unix socket path in endpoint " + endpoint);
+            }
+            unixAddress->sun_family = AF_UNIX;
+            std::memcpy(unixAddress->sun_path, address.unixPath.c_str(), address.unixPath.size() + 1);
+            address.family = AF_UNIX;
+            address.length = static_cast<socklen_t>(sizeof(sockaddr_un));
+            return address;
+        }
+
+        std::string hostPort = endpoint.compare(0, 4, "tcp:") == 0 ? endpoint.substr(4) : endpoint;
+        const size_t colon = hostPort.rfind(':');
+        if (colon == std::string::npos) {
+            throw std::runtime_error("Error: Invalid endpoint " + endpoint + " (expected unix:<path> or <host>:<port>)");
+        }
+        std::string host = hostPort.substr(0, colon);
+        if (host.empty() || host == "localhost") {
+            host = "127.0.0.1";
+        }
+        const int port = std::stoi(hostPort.substr(colon + 1));
+        sockaddr_in* inetAddress = reinterpret_cast<sockaddr_in*>(&address.storage);
+        inetAddress->sin_family = AF_INET;
+        inetAddress->sin_port = htons(static_cast<uint16_t>(port));
+        if (port <= 0 || port > 65535 || inet_pton(AF_INET, host.c_str(), &inetAddress->sin_addr) != 1) {
+            throw std::runtime_error("Error: Invalid endpoint " + endpoint);
+        }
+        address.family = AF_INET;
+        address.length = static_cast<socklen_t>(sizeof(sockaddr_in));
+        return address;
+    }
+
+    void setNoDelay(int fd) {
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+
+    DetectorProtocol::Verdict makeVerdict(const StreamingPatternAnalyzer& analyzer) {
+        DetectorProtocol::Verdict verdict;
+        verdict.eventsProcessed = static_cast<uint64_t>(analyzer.eventsProcessed());
+        verdict.totalInstances = static_cast<uint64_t>(analyzer.totalInstances());
+        verdict.top2Concentration = analyzer.topNConcentration(2);
+        verdict.top5Concentration = analyzer.topNConcentration(5);
+        verdict.coveragePatternCount = analyzer.coveragePatternCount(50.0);
+        verdict.distinctPatterns = static_cast<uint32_t>(analyzer.distinctPatterns());
+        verdict.suspiciousScore = analyzer.suspiciousScore();
+        verdict.finalScore = analyzer.botSuspicionScore();
+        verdict.suspected = PatternAnalyzer::isBotSuspected(verdict.finalScore);
+        return verdict;
+    }
+
+    uint16_t degradedFlag(const StreamingPatternAnalyzer& analyzer) {
+        return analyzer.isDegraded() ? DetectorProtocol::FLAG_DEGRADED : 0;
+    }
+
+    void updatePeak(std::atomic<uint64_t>& peak, uint64_t value) {
+        uint64_t current = peak.load(std::memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+namespace DetectorEndpoint {
+    int listenOn(const std::string& endpoint) {
+        const SocketAddress address = parseEndpoint(endpoint);
+        const int fd = socket(address.family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::runtime_error(systemError("Could not create socket for " + endpoint));
+        }
+        if (address.family == AF_UNIX) {
+            unlink(address.unixPath.c_str());
+        }
+        else {
+            int reuse = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+        if (bind(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0 ||
+            listen(fd, SOMAXCONN) != 0) {
+            const std::string message = systemError("Could not listen on " + endpoint);
+            close(fd);
+            throw std::runtime_error(message);
+        }
+        return fd;
+    }
+
+    int connectTo(const std::string& endpoint) {
+        const SocketAddress address = parseEndpoint(endpoint);
+        const int fd = socket(address.family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::runtime_error(systemError("Could not create socket for " + endpoint));
+        }
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0) {
+            const std::string message = systemError("Could not connect to " + endpoint);
+            close(fd);
+            throw std::runtime_error(message);
+        }
+        if (address.family == AF_INET) {
+            setNoDelay(fd);
+        }
+        return fd;
+    }
+}
+
+DetectorServer::Worker::Worker(DetectorServer& server, size_t index) : server_(server), index_(index) {
+    thread_ = std::thread(&Worker::loop, this);
+}
+
+DetectorServer::Worker::~Worker() {
+    stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void DetectorServer::Worker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_one();
+}
+
+bool DetectorServer::Worker::tryPush(Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= server_.options_.maxQueuedFramesPerWorker) {
+            return false;
+        }
+        queue_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+    return true;
+}
+
+void DetectorServer::Worker::restore(std::vector<RestoredSession> sessions) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        restoring_ = std::move(sessions);
+        restorePending_ = true;
+    }
+    condition_.notify_one();
+}
+
+void DetectorServer::Worker::loop() {
+    const auto evictionInterval = std::chrono::milliseconds(std::max(1LL, server_.options_.evictionIntervalMs));
+    const auto checkpointInterval = std::chrono::milliseconds(std::max(1LL, server_.options_.checkpointIntervalMs));
+    auto lastSweep = std::chrono::steady_clock::now();
+    auto lastCheckpoint = lastSweep;
+    bool checkpointing = false;
+    std::deque<Task> batch;
+    std::vector<RestoredSession> restored;
+    std::vector<Completion> completions;
+
+    while (true) {
+        bool stopping;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait_for(lock, evictionInterval,
+                [this]() { return stopping_ || restorePending_ || !queue_.empty(); });
+            if (restorePending_) {
+                restored.swap(restoring_);
+                restorePending_ = false;
+                checkpointing = true;
+                lastCheckpoint = std::chrono::steady_clock::now();
+            }
+            stopping = stopping_;
+            if (!stopping) {
+                batch.swap(queue_);
+            }
+        }
+        // 종료 직전이라도 복원은 마쳐야 종료 체크포인트에서 세션이 빠지지 않음
+        if (!restored.empty()) {
+            restoreSessions(restored);
+            publishMemory();
+        }
+        if (stopping) {
+            break;
+        }
+
+        // 큐를 통째로 가져와 처리하고, 판정은 한 번에 넘겨 입출력 스레드를 한 번만 깨움
+        for (Task& task : batch) {
+            process(task, completions);
+        }
+        batch.clear();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep >= evictionInterval) {
+            evictIdle(completions);
+            lastSweep = now;
+        }
+        if (checkpointing && now - lastCheckpoint >= checkpointInterval) {
+            checkpoint(false);
+            lastCheckpoint = now;
+        }
+        publishMemory();
+        if (!completions.empty()) {
+            server_.complete(completions);
+        }
+    }
+    if (checkpointing) {
+        checkpoint(true);
+    }
+}
+
+void DetectorServer::Worker::process(Task& task, std::vector<Completion>& completions) {
+    using DetectorProtocol::MessageType;
+    const DetectorProtocol::FrameHeader& header = task.header;
+    Completion completion{task.connectionId, true, false, std::string()};
+
+    if (header.type == MessageType::END_SESSION) {
+        auto it = sessions_.find(header.sessionId);
+        DetectorProtocol::Verdict verdict;
+        uint16_t flags = DetectorProtocol::FLAG_FINAL;
+        if (it != sessions_.end()) {
+            verdict = makeVerdict(it->second->analyzer);
+            flags |= degradedFlag(it->second->analyzer);
+            sessions_.erase(it);
+            server_.stats_.sessionsEnded++;
+            server_.stats_.activeSessions--;
+        }
+        DetectorProtocol::appendVerdictFrame(completion.bytes, header.sessionId, header.sequence, flags, verdict);
+        completions.push_back(std::move(completion));
+        return;
+    }
+
+    std::unique_ptr<Session>& slot = sessions_[header.sessionId];
+    if (!slot) {
+        slot.reset(new Session(pool_, server_.options_.sessionMemoryBudget, server_.options_.analyzer));
+        slot->analyzer.setSuspiciousMatcher(server_.matcher_);
+        updatePeak(server_.stats_.peakActiveSessions, ++server_.stats_.activeSessions);
+    }
+    Session& session = *slot;
+    session.connectionId = task.connectionId;
+    session.lastActive = std::chrono::steady_clock::now();
+
+    // EVENTS 페이로드는 이진 이벤트 로그 블록 하나 (CRC 검사 후 디코딩하며 바로 분석기에 전달)
+    const uint8_t* cursor = task.payload.data();
+    const uint8_t* end = cursor + task.payload.size();
+    BinaryEventLog::BlockView block;
+    uint64_t events = 0;
+    const bool valid = BinaryEventLog::nextBlock(cursor, end, block) == BinaryEventLog::BlockStatus::OK &&
+        cursor == end &&
+        BinaryEventLog::decodeBlock(block, [&](const BinaryEventLog::Event& event) {
+            InputEvent inputEvent;
+            inputEvent.timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
+                std::chrono::milliseconds(event.timestamp));
+            inputEvent.type = event.keyUp ? EventType::KEY_UP : EventType::KEY_DOWN;
+            inputEvent.keyCode = event.keyCode;
+            session.analyzer.addEvent(inputEvent);
+            events++;
+        });
+    server_.stats_.eventsProcessed += events;
+    if (session.analyzer.isDegraded() && !session.degradedReported) {
+        session.degradedReported = true;
+        server_.stats_.degradedSessions++;
+    }
+
+    if (!valid) {
+        server_.stats_.protocolErrors++;
+        completion.closeConnection = true;
+        DetectorProtocol::appendErrorFrame(completion.bytes, header.sessionId, header.sequence, "Corrupt event block");
+    }
+    else {
+        DetectorProtocol::appendVerdictFrame(completion.bytes, header.sessionId, header.sequence,
+            degradedFlag(session.analyzer), makeVerdict(session.analyzer));
+    }
+    completions.push_back(std::move(completion));
+}
+
+void DetectorServer::Worker::evictIdle(std::vector<Completion>& completions) {
+    if (server_.options_.idleTimeoutMs <= 0) {
+        return;
+    }
+    const auto deadline = std::chrono::steady_clock::now() - std::chrono::milliseconds(server_.options_.idleTimeoutMs);
+    for (auto it = sessions_.begin(); it != sessions_.end();) {
+        if (it->second->lastActive > deadline) {
+            ++it;
+            continue;
+        }
+        Completion completion{it->second->connectionId, false, false, std::string()};
+        DetectorProtocol::appendVerdictFrame(completion.bytes, it->first, 0,
+            DetectorProtocol::FLAG_FINAL | DetectorProtocol::FLAG_EVICTED | degradedFlag(it->second->analyzer),
+            makeVerdict(it->second->analyzer));
+        completions.push_back(std::move(completion));
+        it = sessions_.erase(it);
+        server_.stats_.sessionsEvicted++;
+        server_.stats_.activeSessions--;
+    }
+}
+
+void DetectorServer::Worker::restoreSessions(std::vector<RestoredSession>& sessions) {
+    for (RestoredSession& restored : sessions) {
+        std::unique_ptr<Session> session(
+            new Session(pool_, server_.options_.sessionMemoryBudget, server_.options_.analyzer));
+        session->analyzer.setSuspiciousMatcher(server_.matcher_);
+        try {
+            session->analyzer.loadState(reinterpret_cast<const uint8_t*>(restored.state.data()), restored.state.size());
+        }
+        catch (const std::exception& e) {
+            // 손상된 레코드나 메모리 예산 부족 (std::bad_alloc)은 그 세션만 버림
+            std::cerr << "Warning: Could not restore session " << restored.sessionId << " - " << e.what() << std::endl;
+            continue;
+        }
+        session->lastActive = std::chrono::steady_clock::now();
+        if (session->analyzer.isDegraded()) {
+            session->degradedReported = true;
+            server_.stats_.degradedSessions++;
+        }
+
+        std::unique_ptr<Session>& slot = sessions_[restored.sessionId];
+        if (!slot) {
+            updatePeak(server_.stats_.peakActiveSessions, ++server_.stats_.activeSessions);
+        }
+        slot = std::move(session);
+        server_.stats_.sessionsRestored++;
+    }
+    sessions.clear();
+}
+
+void DetectorServer::Worker::checkpoint(bool finalCheckpoint) {
+    std::string records;
+    for (const auto& pair : sessions_) {
+        SessionCheckpoint::appendRecord(records, pair.first, pair.second->analyzer);
+    }
+    server_.storeCheckpoint(index_, std::move(records), sessions_.size(), finalCheckpoint);
+}
+
+void DetectorServer::Worker::publishMemory() {
+    const size_t memory = pool_.bytesInUse();
+    if (memory == publishedMemory_) {
+        return;
+    }
+    if (memory > publishedMemory_) {
+        updatePeak(server_.stats_.peakSessionMemoryBytes, server_.stats_.sessionMemoryBytes += memory - publishedMemory_);
+    }
+    else {
+        server_.stats_.sessionMemoryBytes -= publishedMemory_ - memory;
+    }
+    publishedMemory_ = memory;
+}
+
+DetectorServer::DetectorServer(const Options& options) : options_(options) {
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        throw std::runtime_error(systemError("Could not create epoll instance"));
+    }
+    listenFd_ = DetectorEndpoint::listenOn(options_.endpoint);
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_TAG;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &event);
+    event.data.u64 = WAKE_TAG;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &event);
+
+    size_t workerCount = options_.workerThreads;
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    checkpointRecords_.resize(workerCount);
+    checkpointSessions_.resize(workerCount, 0);
+    checkpointFresh_.resize(workerCount, false);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.push_back(std::make_unique<Worker>(*this, i));
+    }
+}
+
+DetectorServer::~DetectorServer() {
+    workers_.clear();
+    for (auto& pair : connections_) {
+        close(pair.second->fd);
+    }
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+        if (options_.endpoint.compare(0, 5, "unix:") == 0) {
+            unlink(options_.endpoint.c_str() + 5);
+        }
+    }
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+    }
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+    }
+}
+
+void DetectorServer::setSuspiciousMatcher(std::shared_ptr<const SuspiciousPatternMatcher> matcher) {
+    matcher_ = std::move(matcher);
+}
+
+void DetectorServer::stop() {
+    stopping_ = true;
+    const uint64_t one = 1;
+    ssize_t written = write(wakeFd_, &one, sizeof(one));
+    (void)written;
+}
+
+void DetectorServer::complete(std::vector<Completion>& completions) {
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        for (Completion& completion : completions) {
+            completions_.push_back(std::move(completion));
+        }
+    }
+    completions.clear();
+    const uint64_t one = 1;
+    ssize_t written = write(wakeFd_, &one, sizeof(one));
+    (void)written;
+}
+
+void DetectorServer::restoreCheckpoint() {
+    std::vector<std::vector<RestoredSession>> restored(workers_.size());
+    SessionCheckpoint::read(options_.checkpointFile, options_.analyzer,
+        [&](uint64_t sessionId, const uint8_t* state, size_t stateBytes) {
+            restored[workerFor(sessionId)].push_back(
+                {sessionId, std::string(reinterpret_cast<const char*>(state), stateBytes)});
+        });
+    {
+        std::lock_guard<std::mutex> lock(checkpointMutex_);
+        checkpointActive_ = true;
+    }
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->restore(std::move(restored[i]));
+    }
+}
+
+void DetectorServer::storeCheckpoint(size_t workerIndex, std::string records, uint64_t sessions, bool finalCheckpoint) {
+    std::lock_guard<std::mutex> lock(checkpointMutex_);
+    checkpointRecords_[workerIndex] = std::move(records);
+    checkpointSessions_[workerIndex] = sessions;
+    if (finalCheckpoint) {
+        return;
+    }
+    if (!checkpointFresh_[workerIndex]) {
+        checkpointFresh_[workerIndex] = true;
+        freshCheckpoints_++;
+    }
+    if (freshCheckpoints_ < checkpointFresh_.size()) {
+        return;
+    }
+    std::fill(checkpointFresh_.begin(), checkpointFresh_.end(), false);
+    freshCheckpoints_ = 0;
+    try {
+        writeCheckpoint();
+    }
+    catch (const std::exception& e) {
+        // 기록 실패는 다음 주기에 다시 시도 (이전 체크포인트 파일은 그대로)
+        std::cerr << "Warning: Checkpoint failed - " << e.what() << std::endl;
+    }
+}
+
+void DetectorServer::writeCheckpoint() {
+    uint64_t sessions = 0;
+    for (uint64_t count : checkpointSessions_) {
+        sessions += count;
+    }
+    stats_.checkpointBytes = SessionCheckpoint::write(options_.checkpointFile, options_.analyzer, checkpointRecords_, sessions);
+    stats_.checkpointsWritten++;
+}
+
+DetectorServer::Stats DetectorServer::stats() const {
+    Stats stats;
+    stats.connectionsAccepted = stats_.connectionsAccepted;
+    stats.activeConnections = stats_.activeConnections;
+    stats.activeSessions = stats_.activeSessions;
+    stats.sessionsEnded = stats_.sessionsEnded;
+    stats.sessionsEvicted = stats_.sessionsEvicted;
+    stats.framesReceived = stats_.framesReceived;
+    stats.eventsProcessed = stats_.eventsProcessed;
+    stats.verdictsSent = stats_.verdictsSent;
+    stats.backpressurePauses = stats_.backpressurePauses;
+    stats.protocolErrors = stats_.protocolErrors;
+    stats.degradedSessions = stats_.degradedSessions;
+    stats.sessionMemoryBytes = stats_.sessionMemoryBytes;
+    stats.peakSessionMemoryBytes = stats_.peakSessionMemoryBytes;
+    stats.peakActiveSessions = stats_.peakActiveSessions;
+    stats.sessionsRestored = stats_.sessionsRestored;
+    stats.checkpointsWritten = stats_.checkpointsWritten;
+    stats.checkpointBytes = stats_.checkpointBytes;
+    return stats;
+}
+
+size_t DetectorServer::workerFor(uint64_t sessionId) const {
+    // splitmix64 마무리 단계로 연속된 세션 ID도 워커에 고르게 분산
+    uint64_t hash = sessionId + 0x9E3779B97F4A7C15ull;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return static_cast<size_t>(hash % workers_.size());
+}
+
+void DetectorServer::run() {
+    if (!options_.checkpointFile.empty() && !checkpointActive_) {
+        restoreCheckpoint();
+    }
+    epoll_event events[MAX_EPOLL_EVENTS];
+    while (!stopping_) {
+        const int count = epoll_wait(epollFd_, events, MAX_EPOLL_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(systemError("epoll_wait failed"));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const uint64_t tag = events[i].data.u64;
+            if (tag == LISTEN_TAG) {
+                acceptConnections();
+                continue;
+            }
+            if (tag == WAKE_TAG) {
+                uint64_t value;
+                ssize_t bytesRead = read(wakeFd_, &value, sizeof(value));
+                (void)bytesRead;
+                drainCompletions();
+                continue;
+            }
+
+            auto it = connections_.find(tag);
+            if (it == connections_.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+            if (events[i].events & EPOLLERR) {
+                closeConnection(tag);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flushOutput(connection)) {
+                continue;
+            }
+            if (closeIfFinished(connection)) {
+                continue;
+            }
+            // EPOLLHUP은 관심 목록과 무관하게 계속 보고되므로, 읽기를 멈췄거나 EOF를 받은 연결이면 바로 닫음
+            // (양방향이 모두 닫혔으므로 남은 판정도 보낼 수 없음)
+            if ((events[i].events & EPOLLHUP) && (isPaused(connection) || connection.peerClosed)) {
+                closeConnection(tag);
+                continue;
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLHUP)) && !connection.peerClosed) {
+                handleReadable(connection);
+            }
+            else {
+                updateInterest(connection);
+            }
+        }
+    }
+
+    if (checkpointActive_) {
+        // 워커는 멈추기 전에 마지막 스냅샷을 넘기므로 모두 멈춘 뒤 한 번 더 기록 (처리하지 못한 프레임은 버려짐)
+        workers_.clear();
+        std::lock_guard<std::mutex> lock(checkpointMutex_);
+        try {
+            writeCheckpoint();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Warning: Final checkpoint failed - " << e.what() << std::endl;
+        }
+    }
+}
+
+void DetectorServer::acceptConnections() {
+    while (true) {
+        const int fd = accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return; // EAGAIN 또는 일시적 오류 (EMFILE 등)는 다음 알림에서 재시도
+        }
+        if (options_.endpoint.compare(0, 5, "unix:") != 0) {
+            setNoDelay(fd);
+        }
+
+        auto connection = std::make_unique<Connection>();
+        connection->id = ++nextConnectionId_;
+        connection->fd = fd;
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = connection->id;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        connections_.emplace(connection->id, std::move(connection));
+        stats_.connectionsAccepted++;
+        stats_.activeConnections++;
+    }
+}
+
+bool DetectorServer::isPaused(const Connection& connection) const {
+    return connection.pendingFrames >= options_.maxPendingFramesPerConnection ||
+        !connection.deferred.empty() ||
+        connection.output.size() - connection.outputOffset >= options_.maxOutputBytesPerConnection;
+}
+
+void DetectorServer::handleReadable(Connection& connection) {
+    uint8_t buffer[READ_CHUNK];
+    while (!isPaused(connection)) {
+        const ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.insert(connection.input.end(), buffer, buffer + received);
+            if (!parseFrames(connection)) {
+                return;
+            }
+            if (static_cast<size_t>(received) < sizeof(buffer)) {
+                break;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (received < 0) {
+            closeConnection(connection.id);
+            return;
+        }
+        // 0 = 상대가 쓰기를 닫음. shutdown(SHUT_WR) 후 마지막 판정을 기다리는 클라이언트가 있으므로
+        // 읽기만 멈추고, 처리 중인 프레임의 판정을 모두 보낸 뒤 닫음 (남은 불완전 프레임은 버림)
+        connection.peerClosed = true;
+        if (closeIfFinished(connection)) {
+            return;
+        }
+        break;
+    }
+    updateInterest(connection);
+}
+
+bool DetectorServer::parseFrames(Connection& connection) {
+    using DetectorProtocol::MessageType;
+    const uint8_t* data = connection.input.data();
+    const size_t size = connection.input.size();
+    size_t offset = 0;
+
+    while (size - offset >= DetectorProtocol::HEADER_SIZE) {
+        const DetectorProtocol::FrameHeader header = DetectorProtocol::readHeader(data + offset);
+        if (header.payloadSize > options_.maxPayloadBytes) {
+            sendErrorAndClose(connection, "Frame payload too large");
+            return false;
+        }
+        if (header.type != MessageType::EVENTS && header.type != MessageType::END_SESSION) {
+            sendErrorAndClose(connection, "Unexpected message type");
+            return false;
+        }
+        if (size - offset - DetectorProtocol::HEADER_SIZE < header.payloadSize) {
+            break;
+        }
+
+        const uint8_t* payload = data + offset + DetectorProtocol::HEADER_SIZE;
+        Task task{connection.id, header, std::vector<uint8_t>(payload, payload + header.payloadSize)};
+        offset += DetectorProtocol::HEADER_SIZE + header.payloadSize;
+        stats_.framesReceived++;
+        dispatch(connection, std::move(task));
+    }
+    connection.input.erase(connection.input.begin(), connection.input.begin() + static_cast<std::ptrdiff_t>(offset));
+    return true;
+}
+
+void DetectorServer::dispatch(Connection& connection, Task task) {
+    // 앞서 밀린 프레임이 있으면 순서를 지키기 위해 뒤에 줄 세움
+    if (connection.deferred.empty() && workers_[workerFor(task.header.sessionId)]->tryPush(task)) {
+        connection.pendingFrames++;
+        return;
+    }
+    connection.deferred.push_back(std::move(task));
+    blockedConnections_.insert(connection.id);
+}
+
+void DetectorServer::retryDeferred(Connection& connection) {
+    while (!connection.deferred.empty()) {
+        Task& task = connection.deferred.front();
+        if (!workers_[workerFor(task.header.sessionId)]->tryPush(task)) {
+            return;
+        }
+        connection.deferred.pop_front();
+        connection.pendingFrames++;
+    }
+    blockedConnections_.erase(connection.id);
+}
+
+void DetectorServer::drainCompletions() {
+    std::vector<Completion> batch;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex_);
+        batch.swap(completions_);
+    }
+
+    std::vector<uint64_t> touched;
+    std::vector<uint64_t> closing;
+    touched.reserve(batch.size());
+    for (Completion& completion : batch) {
+        auto it = connections_.find(completion.connectionId);
+        if (it == connections_.end()) {
+            continue; // 이미 닫힌 연결
+        }
+        Connection& connection = *it->second;
+        if (completion.releasesPending) {
+            connection.pendingFrames--;
+        }
+        connection.output.append(completion.bytes);
+        stats_.verdictsSent++;
+        touched.push_back(completion.connectionId);
+        if (completion.closeConnection) {
+            closing.push_back(completion.connectionId);
+        }
+    }
+
+    // 워커 큐에 자리가 생겼을 수 있으므로 밀린 프레임을 다시 넘김
+    const std::vector<uint64_t> blocked(blockedConnections_.begin(), blockedConnections_.end());
+    for (uint64_t connectionId : blocked) {
+        auto it = connections_.find(connectionId);
+        if (it != connections_.end()) {
+            retryDeferred(*it->second);
+            touched.push_back(connectionId);
+        }
+    }
+
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (uint64_t connectionId : touched) {
+        auto it = connections_.find(connectionId);
+        if (it != connections_.end() && flushOutput(*it->second) && !closeIfFinished(*it->second)) {
+            updateInterest(*it->second);
+        }
+    }
+    for (uint64_t connectionId : closing) {
+        closeConnection(connectionId);
+    }
+}
+
+bool DetectorServer::flushOutput(Connection& connection) {
+    while (connection.outputOffset < connection.output.size()) {
+        const ssize_t sent = send(connection.fd, connection.output.data() + connection.outputOffset,
+            connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outputOffset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        closeConnection(connection.id);
+        return false;
+    }
+
+    if (connection.outputOffset == connection.output.size()) {
+        connection.output.clear();
+        connection.outputOffset = 0;
+    }
+    else if (connection.outputOffset >= READ_CHUNK) {
+        connection.output.erase(0, connection.outputOffset);
+        connection.outputOffset = 0;
+    }
+    return true;
+}
+
+void DetectorServer::updateInterest(Connection& connection) {
+    // EOF 이후에는 EPOLLIN이 계속 보고되므로 읽기 관심을 끔
+    const bool reading = !connection.peerClosed && !isPaused(connection);
+    const bool writing = connection.outputOffset < connection.output.size();
+    if (reading == connection.reading && writing == connection.writing) {
+        return;
+    }
+    if (connection.reading && !reading && !connection.peerClosed) {
+        stats_.backpressurePauses++;
+    }
+    connection.reading = reading;
+    connection.writing = writing;
+
+    epoll_event event = {};
+    event.events = (reading ? EPOLLIN : 0u) | (writing ? EPOLLOUT : 0u);
+    event.data.u64 = connection.id;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void DetectorServer::sendErrorAndClose(Connection& connection, const std::string& message) {
+    stats_.protocolErrors++;
+    DetectorProtocol::appendErrorFrame(connection.output, 0, 0, message);
+    if (flushOutput(connection)) {
+        closeConnection(connection.id);
+    }
+}
+
+bool DetectorServer::closeIfFinished(Connection& connection) {
+    if (!connection.peerClosed || connection.pendingFrames > 0 || !connection.deferred.empty() ||
+        connection.outputOffset < connection.output.size()) {
+        return false;
+    }
+    closeConnection(connection.id);
+    return true;
+}
+
+void DetectorServer::closeConnection(uint64_t connectionId) {
+    auto it = connections_.find(connectionId);
+    if (it == connections_.end()) {
+        return;
+    }
+    // 처리 중인 프레임의 판정은 연결 ID로 찾지 못해 버려지고, 세션 상태는 유휴 해제 때까지 유지
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    close(it->second->fd);
+    blockedConnections_.erase(connectionId);
+    connections_.erase(it);
+    stats_.activeConnections--;
+}
+
+#endif
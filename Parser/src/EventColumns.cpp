@@ -0,0 +1,37 @@
+#include "../include/EventColumns.h"
+
+EventColumns EventColumns::fromEvents(const std::vector<InputEvent>& events) {
+    EventColumns columns;
+    columns.reserve(events.size());
+    for (const InputEvent& event : events) {
+        columns.push(std::chrono::duration_cast<std::chrono::microseconds>(event.timestamp.time_since_epoch()).count(),
+            event.type, event.keyCode);
+    }
+    return columns;
+}
+
+void EventColumns::reserve(size_t count) {
+    timestampsUs_.reserve(count);
+    codes_.reserve(count);
+}
+
+void EventColumns::push(int64_t timestampUs, EventType type, unsigned int keyCode) {
+    if (keyCode > 0xFF) {
+        wideKeyCodes_[codes_.size()] = keyCode;
+    }
+    timestampsUs_.push_back(timestampUs);
+    codes_.push_back(packCode(type, keyCode));
+}
+
+void EventColumns::clear() {
+    timestampsUs_.clear();
+    codes_.clear();
+    wideKeyCodes_.clear();
+}
+
+unsigned int EventColumns::keyCode(size_t index) const {
+    if (codes_[index] & WIDE_FLAG) {
+        return wideKeyCodes_.at(index);
+    }
+    return codes_[index] & 0xFF;
+}
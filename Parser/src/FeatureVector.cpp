@@ -0,0 +1,84 @@
+#include "../include/FeatureVector.h"
+#include "../include/Metrics.h"
+#include <algorithm>
+#include <utility>
+
+FeatureVector::FeatureVector() : prefix_(1, 0) {
+}
+
+FeatureVector::FeatureVector(const PatternCounter& frequencies) : sorted_(frequencies.toSortedPairs()) {
+    buildPrefix();
+}
+
+FeatureVector::FeatureVector(const PatternFrequencyMap& frequencies)
+    : sorted_(frequencies.begin(), frequencies.end()) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::SORT);
+    std::sort(sorted_.begin(), sorted_.end(),
+        [](const PatternCountPair& a, const PatternCountPair& b) { return a.second > b.second; });
+    buildPrefix();
+}
+
+FeatureVector::FeatureVector(std::vector<PatternCountPair> sortedFrequencies) : sorted_(std::move(sortedFrequencies)) {
+    buildPrefix();
+}
+
+void FeatureVector::buildPrefix() {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
+    prefix_.resize(sorted_.size() + 1);
+    prefix_[0] = 0;
+    for (size_t i = 0; i < sorted_.size(); ++i) {
+        prefix_[i + 1] = prefix_[i] + sorted_[i].second;
+    }
+}
+
+long long FeatureVector::topNCount(int N) const {
+    if (N <= 0) {
+        return 0;
+    }
+    return prefix_[std::min(static_cast<size_t>(N), sorted_.size())];
+}
+
+double FeatureVector::topNConcentration(int N) const {
+    const long long totalInstances = this->totalInstances();
+    if (totalInstances == 0 || N <= 0) {
+        return 0.0;
+    }
+    return (static_cast<double>(topNCount(N)) / totalInstances) * 100.0;
+}
+
+int FeatureVector::coveragePatternCount(double coveragePercentage) const {
+    const long long totalInstances = this->totalInstances();
+    if (totalInstances == 0 || coveragePercentage <= 0.0) {
+        return 0;
+    }
+    coveragePercentage = std::min(100.0, coveragePercentage);
+
+    const long long targetCount = static_cast<long long>(totalInstances * (coveragePercentage / 100.0));
+    if (targetCount <= 0) {
+        return 1;
+    }
+    // prefix[k] >= targetCount인 최소 k (도달 불가 시 전체 패턴 수)
+    auto it = std::lower_bound(prefix_.begin() + 1, prefix_.end(), targetCount);
+    if (it == prefix_.end()) {
+        return static_cast<int>(sorted_.size());
+    }
+    return static_cast<int>(it - prefix_.begin());
+}
+
+std::vector<double> FeatureVector::topNConcentrations(const std::vector<int>& Ns) const {
+    std::vector<double> concentrations;
+    concentrations.reserve(Ns.size());
+    for (int N : Ns) {
+        concentrations.push_back(topNConcentration(N));
+    }
+    return concentrations;
+}
+
+std::vector<int> FeatureVector::coveragePatternCounts(const std::vector<double>& coveragePercentages) const {
+    std::vector<int> counts;
+    counts.reserve(coveragePercentages.size());
+    for (double coveragePercentage : coveragePercentages) {
+        counts.push_back(coveragePatternCount(coveragePercentage));
+    }
+    return counts;
+}
@@ -0,0 +1,244 @@
+#include "../include/Metrics.h"
+#include "../include/ReportWriter.h"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    // 단계/카운터마다 고정 슬롯: 조회 없이 인덱스로 relaxed 원자 연산만 수행
+    struct StageSlot {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumNanoseconds{0};
+        std::atomic<uint64_t> buckets[Metrics::HISTOGRAM_BUCKETS + 1] = {};
+    };
+
+    StageSlot stageSlots[static_cast<size_t>(Metrics::Stage::COUNT)];
+    std::atomic<uint64_t> counterSlots[static_cast<size_t>(Metrics::Counter::COUNT)] = {};
+
+    const double kBucketBounds[Metrics::HISTOGRAM_BUCKETS] = {
+        0.00001, 0.000025, 0.0001, 0.00025, 0.001, 0.0025, 0.01, 0.025,
+        0.1, 0.25, 1.0, 2.5, 10.0, 25.0, 100.0
+    };
+
+    const char* const kStageNames[] = { "parse", "extract", "sort", "feature", "score", "save", "session" };
+    const char* const kCounterNames[] = {
+        "events_parsed", "malformed_lines", "corrupt_blocks", "events_extracted", "pattern_instances",
+        "distinct_patterns", "sessions", "allocations", "allocated_bytes"
+    };
+
+    double throughput(Metrics::Counter counter, Metrics::Stage stage) {
+        Metrics::StageSnapshot snapshot = Metrics::stage(stage);
+        return snapshot.sumSeconds > 0.0 ? Metrics::value(counter) / snapshot.sumSeconds : 0.0;
+    }
+}
+
+#ifdef KMD_METRICS
+// 전역 할당 횟수/바이트 계측 (계측 빌드에서만 교체)
+void* operator new(std::size_t size) {
+    counterSlots[static_cast<size_t>(Metrics::Counter::ALLOCATIONS)].fetch_add(1, std::memory_order_relaxed);
+    counterSlots[static_cast<size_t>(Metrics::Counter::ALLOCATED_BYTES)].fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+// 정렬 요구가 큰 타입 (alignas(64) 등)의 할당도 같은 카운터에 집계
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    counterSlots[static_cast<size_t>(Metrics::Counter::ALLOCATIONS)].fetch_add(1, std::memory_order_relaxed);
+    counterSlots[static_cast<size_t>(Metrics::Counter::ALLOCATED_BYTES)].fetch_add(size, std::memory_order_relaxed);
+    const std::size_t bytes = size == 0 ? 1 : size;
+    const std::size_t align = static_cast<std::size_t>(alignment) < sizeof(void*)
+        ? sizeof(void*) : static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    if (void* pointer = _aligned_malloc(bytes, align)) {
+        return pointer;
+    }
+#else
+    void* pointer = nullptr;
+    if (posix_memalign(&pointer, align, bytes) == 0) {
+        return pointer;
+    }
+#endif
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+    operator delete(pointer, alignment);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept {
+    operator delete(pointer, alignment);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept {
+    operator delete(pointer, alignment);
+}
+#endif
+
+const char* Metrics::stageName(Stage stage) {
+    return kStageNames[static_cast<size_t>(stage)];
+}
+
+const char* Metrics::counterName(Counter counter) {
+    return kCounterNames[static_cast<size_t>(counter)];
+}
+
+double Metrics::bucketBound(size_t bucket) {
+    return kBucketBounds[bucket];
+}
+
+bool Metrics::enabled() {
+#ifdef KMD_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Metrics::recordStage(Stage stage, std::chrono::nanoseconds elapsed) {
+    StageSlot& slot = stageSlots[static_cast<size_t>(stage)];
+    const double seconds = elapsed.count() / 1e9;
+    size_t bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS && seconds > kBucketBounds[bucket]) {
+        bucket++;
+    }
+    slot.count.fetch_add(1, std::memory_order_relaxed);
+    slot.sumNanoseconds.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    slot.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::add(Counter counter, uint64_t value) {
+    counterSlots[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t Metrics::value(Counter counter) {
+    return counterSlots[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+Metrics::StageSnapshot Metrics::stage(Stage stage) {
+    const StageSlot& slot = stageSlots[static_cast<size_t>(stage)];
+    StageSnapshot snapshot;
+    snapshot.count = slot.count.load(std::memory_order_relaxed);
+    snapshot.sumSeconds = slot.sumNanoseconds.load(std::memory_order_relaxed) / 1e9;
+    for (size_t bucket = 0; bucket <= HISTOGRAM_BUCKETS; ++bucket) {
+        snapshot.buckets[bucket] = slot.buckets[bucket].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void Metrics::reset() {
+    for (StageSlot& slot : stageSlots) {
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.sumNanoseconds.store(0, std::memory_order_relaxed);
+        for (auto& bucket : slot.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (auto& counter : counterSlots) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::writePrometheus(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    file << "# HELP kmd_stage_duration_seconds Latency of each analysis stage\n";
+    file << "# TYPE kmd_stage_duration_seconds histogram\n";
+    for (size_t index = 0; index < static_cast<size_t>(Stage::COUNT); ++index) {
+        const char* name = kStageNames[index];
+        const StageSnapshot snapshot = stage(static_cast<Stage>(index));
+        uint64_t cumulative = 0;
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+            cumulative += snapshot.buckets[bucket];
+            file << "kmd_stage_duration_seconds_bucket{stage=\"" << name << "\",le=\"" << kBucketBounds[bucket]
+                << "\"} " << cumulative << "\n";
+        }
+        cumulative += snapshot.buckets[HISTOGRAM_BUCKETS];
+        file << "kmd_stage_duration_seconds_bucket{stage=\"" << name << "\",le=\"+Inf\"} " << cumulative << "\n";
+        file << "kmd_stage_duration_seconds_sum{stage=\"" << name << "\"} " << std::setprecision(9)
+            << snapshot.sumSeconds << "\n";
+        file << "kmd_stage_duration_seconds_count{stage=\"" << name << "\"} " << snapshot.count << "\n";
+    }
+
+    for (size_t index = 0; index < static_cast<size_t>(Counter::COUNT); ++index) {
+        file << "# TYPE kmd_" << kCounterNames[index] << "_total counter\n";
+        file << "kmd_" << kCounterNames[index] << "_total " << value(static_cast<Counter>(index)) << "\n";
+    }
+
+    file << "# TYPE kmd_parse_events_per_second gauge\n";
+    file << "kmd_parse_events_per_second " << throughput(Counter::EVENTS_PARSED, Stage::PARSE) << "\n";
+    file << "# TYPE kmd_extract_events_per_second gauge\n";
+    file << "kmd_extract_events_per_second " << throughput(Counter::EVENTS_EXTRACTED, Stage::EXTRACT) << "\n";
+}
+
+void Metrics::appendJsonLine(const std::string& filename, const std::string& label) {
+    std::ofstream file(filename, std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    std::ostringstream line;
+    line << std::setprecision(9);
+    // 레이블은 보고서와 같은 규칙으로 이스케이프 (따옴표, 역슬래시, 제어 문자)
+    std::string escapedLabel;
+    ReportWriter::appendJsonString(escapedLabel, label);
+    line << "{\"label\":" << escapedLabel << ",\"stages\":{";
+    for (size_t index = 0; index < static_cast<size_t>(Stage::COUNT); ++index) {
+        const StageSnapshot snapshot = stage(static_cast<Stage>(index));
+        line << (index > 0 ? "," : "") << "\"" << kStageNames[index] << "\":{\"count\":" << snapshot.count
+            << ",\"seconds\":" << snapshot.sumSeconds << ",\"buckets\":[";
+        for (size_t bucket = 0; bucket <= HISTOGRAM_BUCKETS; ++bucket) {
+            line << (bucket > 0 ? "," : "") << snapshot.buckets[bucket];
+        }
+        line << "]}";
+    }
+    line << "},\"counters\":{";
+    for (size_t index = 0; index < static_cast<size_t>(Counter::COUNT); ++index) {
+        line << (index > 0 ? "," : "") << "\"" << kCounterNames[index] << "\":" << value(static_cast<Counter>(index));
+    }
+    line << "},\"parse_events_per_second\":" << throughput(Counter::EVENTS_PARSED, Stage::PARSE)
+        << ",\"extract_events_per_second\":" << throughput(Counter::EVENTS_EXTRACTED, Stage::EXTRACT) << "}\n";
+    file << line.str();
+}
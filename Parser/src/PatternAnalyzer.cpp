@@ -1,36 +1,32 @@
 #define NOMINMAX
 #include "../include/PatternAnalyzer.h"
 #include "../include/Constants.h"
+#include "../include/MappedFile.h"
+#include "../include/BinaryEventLog.h"
+#include "../include/WorkStealingPool.h"
+#include "../include/Metrics.h"
+#include "../include/ExtractionKernel.h"
+#include "../include/ColumnScan.h"
+#include "../include/SuspiciousPatternMatcher.h"
+#include "../include/ReportWriter.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <numeric>
 #include <cmath>
+#include <charconv>
+#include <cstring>
 
-std::vector<InputEvent> PatternAnalyzer::parseLogFile(const std::string& filename) {
-    std::vector<InputEvent> events;
-    std::ifstream file(filename);
-    std::string line;
-
-    if (!file.is_open()) {
-        throw std::runtime_error("Error: Could not open file " + filename);
-    }
-
-    if (!std::getline(file, line)) {
-        std::cerr << "Warning: File is empty or could not read header line from " << filename << std::endl;
-        return events;
-    }
-
-    if (line != "Timestamp,EventType,KeyCode") {
-        std::cerr << "Warning: Unexpected header format in file " << filename << ": " << line << std::endl;
-    }
+namespace {
+    const char* const kLogHeader = "Timestamp,EventType,KeyCode";
 
-    int lineNumber = 1;
-    while (std::getline(file, line)) {
-        lineNumber++;
+    // CSV 한 줄을 파싱하여 events에 추가 (형식 오류 시 경고 출력 후 무시)
+    void parseLogLine(const std::string& line, int lineNumber, const std::string& filename,
+        std::vector<InputEvent>& events) {
         std::stringstream ss(line);
         std::string segment;
         std::vector<std::string> parts;
@@ -57,7 +53,8 @@ std::vector<InputEvent> PatternAnalyzer::parseLogFile(const std::string& filenam
                 else {
                     std::cerr << "Warning: Unknown event type '" << eventTypeString
                         << "' at line " << lineNumber << " in file " << filename << std::endl;
-                    continue;
+                    METRICS_COUNT(Metrics::Counter::MALFORMED_LINES, 1);
+                    return;
                 }
 
                 event.keyCode = std::stoul(parts[2]);
@@ -66,209 +63,623 @@ std::vector<InputEvent> PatternAnalyzer::parseLogFile(const std::string& filenam
             catch (const std::invalid_argument& e) {
                 std::cerr << "Warning: Invalid data format at line " << lineNumber
                     << " in file " << filename << " - " << e.what() << " (Line: " << line << ")" << std::endl;
+                METRICS_COUNT(Metrics::Counter::MALFORMED_LINES, 1);
             }
             catch (const std::out_of_range& e) {
                 std::cerr << "Warning: Data out of range at line " << lineNumber
                     << " in file " << filename << " - " << e.what() << " (Line: " << line << ")" << std::endl;
+                METRICS_COUNT(Metrics::Counter::MALFORMED_LINES, 1);
             }
         }
         else {
             std::cerr << "Warning: Incorrect number of fields (" << parts.size() << ") at line " << lineNumber
                 << " in file " << filename << " (Line: " << line << ")" << std::endl;
+            METRICS_COUNT(Metrics::Counter::MALFORMED_LINES, 1);
         }
     }
 
+    // 정상 형식의 줄(`<ms>,KEY_DOWN|KEY_UP,<vk>`)을 할당 없이 파싱. 그 외는 false
+    bool parseLogLineFast(const char* begin, const char* end, InputEvent& event) {
+        const char* comma1 = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+        if (comma1 == nullptr) {
+            return false;
+        }
+        const char* comma2 = static_cast<const char*>(std::memchr(comma1 + 1, ',', end - comma1 - 1));
+        if (comma2 == nullptr || comma2 + 1 == end ||
+            std::memchr(comma2 + 1, ',', end - comma2 - 1) != nullptr) {
+            return false;
+        }
+
+        long long timestamp_ms = 0;
+        auto tsResult = std::from_chars(begin, comma1, timestamp_ms);
+        if (tsResult.ec != std::errc() || tsResult.ptr != comma1) {
+            return false;
+        }
+
+        const char* typeBegin = comma1 + 1;
+        const size_t typeLength = static_cast<size_t>(comma2 - typeBegin);
+        if (typeLength == 8 && std::memcmp(typeBegin, "KEY_DOWN", 8) == 0) {
+            event.type = EventType::KEY_DOWN;
+        }
+        else if (typeLength == 6 && std::memcmp(typeBegin, "KEY_UP", 6) == 0) {
+            event.type = EventType::KEY_UP;
+        }
+        else {
+            return false;
+        }
+
+        unsigned long keyCode = 0;
+        auto keyResult = std::from_chars(comma2 + 1, end, keyCode);
+        if (keyResult.ec != std::errc() || keyResult.ptr != end) {
+            return false;
+        }
+
+        event.timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
+            std::chrono::milliseconds(timestamp_ms)
+        );
+        event.keyCode = static_cast<unsigned int>(keyCode);
+        return true;
+    }
+}
+
+std::vector<InputEvent> PatternAnalyzer::parseLogFile(const std::string& filename) {
+    std::vector<InputEvent> events;
+    METRICS_SCOPED_TIMER(Metrics::Stage::PARSE);
+    std::ifstream file(filename);
+    std::string line;
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not open file " + filename);
+    }
+
+    if (!std::getline(file, line)) {
+        std::cerr << "Warning: File is empty or could not read header line from " << filename << std::endl;
+        return events;
+    }
+
+    if (line != kLogHeader) {
+        std::cerr << "Warning: Unexpected header format in file " << filename << ": " << line << std::endl;
+    }
+
+    int lineNumber = 1;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        parseLogLine(line, lineNumber, filename, events);
+    }
+
     file.close();
+    METRICS_COUNT(Metrics::Counter::EVENTS_PARSED, events.size());
+    return events;
+}
+
+std::vector<InputEvent> PatternAnalyzer::parseLogFileMapped(const std::string& filename) {
+    std::vector<InputEvent> events;
+    METRICS_SCOPED_TIMER(Metrics::Stage::PARSE);
+    MappedFile file(filename);
+
+    if (file.empty()) {
+        std::cerr << "Warning: File is empty or could not read header line from " << filename << std::endl;
+        return events;
+    }
+
+    const char* cursor = file.data();
+    const char* const fileEnd = file.data() + file.size();
+
+    // 다음 줄의 [begin, end)를 구하고 cursor를 줄 다음으로 이동 (getline과 동일한 경계)
+    auto nextLine = [&](const char*& lineBegin, const char*& lineEnd) {
+        lineBegin = cursor;
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', fileEnd - cursor));
+        lineEnd = newline ? newline : fileEnd;
+        cursor = newline ? newline + 1 : fileEnd;
+#ifdef _WIN32
+        // 텍스트 모드 ifstream과 동일하게 CRLF의 CR 제거
+        if (newline && lineEnd > lineBegin && lineEnd[-1] == '\r') {
+            --lineEnd;
+        }
+#endif
+    };
+
+    const char* lineBegin;
+    const char* lineEnd;
+    nextLine(lineBegin, lineEnd);
+    checkLogHeader(lineBegin, lineEnd, filename);
+
+    // 한 줄 평균 약 27바이트 ("1712345678901,KEY_DOWN,164")
+    events.reserve(file.size() / 24);
+
+    int lineNumber = 1;
+    while (cursor < fileEnd) {
+        nextLine(lineBegin, lineEnd);
+        lineNumber++;
+        appendLogLine(lineBegin, lineEnd, lineNumber, filename, events);
+    }
+
+    METRICS_COUNT(Metrics::Counter::EVENTS_PARSED, events.size());
     return events;
 }
 
+void PatternAnalyzer::checkLogHeader(const char* begin, const char* end, const std::string& filename) {
+    const size_t headerLength = std::strlen(kLogHeader);
+    if (static_cast<size_t>(end - begin) != headerLength || std::memcmp(begin, kLogHeader, headerLength) != 0) {
+        std::cerr << "Warning: Unexpected header format in file " << filename << ": "
+            << std::string(begin, end) << std::endl;
+    }
+}
+
+void PatternAnalyzer::appendLogLine(const char* begin, const char* end, int lineNumber, const std::string& filename,
+    std::vector<InputEvent>& events) {
+    InputEvent event;
+    if (parseLogLineFast(begin, end, event)) {
+        events.push_back(event);
+    }
+    else {
+        // 비정상 줄은 기존 파서로 처리하여 경고 메시지를 동일하게 유지
+        parseLogLine(std::string(begin, end), lineNumber, filename, events);
+    }
+}
+
+std::vector<InputEvent> PatternAnalyzer::parseBinaryLogFile(const std::string& filename) {
+    std::vector<InputEvent> events;
+    METRICS_SCOPED_TIMER(Metrics::Stage::PARSE);
+    MappedFile file(filename);
+
+    const uint8_t* cursor = reinterpret_cast<const uint8_t*>(file.data());
+    const uint8_t* const fileEnd = cursor + file.size();
+    if (file.size() < BinaryEventLog::FILE_HEADER_SIZE || !BinaryEventLog::hasMagic(file.data(), file.size())) {
+        std::cerr << "Warning: File is empty or has no binary log header: " << filename << std::endl;
+        return events;
+    }
+
+    const uint16_t version = BinaryEventLog::loadLE<uint16_t>(cursor + 4);
+    const uint16_t headerSize = BinaryEventLog::loadLE<uint16_t>(cursor + 6);
+    const uint32_t timestampUnitUs = BinaryEventLog::loadLE<uint32_t>(cursor + 8);
+    if (version != BinaryEventLog::VERSION || headerSize < BinaryEventLog::FILE_HEADER_SIZE ||
+        headerSize > file.size() || timestampUnitUs == 0) {
+        throw std::runtime_error("Error: Unsupported binary log version or header in file " + filename);
+    }
+    cursor += headerSize;
+
+    // 블록 헤더만 따라가며 전체 이벤트 수를 구해 한 번에 예약 (CRC 검사 전이므로 블록마다 payload에 들어갈 수 있는 수로 제한)
+    size_t totalEvents = 0;
+    for (const uint8_t* header = cursor; static_cast<size_t>(fileEnd - header) >= BinaryEventLog::BLOCK_HEADER_SIZE;) {
+        const uint32_t payloadSize = BinaryEventLog::loadLE<uint32_t>(header + 4);
+        if (static_cast<size_t>(fileEnd - header - BinaryEventLog::BLOCK_HEADER_SIZE) < payloadSize) {
+            break;
+        }
+        totalEvents += std::min<size_t>(BinaryEventLog::loadLE<uint32_t>(header),
+            payloadSize / BinaryEventLog::MIN_EVENT_SIZE);
+        header += BinaryEventLog::BLOCK_HEADER_SIZE + payloadSize;
+    }
+    events.reserve(totalEvents);
+
+    int blockNumber = 0;
+    BinaryEventLog::BlockView block;
+    while (true) {
+        BinaryEventLog::BlockStatus status = BinaryEventLog::nextBlock(cursor, fileEnd, block);
+        blockNumber++;
+        if (status == BinaryEventLog::BlockStatus::END) {
+            break;
+        }
+        if (status == BinaryEventLog::BlockStatus::TRUNCATED) {
+            std::cerr << "Warning: Truncated block " << blockNumber << " in file " << filename << std::endl;
+            break;
+        }
+        if (status == BinaryEventLog::BlockStatus::BAD_CHECKSUM) {
+            std::cerr << "Warning: Checksum mismatch in block " << blockNumber << " in file " << filename
+                << ", skipping " << block.eventCount << " events" << std::endl;
+            METRICS_COUNT(Metrics::Counter::CORRUPT_BLOCKS, 1);
+            continue;
+        }
+        if (status == BinaryEventLog::BlockStatus::CORRUPT) {
+            std::cerr << "Warning: Corrupt block " << blockNumber << " in file " << filename
+                << ", event count does not fit its payload" << std::endl;
+            METRICS_COUNT(Metrics::Counter::CORRUPT_BLOCKS, 1);
+            continue;
+        }
+
+        const size_t blockStart = events.size();
+        bool decoded = BinaryEventLog::decodeBlock(block, [&](const BinaryEventLog::Event& record) {
+            InputEvent event;
+            event.timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
+                std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                    std::chrono::microseconds(record.timestamp * timestampUnitUs))
+            );
+            event.type = record.keyUp ? EventType::KEY_UP : EventType::KEY_DOWN;
+            event.keyCode = record.keyCode;
+            events.push_back(event);
+        });
+        if (!decoded) {
+            std::cerr << "Warning: Corrupt block " << blockNumber << " in file " << filename
+                << ", skipping " << block.eventCount << " events" << std::endl;
+            METRICS_COUNT(Metrics::Counter::CORRUPT_BLOCKS, 1);
+            events.resize(blockStart);
+        }
+    }
+
+    METRICS_COUNT(Metrics::Counter::EVENTS_PARSED, events.size());
+    return events;
+}
+
+std::vector<InputEvent> PatternAnalyzer::parseEventLogFile(const std::string& filename) {
+    bool isBinary = false;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        char magic[4] = {};
+        isBinary = file.read(magic, sizeof(magic)) && BinaryEventLog::hasMagic(magic, sizeof(magic));
+    }
+    return isBinary ? parseBinaryLogFile(filename) : parseLogFileMapped(filename);
+}
+
 bool PatternAnalyzer::isWithinTimeWindow(const InputEvent& event1, const InputEvent& event2, long long threshold_ms) {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(event2.timestamp - event1.timestamp);
     return duration.count() <= threshold_ms;
 }
 
 PatternFrequencyMap PatternAnalyzer::calculateMicroPatternFrequencies(const std::vector<InputEvent>& events) {
-    PatternFrequencyMap frequencies;
-    const int patternMinLength = 6;
-    const int patternMaxLength = 8;
-    const long long timeThresholdMs = 300;
+    return calculatePackedPatternFrequencies(events).toFrequencyMap();
+}
 
-    for (size_t i = 0; i < events.size(); ++i) {
-        if (events[i].type == EventType::KEY_DOWN && events[i].keyCode == VK_LMENU) {
-            for (int len = patternMinLength; len <= patternMaxLength && i + len <= events.size(); ++len) {
-                MicroPattern currentPattern;
-                bool patternValid = true;
-                bool containsCoreKey = false;
+PatternFrequencyMap PatternAnalyzer::calculateMicroPatternFrequencies(const std::vector<InputEvent>& events,
+    const ExtractionConfig& config) {
+    if (config.maxLength <= PatternKey::MAX_LENGTH) {
+        return calculatePackedPatternFrequencies(events, config).toFrequencyMap();
+    }
+    return calculateTriePatternFrequencies(events, config).toFrequencyMap();
+}
 
-                for (int j = 0; j < len; ++j) {
-                    if (j > 0 && !isWithinTimeWindow(events[i + j - 1], events[i + j], timeThresholdMs)) {
-                        patternValid = false;
-                        break;
+namespace {
+    // [begin, end) 구간 집계: 설정에 맞게 특수화된 커널을 선택 (ExtractionKernel.h)
+    // Sink: PatternCounter(정확) 또는 SpaceSavingSketch(근사)
+    template <typename Sink>
+    void countPackedPatterns(const std::vector<InputEvent>& events, size_t begin, size_t end,
+        const ExtractionConfig& config, Sink& frequencies) {
+        ExtractionKernel::dispatch(events, begin, end, end, config.minLength, config.maxLength, config.timeThresholdMs,
+            config.startKeys, config.coreKeys, frequencies);
+    }
+
+    // 시작 비트마스크의 세트 비트만 방문하고, 창 안의 첫 끊김 위치를 비트 연산으로 구해 확장 길이를 결정
+    template <typename Sink>
+    void countColumnPatterns(const EventColumns& columns, const ColumnScan::Masks& masks,
+        const ExtractionConfig& config, Sink& frequencies) {
+        const size_t n = columns.size();
+        const uint16_t* codes = columns.codes();
+        if (config.maxLength <= 0) {
+            return;
+        }
+        const uint64_t windowMask = config.maxLength >= 64 ? ~uint64_t(0) : (uint64_t(1) << (config.maxLength - 1)) - 1;
+
+        for (size_t word = 0; word < masks.starts.size(); ++word) {
+            uint64_t startBits = masks.starts[word];
+            while (startBits != 0) {
+                const size_t i = word * 64 + ColumnScan::countTrailingZeros(startBits);
+                startBits &= startBits - 1;
+
+                // i+1 ~ i+maxLength-1 사이의 첫 끊김 앞까지만 유효
+                size_t usable = static_cast<size_t>(config.maxLength);
+                const uint64_t windowBreaks = ColumnScan::bitsFrom(masks.breaks, i + 1) & windowMask;
+                if (windowBreaks != 0) {
+                    usable = static_cast<size_t>(ColumnScan::countTrailingZeros(windowBreaks)) + 1;
+                }
+                usable = std::min(usable, n - i);
+
+                PatternKey currentPattern;
+                bool packable = true;
+                bool containsCoreKey = false;
+                for (size_t j = 0; j < usable; ++j) {
+                    const uint16_t code = codes[i + j];
+                    if (code & EventColumns::WIDE_FLAG) {
+                        packable = false;
+                        containsCoreKey = containsCoreKey || config.coreKeys.contains(columns.keyCode(i + j));
                     }
-                    currentPattern.push_back({events[i + j].type, events[i + j].keyCode});
-                    if (Constants::patternStartKeys.count(events[i+j].keyCode)) {
-                        containsCoreKey = true;
+                    else {
+                        currentPattern.pushSymbol(code);
+                        containsCoreKey = containsCoreKey || config.coreKeys.contains(code & 0xFF);
+                    }
+
+                    const int len = static_cast<int>(j) + 1;
+                    if (len >= config.minLength && containsCoreKey) {
+                        if (packable) {
+                            frequencies.increment(currentPattern);
+                        }
+                        else {
+                            MicroPattern unpacked;
+                            for (int k = 0; k < len; ++k) {
+                                unpacked.push_back({columns.type(i + k), columns.keyCode(i + k)});
+                            }
+                            frequencies.incrementUnpacked(unpacked);
+                        }
                     }
                 }
+            }
+        }
+    }
 
-                if (patternValid && containsCoreKey) {
-                    frequencies[currentPattern]++;
+    void recordExtraction(size_t events, long long instances, size_t distinctPatterns) {
+        METRICS_COUNT(Metrics::Counter::EVENTS_EXTRACTED, events);
+        METRICS_COUNT(Metrics::Counter::PATTERN_INSTANCES, instances);
+        METRICS_COUNT(Metrics::Counter::DISTINCT_PATTERNS, distinctPatterns);
+        (void)events;
+        (void)instances;
+        (void)distinctPatterns;
+    }
+
+    void checkPackedLength(const ExtractionConfig& config) {
+        if (config.maxLength > PatternKey::MAX_LENGTH) {
+            throw std::invalid_argument("Packed pattern keys support at most 8 events per pattern");
+        }
+    }
+}
+
+PatternCounter PatternAnalyzer::calculatePackedPatternFrequencies(const std::vector<InputEvent>& events,
+    const ExtractionConfig& config) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::EXTRACT);
+    checkPackedLength(config);
+    PatternCounter frequencies;
+    countPackedPatterns(events, 0, events.size(), config, frequencies);
+    recordExtraction(events.size(), frequencies.totalInstances(), frequencies.size());
+    return frequencies;
+}
+
+PatternCounter PatternAnalyzer::calculatePackedPatternFrequencies(const std::vector<InputEvent>& events,
+    const ExtractionConfig& config, PatternTimingTable& timing) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::EXTRACT);
+    checkPackedLength(config);
+    PatternCounter frequencies;
+    TimedPatternSink sink(frequencies, timing);
+    countPackedPatterns(events, 0, events.size(), config, sink);
+    recordExtraction(events.size(), frequencies.totalInstances(), frequencies.size());
+    return frequencies;
+}
+
+PatternCounter PatternAnalyzer::calculatePackedPatternFrequencies(const EventColumns& columns,
+    const ExtractionConfig& config) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::EXTRACT);
+    checkPackedLength(config);
+    ColumnScan::Masks masks;
+    ColumnScan::scan(columns, config.startKeys, config.timeThresholdMs, masks);
+    PatternCounter frequencies;
+    countColumnPatterns(columns, masks, config, frequencies);
+    recordExtraction(columns.size(), frequencies.totalInstances(), frequencies.size());
+    return frequencies;
+}
+
+SpaceSavingSketch PatternAnalyzer::calculatePatternSketch(const std::vector<InputEvent>& events,
+    const ExtractionConfig& config, size_t capacity) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::EXTRACT);
+    checkPackedLength(config);
+    SpaceSavingSketch sketch(capacity);
+    countPackedPatterns(events, 0, events.size(), config, sketch);
+    recordExtraction(events.size(), sketch.totalInstances(), sketch.size());
+    return sketch;
+}
+
+std::vector<size_t> PatternAnalyzer::splitAtIdleGaps(const std::vector<InputEvent>& events,
+    size_t chunkCount, long long timeThresholdMs) {
+    // 임계값보다 긴 간격을 넘는 패턴은 없으므로 그 위치에서 자르면 결과가 변하지 않음
+    std::vector<size_t> boundaries = {0};
+    const size_t n = events.size();
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        size_t position = std::max(n * chunk / chunkCount, boundaries.back() + 1);
+        while (position < n && isWithinTimeWindow(events[position - 1], events[position], timeThresholdMs)) {
+            position++;
+        }
+        if (position >= n) {
+            break;
+        }
+        boundaries.push_back(position);
+    }
+    boundaries.push_back(n);
+    return boundaries;
+}
+
+PatternCounter PatternAnalyzer::calculatePackedPatternFrequenciesParallel(const std::vector<InputEvent>& events,
+    const ExtractionConfig& config, size_t threadCount) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::EXTRACT);
+    checkPackedLength(config);
+
+    WorkStealingPool pool(threadCount);
+    const std::vector<size_t> boundaries = splitAtIdleGaps(events, pool.threadCount(), config.timeThresholdMs);
+    const size_t chunkCount = boundaries.size() - 1;
+
+    // 청크별 스레드 로컬 테이블에 집계
+    std::vector<PatternCounter> partials(chunkCount);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        pool.submit(chunk, [&, chunk]() {
+            countPackedPatterns(events, boundaries[chunk], boundaries[chunk + 1], config, partials[chunk]);
+        });
+    }
+    pool.wait();
+
+    // 병렬 트리 리덕션: 단계마다 (i, i + step) 쌍을 동시에 병합
+    for (size_t step = 1; step < chunkCount; step *= 2) {
+        for (size_t i = 0; i + step < chunkCount; i += step * 2) {
+            pool.submit(i, [&partials, i, step]() {
+                partials[i].merge(partials[i + step]);
+                partials[i + step].clear();
+            });
+        }
+        pool.wait();
+    }
+    if (chunkCount == 0) {
+        return PatternCounter();
+    }
+    recordExtraction(events.size(), partials[0].totalInstances(), partials[0].size());
+    return std::move(partials[0]);
+}
+
+PatternTrie PatternAnalyzer::calculateTriePatternFrequencies(const std::vector<InputEvent>& events,
+    const ExtractionConfig& config) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::EXTRACT);
+    PatternTrie frequencies;
+    const ExtractionKernel::GapLimit gapLimit(config.timeThresholdMs);
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (events[i].type == EventType::KEY_DOWN && config.startKeys.contains(events[i].keyCode)) {
+            PatternTrie::NodeId node = PatternTrie::ROOT;
+            bool containsCoreKey = false;
+
+            for (int j = 0; j < config.maxLength && i + j < events.size(); ++j) {
+                if (j > 0 && !gapLimit.within(events[i + j - 1], events[i + j])) {
+                    break;
+                }
+                node = frequencies.child(node, events[i + j].type, events[i + j].keyCode);
+                if (config.coreKeys.contains(events[i + j].keyCode)) {
+                    containsCoreKey = true;
+                }
+                if (j + 1 >= config.minLength && containsCoreKey) {
+                    frequencies.increment(node);
                 }
             }
         }
     }
+    recordExtraction(events.size(), frequencies.totalInstances(), frequencies.size());
     return frequencies;
 }
 
 std::string PatternAnalyzer::getVirtualKeyName(unsigned int keyCode) {
-    switch (keyCode) {
-        case VK_F1: return "F1";
-        case VK_F2: return "F2";
-        case VK_F3: return "F3";
-        case VK_F4: return "F4";
-        case VK_F5: return "F5";
-        case VK_F6: return "F6";
-        case VK_F7: return "F7";
-        case VK_F8: return "F8";
-        case VK_F9: return "F9";
-        case VK_F10: return "F10";
-        case VK_F11: return "F11";
-        case VK_F12: return "F12";
-        case VK_RETURN: return "ENTER";
-        case VK_ESCAPE: return "ESC";
-        case VK_TAB: return "TAB";
-        case VK_SPACE: return "SPACE";
-        case VK_BACK: return "BACKSPACE";
-        case VK_DELETE: return "DELETE";
-        case VK_CONTROL: return "CTRL";
-        case VK_MENU: return "ALT";
-        case VK_SHIFT: return "SHIFT";
-        case VK_CAPITAL: return "CAPS";
-        case VK_LMENU: return "LALT";
-        case VK_UP: return "UP";
-        case VK_DOWN: return "DOWN";
-        case VK_LEFT: return "LEFT";
-        case VK_RIGHT: return "RIGHT";
-        case 0x30: return "0";
-        case 0x31: return "1";
-        case 0x32: return "2";
-        case 0x33: return "3";
-        case 0x34: return "4";
-        case 0x35: return "5";
-        case 0x36: return "6";
-        case 0x37: return "7";
-        case 0x38: return "8";
-        case 0x39: return "9";
-        case 0x41: return "A";
-        case 0x42: return "B";
-        case 0x43: return "C";
-        case 0x44: return "D";
-        case 0x45: return "E";
-        case 0x46: return "F";
-        case 0x47: return "G";
-        case 0x48: return "H";
-        case 0x49: return "I";
-        case 0x4A: return "J";
-        case 0x4B: return "K";
-        case 0x4C: return "L";
-        case 0x4D: return "M";
-        case 0x4E: return "N";
-        case 0x4F: return "O";
-        case 0x50: return "P";
-        case 0x51: return "Q";
-        case 0x52: return "R";
-        case 0x53: return "S";
-        case 0x54: return "T";
-        case 0x55: return "U";
-        case 0x56: return "V";
-        case 0x57: return "W";
-        case 0x58: return "X";
-        case 0x59: return "Y";
-        case 0x5A: return "Z";
-        default: return "VK_" + std::to_string(keyCode);
+    std::string name;
+    ReportWriter::appendKeyName(name, keyCode);
+    return name;
+}
+
+// 정렬된 목록을 버퍼 하나에 포맷하여 한 번에 출력
+void PatternAnalyzer::printFrequencies(const FeatureVector& features, const std::string& label) {
+    static thread_local std::string buffer;
+    buffer.clear();
+    ReportWriter::appendFrequencyListing(buffer, features, label);
+    std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::cout.flush();
+}
+
+void PatternAnalyzer::printFrequencies(const std::vector<PatternCountPair>& sortedFrequencies,
+    size_t uniquePatterns, const std::string& label) {
+    long long totalInstances = 0;
+    for (const auto& pair : sortedFrequencies) {
+        totalInstances += pair.second;
     }
+    static thread_local std::string buffer;
+    buffer.clear();
+    ReportWriter::appendFrequencyListing(buffer, sortedFrequencies, uniquePatterns, totalInstances, label);
+    std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::cout.flush();
 }
 
 void PatternAnalyzer::printFrequencies(const PatternFrequencyMap& frequencies, const std::string& label) {
-    std::vector<std::pair<MicroPattern, int>> sortedFrequencies(frequencies.begin(), frequencies.end());
-    std::sort(sortedFrequencies.begin(), sortedFrequencies.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second > b.second;
-              });
+    printFrequencies(FeatureVector(frequencies), label);
+}
 
-    std::cout << "--- " << label << " Micro-Pattern Frequencies ---" << std::endl;
-    int totalPatterns = 0;
-    for(const auto& pair : sortedFrequencies) {
-        totalPatterns += pair.second;
-    }
+void PatternAnalyzer::printFrequencies(const PatternCounter& frequencies, const std::string& label) {
+    printFrequencies(FeatureVector(frequencies), label);
+}
 
-    for (const auto& pair : sortedFrequencies) {
-        const MicroPattern& pattern = pair.first;
-        int count = pair.second;
-        double percentage = (totalPatterns > 0) ? (static_cast<double>(count) / totalPatterns * 100.0) : 0.0;
-
-        std::cout << "Count: " << count << " (" << std::fixed << std::setprecision(2) << percentage << "%) - Pattern: ";
-        for (const auto& eventPair : pattern) {
-            std::cout << "[" << (eventPair.first == EventType::KEY_DOWN ? "DOWN" : "UP") << "," 
-                     << getVirtualKeyName(eventPair.second) << "] ";
+namespace {
+    std::vector<int> collectCounts(const PatternCounter& frequencies) {
+        std::vector<int> counts;
+        counts.reserve(frequencies.size());
+        frequencies.forEachPacked([&](const PatternKey&, int count) {
+            counts.push_back(count);
+        });
+        for (const auto& pair : frequencies.overflow()) {
+            counts.push_back(pair.second);
         }
-        std::cout << std::endl;
+        return counts;
     }
-    std::cout << "Total unique patterns: " << frequencies.size() << std::endl;
-    std::cout << "Total pattern instances: " << totalPatterns << std::endl;
-    std::cout << "---------------------------------" << std::endl;
 }
 
+// 정렬된 목록을 그대로 훑음 (분모는 호출자의 totalInstances: 상위 N개만 받은 목록도 전체 대비 점유율)
 double PatternAnalyzer::calculateTopNConcentration(const std::vector<PatternCountPair>& sortedFrequencies,
     long long totalInstances, int N) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
     if (totalInstances == 0 || sortedFrequencies.empty() || N <= 0) {
         return 0.0;
     }
 
     long long topNCount = 0;
-    int count = 0;
-    for (const auto& pair : sortedFrequencies) {
-        if (count >= N) {
-            break;
-        }
-        topNCount += pair.second;
-        count++;
+    const size_t limit = std::min(static_cast<size_t>(N), sortedFrequencies.size());
+    for (size_t i = 0; i < limit; ++i) {
+        topNCount += sortedFrequencies[i].second;
     }
-
     return (static_cast<double>(topNCount) / totalInstances) * 100.0;
 }
 
 int PatternAnalyzer::calculateCoveragePatternCount(const std::vector<PatternCountPair>& sortedFrequencies,
     long long totalInstances, double coveragePercentage) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
     if (totalInstances == 0 || sortedFrequencies.empty() || coveragePercentage <= 0.0) {
         return 0;
     }
     coveragePercentage = std::min(100.0, coveragePercentage);
 
-    long long targetCount = static_cast<long long>(totalInstances * (coveragePercentage / 100.0));
+    const long long targetCount = static_cast<long long>(totalInstances * (coveragePercentage / 100.0));
     if (targetCount <= 0) {
-        return (totalInstances > 0 && coveragePercentage > 0.0) ? 1 : 0;
+        return 1;
     }
 
     long long currentCount = 0;
-    int patternsNeeded = 0;
-
-    for (const auto& pair : sortedFrequencies) {
-        currentCount += pair.second;
-        patternsNeeded++;
+    for (size_t i = 0; i < sortedFrequencies.size(); ++i) {
+        currentCount += sortedFrequencies[i].second;
         if (currentCount >= targetCount) {
-            break;
+            return static_cast<int>(i + 1);
         }
     }
-    if (currentCount < targetCount) {
-        return static_cast<int>(sortedFrequencies.size());
+    return static_cast<int>(sortedFrequencies.size());
+}
+
+double PatternAnalyzer::calculateTopNConcentration(const PatternCounter& frequencies, int N) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
+    const long long totalInstances = frequencies.totalInstances();
+    if (totalInstances == 0 || frequencies.size() == 0 || N <= 0) {
+        return 0.0;
+    }
+
+    // 상위 N개의 합만 필요하므로 순서 없이 N번째 경계만 찾음
+    std::vector<int> counts = collectCounts(frequencies);
+    const size_t limit = std::min(static_cast<size_t>(N), counts.size());
+    std::nth_element(counts.begin(), counts.begin() + (limit - 1), counts.end(), std::greater<int>());
+    long long topNCount = 0;
+    for (size_t i = 0; i < limit; ++i) {
+        topNCount += counts[i];
+    }
+
+    return (static_cast<double>(topNCount) / totalInstances) * 100.0;
+}
+
+int PatternAnalyzer::calculateCoveragePatternCount(const PatternCounter& frequencies, double coveragePercentage) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
+    const long long totalInstances = frequencies.totalInstances();
+    if (totalInstances == 0 || frequencies.size() == 0 || coveragePercentage <= 0.0) {
+        return 0;
+    }
+    coveragePercentage = std::min(100.0, coveragePercentage);
+
+    long long targetCount = static_cast<long long>(totalInstances * (coveragePercentage / 100.0));
+    if (targetCount <= 0) {
+        return 1;
+    }
+
+    // 상위 구간만 정렬하며 누적: 목표에 못 미치면 정렬 구간을 두 배로 늘림
+    std::vector<int> counts = collectCounts(frequencies);
+    size_t sortedCount = 0;
+    size_t window = 64;
+    long long currentCount = 0;
+    while (sortedCount < counts.size()) {
+        const size_t limit = std::min(sortedCount + window, counts.size());
+        std::partial_sort(counts.begin() + sortedCount, counts.begin() + limit, counts.end(), std::greater<int>());
+        for (size_t i = sortedCount; i < limit; ++i) {
+            currentCount += counts[i];
+            if (currentCount >= targetCount) {
+                return static_cast<int>(i + 1);
+            }
+        }
+        sortedCount = limit;
+        window *= 2;
     }
 
-    return patternsNeeded;
+    return static_cast<int>(counts.size());
 }
 
 double PatternAnalyzer::calculateSuspiciousPatternScore(const PatternFrequencyMap& frequencies,
     long long totalInstances, const std::set<MicroPattern>& suspiciousPatterns) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
     if (totalInstances == 0 || frequencies.empty() || suspiciousPatterns.empty()) {
         return 0.0;
     }
@@ -284,100 +695,146 @@ double PatternAnalyzer::calculateSuspiciousPatternScore(const PatternFrequencyMa
     return (static_cast<double>(suspiciousCount) / totalInstances) * 100.0;
 }
 
+double PatternAnalyzer::calculateSuspiciousPatternScore(const PatternCounter& frequencies,
+    long long totalInstances, const std::set<MicroPattern>& suspiciousPatterns) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
+    if (totalInstances == 0 || frequencies.empty() || suspiciousPatterns.empty()) {
+        return 0.0;
+    }
+
+    long long suspiciousCount = 0;
+    for (const MicroPattern& suspiciousPat : suspiciousPatterns) {
+        suspiciousCount += frequencies.count(suspiciousPat);
+    }
+
+    return (static_cast<double>(suspiciousCount) / totalInstances) * 100.0;
+}
+
+double PatternAnalyzer::calculateSuspiciousPatternScore(const std::vector<InputEvent>& events,
+    long long totalInstances, const SuspiciousPatternMatcher& matcher) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
+    if (totalInstances == 0 || events.empty() || matcher.empty()) {
+        return 0.0;
+    }
+    return (static_cast<double>(matcher.countMatches(events)) / totalInstances) * 100.0;
+}
+
+double PatternAnalyzer::calculateDominantTimingVariation(const PatternCounter& frequencies,
+    const PatternTimingTable& timing, int N) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::FEATURE);
+    if (N <= 0 || frequencies.empty()) {
+        return 0.0;
+    }
+
+    // 빈도수 내림차순, 같으면 키 순서 (실행마다 같은 패턴 선택)
+    std::vector<std::pair<int, PatternKey>> dominant;
+    dominant.reserve(frequencies.size());
+    frequencies.forEachPacked([&](const PatternKey& key, int count) {
+        dominant.emplace_back(count, key);
+    });
+    const size_t limit = std::min(static_cast<size_t>(N), dominant.size());
+    std::partial_sort(dominant.begin(), dominant.begin() + limit, dominant.end(),
+        [](const auto& a, const auto& b) { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+
+    double weightedVariation = 0.0;
+    double totalWeight = 0.0;
+    for (size_t i = 0; i < limit; ++i) {
+        const PatternTiming* patternTiming = timing.find(dominant[i].second);
+        if (patternTiming == nullptr || patternTiming->gaps.count < 2) {
+            continue;
+        }
+        const double weight = static_cast<double>(patternTiming->instances);
+        weightedVariation += weight * patternTiming->gaps.coefficientOfVariation();
+        totalWeight += weight;
+    }
+    return totalWeight > 0.0 ? weightedVariation / totalWeight : 0.0;
+}
+
 double PatternAnalyzer::calculateBotSuspicionScore(double top2Concentration,
-    double top5Concentration, int patternsFor50Coverage, double suspiciousScore) {
-    const double THRESH_CONC_TOP2_LOW = 30.0;
-    const double THRESH_CONC_TOP5_LOW = 45.0;
-    const double THRESH_COVERAGE_HIGH = 12.0;
-    const double THRESH_SUSPICIOUS_HIGH = 8.0;
+    double top5Concentration, int patternsFor50Coverage, double suspiciousScore, const ScoringParams& params) {
+    METRICS_SCOPED_TIMER(Metrics::Stage::SCORE);
+    (void)top2Concentration;
 
     double scoreConcentration = 0.0;
-    if (top5Concentration < THRESH_CONC_TOP5_LOW) {
-        scoreConcentration = 1.0 - (top5Concentration / THRESH_CONC_TOP5_LOW);
+    if (top5Concentration < params.top5ConcentrationLow) {
+        scoreConcentration = 1.0 - (top5Concentration / params.top5ConcentrationLow);
     }
     scoreConcentration = std::max(0.0, std::min(1.0, scoreConcentration));
 
     double scoreFlatness = 0.0;
     if (patternsFor50Coverage > 0) {
-        scoreFlatness = static_cast<double>(patternsFor50Coverage) / THRESH_COVERAGE_HIGH;
+        scoreFlatness = static_cast<double>(patternsFor50Coverage) / params.coverageHigh;
     }
     scoreFlatness = std::max(0.0, std::min(1.0, scoreFlatness));
 
     double scoreSuspicious = 0.0;
-    if (THRESH_SUSPICIOUS_HIGH > 0) {
-        scoreSuspicious = suspiciousScore / THRESH_SUSPICIOUS_HIGH;
+    if (params.suspiciousHigh > 0) {
+        scoreSuspicious = suspiciousScore / params.suspiciousHigh;
     }
     scoreSuspicious = std::max(0.0, std::min(1.0, scoreSuspicious));
 
-    const double WEIGHT_CONCENTRATION = 0.5;
-    const double WEIGHT_FLATNESS = 0.4;
-    const double WEIGHT_SUSPICIOUS = 0.1;
-
-    double finalScore = (WEIGHT_CONCENTRATION * scoreConcentration) +
-        (WEIGHT_FLATNESS * scoreFlatness) +
-        (WEIGHT_SUSPICIOUS * scoreSuspicious);
+    double finalScore = (params.weightConcentration * scoreConcentration) +
+        (params.weightFlatness * scoreFlatness) +
+        (params.weightSuspicious * scoreSuspicious);
 
     finalScore = std::max(0.0, std::min(1.0, finalScore));
 
     return finalScore;
 }
 
-bool PatternAnalyzer::isBotSuspected(double finalScore) {
-    const double FINAL_DECISION_THRESHOLD = 0.6;
-    return finalScore > FINAL_DECISION_THRESHOLD;
+// 주력 패턴의 미세 타이밍이 지나치게 균일하면(변동 계수가 낮으면) 의심
+double PatternAnalyzer::calculateBotSuspicionScore(double top2Concentration,
+    double top5Concentration, int patternsFor50Coverage, double suspiciousScore, double timingVariation,
+    const ScoringParams& params) {
+    double scoreTiming = 0.0;
+    if (timingVariation > 0.0 && timingVariation < params.timingVariationLow) {
+        scoreTiming = 1.0 - (timingVariation / params.timingVariationLow);
+    }
+    scoreTiming = std::max(0.0, std::min(1.0, scoreTiming));
+
+    double finalScore = calculateBotSuspicionScore(top2Concentration, top5Concentration,
+        patternsFor50Coverage, suspiciousScore, params) + (params.weightTiming * scoreTiming);
+
+    return std::max(0.0, std::min(1.0, finalScore));
+}
+
+bool PatternAnalyzer::isBotSuspected(double finalScore, const ScoringParams& params) {
+    return finalScore > params.decisionThreshold;
 }
 
 void PatternAnalyzer::saveAnalysisResults(
     const std::string& filename,
-    const std::vector<PatternCountPair>& sortedFrequencies,
+    const FeatureVector& features,
     double top2Concentration,
     double top5Concentration,
     int coveragePatternCount,
     double suspiciousScore,
     double finalScore) {
-    
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + filename);
-    }
-
-    // CSV 형식으로 저장
-    file << "pattern_id,pattern,frequency,percentage\n";
-    
-    int totalPatterns = 0;
-    for (const auto& pair : sortedFrequencies) {
-        totalPatterns += pair.second;
-    }
+    METRICS_SCOPED_TIMER(Metrics::Stage::SAVE);
+
+    // CSV 형식으로 저장 (패턴 목록 + 메트릭, visualizer.py가 읽는 형식)
+    static thread_local std::string buffer;
+    buffer.clear();
+    ReportWriter::appendAnalysisCsv(buffer, features,
+        {top2Concentration, top5Concentration, coveragePatternCount, suspiciousScore, finalScore});
+    ReportWriter::writeFile(filename, buffer);
+}
 
-    int patternId = 1;
+void PatternAnalyzer::saveAnalysisResults(
+    const std::string& filename,
+    const std::vector<PatternCountPair>& sortedFrequencies,
+    double top2Concentration,
+    double top5Concentration,
+    int coveragePatternCount,
+    double suspiciousScore,
+    double finalScore) {
+    long long totalInstances = 0;
     for (const auto& pair : sortedFrequencies) {
-        const auto& pattern = pair.first;
-        int count = pair.second;
-        double percentage = (totalPatterns > 0) ? 
-            (static_cast<double>(count) / totalPatterns * 100.0) : 0.0;
-
-        // 패턴을 문자열로 변환
-        std::stringstream patternStr;
-        for (const auto& event : pattern) {
-            patternStr << (event.first == EventType::KEY_DOWN ? "DOWN" : "UP") 
-                      << "_" << getVirtualKeyName(event.second) << "|";
-        }
-
-        file << patternId << "," 
-             << patternStr.str() << "," 
-             << count << "," 
-             << std::fixed << std::setprecision(2) << percentage << "\n";
-        patternId++;
+        totalInstances += pair.second;
     }
-
-    // 메트릭 정보 저장
-    file << "\nmetrics\n";
-    file << "metric,value\n";
-    file << "top2_concentration," << top2Concentration << "\n";
-    file << "top5_concentration," << top5Concentration << "\n";
-    file << "coverage_pattern_count," << coveragePatternCount << "\n";
-    file << "suspicious_score," << suspiciousScore << "\n";
-    file << "final_score," << finalScore << "\n";
-
-    file.close();
-} 
\ No newline at end of file
+    static thread_local std::string buffer;
+    buffer.clear();
+    ReportWriter::appendAnalysisCsv(buffer, sortedFrequencies, totalInstances,
+        {top2Concentration, top5Concentration, coveragePatternCount, suspiciousScore, finalScore});
+    ReportWriter::writeFile(filename, buffer);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "../include/PatternCounter.h"
+#include "../include/Metrics.h"
+#include <algorithm>
+
+namespace {
+    size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = 16;
+        while (capacity < value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    bool compareByCountDesc(const PatternCountPair& a, const PatternCountPair& b) {
+        return a.second > b.second;
+    }
+}
+
+PatternCounter::PatternCounter(size_t initialCapacity)
+    : slots_(roundUpToPowerOfTwo(initialCapacity)), mask_(slots_.size() - 1) {
+}
+
+void PatternCounter::grow() {
+    std::vector<Slot> oldSlots(slots_.size() * 2);
+    oldSlots.swap(slots_);
+    mask_ = slots_.size() - 1;
+    for (const Slot& slot : oldSlots) {
+        if (!slot.key.empty()) {
+            findSlot(slot.key) = slot;
+        }
+    }
+}
+
+void PatternCounter::incrementUnpacked(const MicroPattern& pattern, int amount) {
+    PatternKey key;
+    if (PatternKey::fromMicroPattern(pattern, key)) {
+        increment(key, amount);
+        return;
+    }
+    overflow_[pattern] += amount;
+    totalInstances_ += amount;
+}
+
+int PatternCounter::count(const PatternKey& key) const {
+    return findSlot(key).count;
+}
+
+int PatternCounter::count(const MicroPattern& pattern) const {
+    PatternKey key;
+    if (PatternKey::fromMicroPattern(pattern, key)) {
+        return count(key);
+    }
+    auto it = overflow_.find(pattern);
+    return it != overflow_.end() ? it->second : 0;
+}
+
+void PatternCounter::merge(const PatternCounter& other) {
+    other.forEachPacked([this](const PatternKey& key, int count) {
+        increment(key, count);
+    });
+    for (const auto& pair : other.overflow_) {
+        overflow_[pair.first] += pair.second;
+        totalInstances_ += pair.second;
+    }
+}
+
+void PatternCounter::clear() {
+    std::fill(slots_.begin(), slots_.end(), Slot());
+    distinct_ = 0;
+    totalInstances_ = 0;
+    overflow_.clear();
+}
+
+PatternFrequencyMap PatternCounter::toFrequencyMap() const {
+    PatternFrequencyMap frequencies(overflow_);
+    forEachPacked([&frequencies](const PatternKey& key, int count) {
+        frequencies.emplace(key.toMicroPattern(), count);
+    });
+    return frequencies;
+}
+
+std::vector<PatternCountPair> PatternCounter::toSortedPairs() const {
+    METRICS_SCOPED_TIMER(Metrics::Stage::SORT);
+    std::vector<PatternCountPair> sortedFrequencies;
+    sortedFrequencies.reserve(size());
+
+    if (overflow_.empty()) {
+        // PatternKey 순서 == MicroPattern 순서이므로 키 상태로 정렬 후 변환
+        std::vector<std::pair<PatternKey, int>> packed;
+        packed.reserve(distinct_);
+        forEachPacked([&packed](const PatternKey& key, int count) {
+            packed.emplace_back(key, count);
+        });
+        std::sort(packed.begin(), packed.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& pair : packed) {
+            sortedFrequencies.emplace_back(pair.first.toMicroPattern(), pair.second);
+        }
+    }
+    else {
+        PatternFrequencyMap frequencies = toFrequencyMap();
+        sortedFrequencies.assign(frequencies.begin(), frequencies.end());
+    }
+
+    std::sort(sortedFrequencies.begin(), sortedFrequencies.end(), compareByCountDesc);
+    return sortedFrequencies;
+}
@@ -0,0 +1,73 @@
+#include "../include/PatternTiming.h"
+#include <cmath>
+
+double RunningStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+double RunningStats::coefficientOfVariation() const {
+    return mean != 0.0 ? stddev() / mean : 0.0;
+}
+
+PatternTimingTable::PatternTimingTable() : PatternTimingTable(Options()) {
+}
+
+PatternTimingTable::PatternTimingTable(const Options& options)
+    : options_(options), slots_(1024), mask_(slots_.size() - 1) {
+}
+
+void PatternTimingTable::grow() {
+    std::vector<Slot> oldSlots(slots_.size() * 2);
+    oldSlots.swap(slots_);
+    mask_ = slots_.size() - 1;
+    for (const Slot& slot : oldSlots) {
+        if (!slot.key.empty()) {
+            findSlot(slot.key) = slot;
+        }
+    }
+}
+
+PatternTiming* PatternTimingTable::findOrInsert(const PatternKey& key) {
+    Slot* slot = &findSlot(key);
+    if (slot->key.empty()) {
+        if (timings_.size() >= options_.maxPatterns) {
+            return nullptr;
+        }
+        if ((timings_.size() + 1) * 4 > slots_.size() * 3) {
+            grow();
+            slot = &findSlot(key);
+        }
+        slot->key = key;
+        slot->index = static_cast<uint32_t>(timings_.size());
+        keys_.push_back(key);
+        timings_.emplace_back();
+    }
+    return &timings_[slot->index];
+}
+
+void PatternTimingTable::record(const PatternKey& key, const PatternTiming& instance) {
+    PatternTiming* timing = findOrInsert(key);
+    (timing != nullptr ? *timing : untracked_).merge(instance, options_.histograms);
+}
+
+const PatternTiming* PatternTimingTable::find(const PatternKey& key) const {
+    const Slot& slot = const_cast<PatternTimingTable*>(this)->findSlot(key);
+    return slot.key.empty() ? nullptr : &timings_[slot.index];
+}
+
+PatternTiming PatternTimingTable::overall() const {
+    PatternTiming total = untracked_;
+    for (const PatternTiming& timing : timings_) {
+        total.merge(timing, options_.histograms);
+    }
+    return total;
+}
+
+// 상대 테이블의 추적 패턴은 패턴 단위로, 상한을 넘는 패턴은 전체 통계로만 합침
+void PatternTimingTable::merge(const PatternTimingTable& other) {
+    for (size_t i = 0; i < other.keys_.size(); ++i) {
+        PatternTiming* timing = findOrInsert(other.keys_[i]);
+        (timing != nullptr ? *timing : untracked_).merge(other.timings_[i], options_.histograms);
+    }
+    untracked_.merge(other.untracked_, options_.histograms);
+}
@@ -0,0 +1,45 @@
+#include "../include/PatternTrie.h"
+#include "../include/Metrics.h"
+#include <algorithm>
+
+PatternTrie::PatternTrie() : edges_(1024), edgeMask_(edges_.size() - 1) {
+    nodes_.push_back({ROOT, EventType::KEY_DOWN, 0, 0, 0});
+}
+
+void PatternTrie::growEdges() {
+    std::vector<Edge> oldEdges(edges_.size() * 2);
+    oldEdges.swap(edges_);
+    edgeMask_ = edges_.size() - 1;
+    for (const Edge& edge : oldEdges) {
+        if (edge.child != ROOT) {
+            findEdge(edge.parent, edge.type, edge.keyCode) = edge;
+        }
+    }
+}
+
+MicroPattern PatternTrie::patternOf(NodeId node) const {
+    MicroPattern pattern(nodes_[node].depth);
+    for (NodeId current = node; current != ROOT; current = nodes_[current].parent) {
+        pattern[nodes_[current].depth - 1] = {nodes_[current].type, nodes_[current].keyCode};
+    }
+    return pattern;
+}
+
+PatternFrequencyMap PatternTrie::toFrequencyMap() const {
+    PatternFrequencyMap frequencies;
+    for (NodeId node = 1; node < nodes_.size(); ++node) {
+        if (nodes_[node].count > 0) {
+            frequencies.emplace(patternOf(node), nodes_[node].count);
+        }
+    }
+    return frequencies;
+}
+
+std::vector<PatternCountPair> PatternTrie::toSortedPairs() const {
+    METRICS_SCOPED_TIMER(Metrics::Stage::SORT);
+    PatternFrequencyMap frequencies = toFrequencyMap();
+    std::vector<PatternCountPair> sortedFrequencies(frequencies.begin(), frequencies.end());
+    std::sort(sortedFrequencies.begin(), sortedFrequencies.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+    return sortedFrequencies;
+}
@@ -0,0 +1,272 @@
+#include "../include/PipelinedIngest.h"
+#include "../include/ExtractionKernel.h"
+#include "../include/Metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    // 용량이 정해진 블록 인덱스 큐. close() 후에는 push가 버려지고 pop은 남은 항목을 비운 뒤 false
+    class BlockQueue {
+    public:
+        explicit BlockQueue(size_t capacity) : capacity_(capacity) {}
+
+        bool push(size_t block) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notFull_.wait(lock, [this]() { return closed_ || blocks_.size() < capacity_; });
+            if (closed_) {
+                return false;
+            }
+            blocks_.push_back(block);
+            notEmpty_.notify_one();
+            return true;
+        }
+
+        bool pop(size_t& block) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notEmpty_.wait(lock, [this]() { return closed_ || !blocks_.empty(); });
+            if (blocks_.empty()) {
+                return false;
+            }
+            block = blocks_.front();
+            blocks_.pop_front();
+            notFull_.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            notEmpty_.notify_all();
+            notFull_.notify_all();
+        }
+
+    private:
+        size_t capacity_;
+        std::deque<size_t> blocks_;
+        bool closed_ = false;
+        std::mutex mutex_;
+        std::condition_variable notEmpty_;
+        std::condition_variable notFull_;
+    };
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+PipelinedIngest::PipelinedIngest() : PipelinedIngest(Options()) {
+}
+
+PipelinedIngest::PipelinedIngest(const Options& options) : options_(options) {
+    if (options_.extraction.maxLength > PatternKey::MAX_LENGTH) {
+        throw std::invalid_argument("Packed pattern keys support at most 8 events per pattern");
+    }
+    if (options_.chunkBytes == 0 || options_.queueDepth == 0) {
+        throw std::invalid_argument("Pipelined ingest needs a non-zero chunk size and queue depth");
+    }
+}
+
+void PipelinedIngest::setSuspiciousMatcher(std::shared_ptr<const SuspiciousPatternMatcher> matcher) {
+    suspiciousMatcher_ = std::move(matcher);
+}
+
+PipelinedIngestSummary PipelinedIngest::run(const std::string& filename) {
+    if (filename == "-") {
+        return run(std::cin, "<stdin>");
+    }
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not open file " + filename);
+    }
+    return run(file, filename);
+}
+
+PipelinedIngestSummary PipelinedIngest::run(std::istream& input, const std::string& name) {
+    const auto startTime = std::chrono::steady_clock::now();
+    const ExtractionConfig& config = options_.extraction;
+    frequencies_.clear();
+    PipelinedIngestSummary summary;
+
+    // 블록 풀: 파서가 채우는 동안 추출 단계가 하나를 처리하고, 큐에 queueDepth개까지 대기
+    const size_t blockCount = options_.queueDepth + 2;
+    std::vector<std::vector<InputEvent>> blocks(blockCount);
+    BlockQueue filledBlocks(options_.queueDepth);
+    BlockQueue freeBlocks(blockCount);
+    for (size_t i = 0; i < blockCount; ++i) {
+        // 한 줄 평균 약 27바이트 ("1712345678901,KEY_DOWN,164")
+        blocks[i].reserve(options_.chunkBytes / 24);
+        freeBlocks.push(i);
+    }
+
+    // --- 파서 단계 ---
+    std::vector<char> buffer(options_.chunkBytes);
+    std::exception_ptr parserError;
+    double parseSeconds = 0.0;
+    std::thread parser([&]() {
+        try {
+            size_t pending = 0; // 버퍼 앞에 남은 잘린 줄의 바이트 수
+            int lineNumber = 0;
+            bool endOfInput = false;
+            while (!endOfInput) {
+                size_t block;
+                if (!freeBlocks.pop(block)) {
+                    return;
+                }
+                const auto chunkStart = std::chrono::steady_clock::now();
+                // 한 줄이 청크보다 길면 그 줄이 들어갈 때까지만 버퍼를 늘림
+                if (pending == buffer.size()) {
+                    buffer.resize(buffer.size() * 2);
+                }
+                input.read(buffer.data() + pending, static_cast<std::streamsize>(buffer.size() - pending));
+                const size_t bytesRead = static_cast<size_t>(input.gcount());
+                endOfInput = !input;
+                if (input.bad()) {
+                    throw std::runtime_error("Error: Could not read from " + name);
+                }
+                summary.bytesRead += bytesRead;
+
+                std::vector<InputEvent>& events = blocks[block];
+                events.clear();
+                const char* cursor = buffer.data();
+                const char* const dataEnd = buffer.data() + pending + bytesRead;
+                while (cursor < dataEnd) {
+                    const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', dataEnd - cursor));
+                    if (newline == nullptr && !endOfInput) {
+                        break;
+                    }
+                    const char* lineEnd = newline ? newline : dataEnd;
+#ifdef _WIN32
+                    // 텍스트 모드 ifstream과 동일하게 CRLF의 CR 제거
+                    if (newline && lineEnd > cursor && lineEnd[-1] == '\r') {
+                        --lineEnd;
+                    }
+#endif
+                    lineNumber++;
+                    if (lineNumber == 1) {
+                        PatternAnalyzer::checkLogHeader(cursor, lineEnd, name);
+                    }
+                    else {
+                        PatternAnalyzer::appendLogLine(cursor, lineEnd, lineNumber, name, events);
+                    }
+                    cursor = newline ? newline + 1 : dataEnd;
+                }
+                pending = static_cast<size_t>(dataEnd - cursor);
+                std::memmove(buffer.data(), cursor, pending);
+
+                if (endOfInput && lineNumber == 0) {
+                    std::cerr << "Warning: File is empty or could not read header line from " << name << std::endl;
+                }
+                summary.chunks++;
+                summary.events += events.size();
+                METRICS_COUNT(Metrics::Counter::EVENTS_PARSED, events.size());
+                parseSeconds += secondsSince(chunkStart);
+                if (!(events.empty() ? freeBlocks.push(block) : filledBlocks.push(block))) {
+                    return;
+                }
+            }
+        }
+        catch (...) {
+            parserError = std::current_exception();
+        }
+        filledBlocks.close();
+    });
+
+    // --- 추출 단계 ---
+    // carry: 앞 블록에서 넘어온, 아직 시작 위치로 쓰지 않은 이벤트 (확장에 필요한 만큼의 뒤 문맥이 아직 없음)
+    const size_t context = static_cast<size_t>(std::max(config.maxLength - 1, 0));
+    std::vector<InputEvent> carry;
+    std::vector<InputEvent> seam;
+    carry.reserve(context * 2);
+    seam.reserve(context * 2);
+    auto count = [&](const std::vector<InputEvent>& events, size_t begin, size_t end, size_t lookaheadEnd) {
+        ExtractionKernel::dispatch(events, begin, end, lookaheadEnd, config.minLength, config.maxLength,
+            config.timeThresholdMs, config.startKeys, config.coreKeys, frequencies_);
+    };
+
+    const SuspiciousPatternMatcher* matcher =
+        suspiciousMatcher_ && !suspiciousMatcher_->empty() ? suspiciousMatcher_.get() : nullptr;
+    const ExtractionKernel::GapLimit matcherGap(matcher ? matcher->config().timeThresholdMs : 0);
+    SuspiciousPatternMatcher::NodeId matcherState = SuspiciousPatternMatcher::ROOT;
+    InputEvent previous;
+    bool hasPrevious = false;
+
+    try {
+        size_t block;
+        while (filledBlocks.pop(block)) {
+            const auto blockStart = std::chrono::steady_clock::now();
+            const std::vector<InputEvent>& events = blocks[block];
+            const size_t n = events.size();
+
+            // 의심 패턴 오토마톤은 직전 이벤트 하나만 이어받으면 됨
+            if (matcher) {
+                for (const InputEvent& event : events) {
+                    if (hasPrevious && !matcherGap.within(previous, event)) {
+                        matcherState = SuspiciousPatternMatcher::ROOT;
+                    }
+                    matcherState = matcher->next(matcherState, event.type, event.keyCode);
+                    if (matcher->matchedLengths(matcherState) != 0) {
+                        summary.suspiciousMatches += matcher->matchCount(matcherState);
+                    }
+                    previous = event;
+                    hasPrevious = true;
+                }
+            }
+
+            if (n < context) {
+                // 작은 블록: 이월 문맥에 붙이고 뒤 문맥이 충분한 시작 위치만 집계
+                carry.insert(carry.end(), events.begin(), events.end());
+                if (carry.size() > context) {
+                    const size_t ready = carry.size() - context;
+                    count(carry, 0, ready, carry.size());
+                    carry.erase(carry.begin(), carry.begin() + ready);
+                }
+            }
+            else {
+                // 경계: 이월 문맥의 시작 위치를 새 블록 앞 context개까지 확장하여 집계
+                if (!carry.empty()) {
+                    seam.assign(carry.begin(), carry.end());
+                    seam.insert(seam.end(), events.begin(), events.begin() + context);
+                    count(seam, 0, carry.size(), seam.size());
+                }
+                count(events, 0, n - context, n);
+                carry.assign(events.end() - context, events.end());
+            }
+            METRICS_COUNT(Metrics::Counter::EVENTS_EXTRACTED, n);
+            summary.extractSeconds += secondsSince(blockStart);
+            freeBlocks.push(block);
+        }
+        // 입력 끝: 남은 시작 위치는 로그 끝까지만 확장
+        count(carry, 0, carry.size(), carry.size());
+    }
+    catch (...) {
+        freeBlocks.close();
+        filledBlocks.close();
+        parser.join();
+        throw;
+    }
+    parser.join();
+    if (parserError) {
+        std::rethrow_exception(parserError);
+    }
+
+    size_t blockBytes = 0;
+    for (const std::vector<InputEvent>& events : blocks) {
+        blockBytes += events.capacity() * sizeof(InputEvent);
+    }
+    summary.bufferBytes = buffer.capacity() + blockBytes + (carry.capacity() + seam.capacity()) * sizeof(InputEvent);
+    summary.parseSeconds = parseSeconds;
+    summary.elapsedSeconds = secondsSince(startTime);
+    METRICS_COUNT(Metrics::Counter::PATTERN_INSTANCES, frequencies_.totalInstances());
+    METRICS_COUNT(Metrics::Counter::DISTINCT_PATTERNS, frequencies_.size());
+    return summary;
+}
@@ -0,0 +1,260 @@
+#include "../include/RankedPatternCounts.h"
+#include <algorithm>
+#include <utility>
+
+RankedPatternCounts::RankedPatternCounts(std::pmr::memory_resource* memory)
+    : slots_(memory), order_(memory), counts_(memory), bucketFirst_(memory), bucketSize_(memory), fenwick_(memory) {
+}
+
+void RankedPatternCounts::increment(const PatternKey& key) {
+    size_t slot = findSlot(key);
+    const bool found = slot != NOT_FOUND && slots_[slot] != EMPTY_SLOT;
+    if (!found) {
+        reserveForInsert();
+        slot = findSlot(key);
+    }
+    const int count = found ? counts_[slots_[slot]] : 0;
+    const int newCount = count + 1;
+    if (bucketSize_.size() <= static_cast<size_t>(newCount)) {
+        bucketFirst_.resize(newCount + 1, 0);
+        bucketSize_.resize(newCount + 1, 0);
+    }
+
+    // 여기부터는 할당 없음
+    size_t position;
+    if (!found) {
+        // 빈도수 1인 구간은 항상 배열 끝
+        position = order_.size();
+        order_.push_back(key);
+        counts_.push_back(0);
+        slots_[slot] = static_cast<uint32_t>(position);
+    }
+    else {
+        position = slots_[slot];
+        // 현재 빈도수 구간의 첫 위치로 이동
+        const size_t first = bucketFirst_[count];
+        swapPositions(position, first);
+        position = first;
+        bucketFirst_[count]++;
+        bucketSize_[count]--;
+    }
+
+    if (bucketSize_[newCount] == 0) {
+        bucketFirst_[newCount] = static_cast<uint32_t>(position);
+    }
+    bucketSize_[newCount]++;
+
+    counts_[position] = newCount;
+    fenwickAdd(position, 1);
+    totalInstances_++;
+}
+
+void RankedPatternCounts::decrement(const PatternKey& key) {
+    const size_t slot = findSlot(key);
+    if (slot == NOT_FOUND || slots_[slot] == EMPTY_SLOT) {
+        return;
+    }
+
+    const int count = counts_[slots_[slot]];
+    // 현재 빈도수 구간의 마지막 위치로 이동
+    const size_t last = bucketFirst_[count] + bucketSize_[count] - 1;
+    swapPositions(slots_[slot], last);
+    bucketSize_[count]--;
+
+    const int newCount = count - 1;
+    counts_[last] = newCount;
+    fenwickAdd(last, -1);
+    totalInstances_--;
+
+    if (newCount == 0) {
+        // 빈도수 1 구간의 마지막 == 배열 끝
+        eraseSlot(slot);
+        order_.pop_back();
+        counts_.pop_back();
+    }
+    else {
+        bucketFirst_[newCount] = static_cast<uint32_t>(last);
+        bucketSize_[newCount]++;
+    }
+}
+
+bool RankedPatternCounts::appendRanked(const PatternKey& key, int count) {
+    if (count <= 0 || (!counts_.empty() && count > counts_.back())) {
+        return false;
+    }
+    const size_t existing = findSlot(key);
+    if (existing != NOT_FOUND && slots_[existing] != EMPTY_SLOT) {
+        return false;
+    }
+    reserveForInsert();
+    if (bucketSize_.size() <= static_cast<size_t>(count)) {
+        bucketFirst_.resize(count + 1, 0);
+        bucketSize_.resize(count + 1, 0);
+    }
+
+    // 여기부터는 할당 없음 (항상 배열 끝 = 가장 낮은 빈도수 구간의 끝)
+    const size_t position = order_.size();
+    order_.push_back(key);
+    counts_.push_back(count);
+    slots_[findSlot(key)] = static_cast<uint32_t>(position);
+    if (bucketSize_[count] == 0) {
+        bucketFirst_[count] = static_cast<uint32_t>(position);
+    }
+    bucketSize_[count]++;
+    fenwickAdd(position, count);
+    totalInstances_ += count;
+    return true;
+}
+
+void RankedPatternCounts::clear() {
+    std::fill(slots_.begin(), slots_.end(), EMPTY_SLOT);
+    order_.clear();
+    counts_.clear();
+    bucketFirst_.clear();
+    bucketSize_.clear();
+    fenwick_.clear();
+    totalInstances_ = 0;
+}
+
+int RankedPatternCounts::count(const PatternKey& key) const {
+    const size_t slot = findSlot(key);
+    return slot != NOT_FOUND && slots_[slot] != EMPTY_SLOT ? counts_[slots_[slot]] : 0;
+}
+
+int RankedPatternCounts::rank(const PatternKey& key) const {
+    const size_t slot = findSlot(key);
+    return slot != NOT_FOUND && slots_[slot] != EMPTY_SLOT ? static_cast<int>(slots_[slot]) : -1;
+}
+
+long long RankedPatternCounts::topNCount(int N) const {
+    if (N <= 0) {
+        return 0;
+    }
+    return fenwickPrefix(std::min(static_cast<size_t>(N), order_.size()));
+}
+
+int RankedPatternCounts::patternsToReach(long long targetCount) const {
+    if (targetCount > totalInstances_) {
+        return static_cast<int>(order_.size());
+    }
+    // Fenwick 이진 하강: prefix(pos) < targetCount인 최대 pos
+    size_t position = 0;
+    long long accumulated = 0;
+    size_t step = 1;
+    while (step * 2 < fenwick_.size()) {
+        step *= 2;
+    }
+    for (; step > 0; step /= 2) {
+        const size_t next = position + step;
+        if (next < fenwick_.size() && accumulated + fenwick_[next] < targetCount) {
+            position = next;
+            accumulated += fenwick_[next];
+        }
+    }
+    return static_cast<int>(position + 1);
+}
+
+size_t RankedPatternCounts::findSlot(const PatternKey& key) const {
+    if (slots_.empty()) {
+        return NOT_FOUND;
+    }
+    size_t index = static_cast<size_t>(key.hash()) & mask_;
+    while (slots_[index] != EMPTY_SLOT && order_[slots_[index]] != key) {
+        index = (index + 1) & mask_;
+    }
+    return index;
+}
+
+void RankedPatternCounts::reserveForInsert() {
+    // 부하율 3/4 이하 유지
+    if ((order_.size() + 1) * 4 > slots_.size() * 3) {
+        rebuildTable(slots_.empty() ? 16 : slots_.size() * 2);
+    }
+    if (order_.size() == order_.capacity()) {
+        order_.reserve(std::max<size_t>(8, order_.capacity() * 2));
+    }
+    if (counts_.size() == counts_.capacity()) {
+        counts_.reserve(std::max<size_t>(8, counts_.capacity() * 2));
+    }
+    ensureFenwickCapacity(order_.size() + 1);
+}
+
+void RankedPatternCounts::rebuildTable(size_t capacity) {
+    std::pmr::vector<uint32_t> slots(capacity, EMPTY_SLOT, slots_.get_allocator());
+    const size_t mask = capacity - 1;
+    for (size_t position = 0; position < order_.size(); ++position) {
+        size_t index = static_cast<size_t>(order_[position].hash()) & mask;
+        while (slots[index] != EMPTY_SLOT) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = static_cast<uint32_t>(position);
+    }
+    slots_.swap(slots);
+    mask_ = mask;
+}
+
+void RankedPatternCounts::eraseSlot(size_t slot) {
+    // 선형 탐사 역방향 이동 삭제: 뒤따르는 항목 중 빈 칸을 건너뛰어야 찾을 수 있는 것을 당겨옴
+    size_t hole = slot;
+    size_t index = slot;
+    while (true) {
+        index = (index + 1) & mask_;
+        if (slots_[index] == EMPTY_SLOT) {
+            break;
+        }
+        const size_t home = static_cast<size_t>(order_[slots_[index]].hash()) & mask_;
+        const bool reachable = hole <= index ? (home > hole && home <= index) : (home > hole || home <= index);
+        if (!reachable) {
+            slots_[hole] = slots_[index];
+            hole = index;
+        }
+    }
+    slots_[hole] = EMPTY_SLOT;
+}
+
+void RankedPatternCounts::swapPositions(size_t a, size_t b) {
+    if (a == b) {
+        return;
+    }
+    // 같은 빈도수끼리만 교환하므로 Fenwick 값은 변하지 않음
+    const size_t slotA = findSlot(order_[a]);
+    const size_t slotB = findSlot(order_[b]);
+    std::swap(order_[a], order_[b]);
+    std::swap(counts_[a], counts_[b]);
+    slots_[slotA] = static_cast<uint32_t>(b);
+    slots_[slotB] = static_cast<uint32_t>(a);
+}
+
+void RankedPatternCounts::fenwickAdd(size_t position, int delta) {
+    for (size_t i = position + 1; i < fenwick_.size(); i += i & (~i + 1)) {
+        fenwick_[i] += delta;
+    }
+}
+
+long long RankedPatternCounts::fenwickPrefix(size_t length) const {
+    long long sum = 0;
+    for (size_t i = length; i > 0; i -= i & (~i + 1)) {
+        sum += fenwick_[i];
+    }
+    return sum;
+}
+
+void RankedPatternCounts::ensureFenwickCapacity(size_t length) {
+    if (length < fenwick_.size()) {
+        return;
+    }
+    // 용량을 두 배로 늘리고 현재 빈도수로 O(n) 재구성
+    size_t capacity = fenwick_.empty() ? 16 : (fenwick_.size() - 1) * 2;
+    while (capacity < length) {
+        capacity *= 2;
+    }
+    std::pmr::vector<long long> fenwick(capacity + 1, 0, fenwick_.get_allocator());
+    for (size_t i = 1; i <= counts_.size(); ++i) {
+        fenwick[i] += counts_[i - 1];
+        const size_t parent = i + (i & (~i + 1));
+        if (parent <= capacity) {
+            fenwick[parent] += fenwick[i];
+        }
+    }
+    fenwick_.swap(fenwick);
+}
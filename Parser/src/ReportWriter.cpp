@@ -0,0 +1,388 @@
+#include "../include/ReportWriter.h"
+#include "../include/BatchAnalyzer.h"
+#include "../include/SessionClusterer.h"
+#include "../include/TuningEngine.h"
+#include <charconv>
+#include <filesystem>
+#include <stdexcept>
+
+namespace ReportWriter {
+    void appendKeyName(std::string& out, unsigned int keyCode) {
+        if (keyCode < 256) {
+            out.append(keyNames[keyCode]);
+            return;
+        }
+        out.append("VK_");
+        appendInteger(out, keyCode);
+    }
+
+    void appendInteger(std::string& out, long long value) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    void appendFixed(std::string& out, double value, int precision) {
+        char digits[352];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+        out.append(digits, result.ptr);
+    }
+
+    void appendGeneral(std::string& out, double value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        out.append(digits, result.ptr);
+    }
+
+    void appendJsonString(std::string& out, std::string_view value) {
+        static const char hexDigits[] = "0123456789abcdef";
+        out.push_back('"');
+        for (char c : value) {
+            const unsigned char byte = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            }
+            else if (byte < 0x20) {
+                out.append("\\u00");
+                out.push_back(hexDigits[byte >> 4]);
+                out.push_back(hexDigits[byte & 0xF]);
+            }
+            else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+    void appendCsvField(std::string& out, std::string_view value) {
+        if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out.append(value);
+            return;
+        }
+        out.push_back('"');
+        for (char c : value) {
+            if (c == '"') {
+                out.push_back('"');
+            }
+            out.push_back(c);
+        }
+        out.push_back('"');
+    }
+
+    void appendFrequencyListing(std::string& out, const FeatureVector& features, const std::string& label) {
+        appendFrequencyListing(out, features.sorted(), features.uniquePatterns(), features.totalInstances(), label);
+    }
+
+    void appendFrequencyListing(std::string& out, const std::vector<PatternCountPair>& sortedFrequencies,
+        size_t uniquePatterns, long long totalPatterns, const std::string& label) {
+        out.append("--- ").append(label).append(" Micro-Pattern Frequencies ---\n");
+        for (const auto& pair : sortedFrequencies) {
+            const int count = pair.second;
+            const double percentage = (totalPatterns > 0) ? (static_cast<double>(count) / totalPatterns * 100.0) : 0.0;
+
+            out.append("Count: ");
+            appendInteger(out, count);
+            out.append(" (");
+            appendFixed(out, percentage, 2);
+            out.append("%) - Pattern: ");
+            for (const auto& eventPair : pair.first) {
+                out.append(eventPair.first == EventType::KEY_DOWN ? "[DOWN," : "[UP,");
+                appendKeyName(out, eventPair.second);
+                out.append("] ");
+            }
+            out.push_back('\n');
+        }
+        out.append("Total unique patterns: ");
+        appendInteger(out, static_cast<long long>(uniquePatterns));
+        out.append("\nTotal pattern instances: ");
+        appendInteger(out, totalPatterns);
+        out.append("\n---------------------------------\n");
+    }
+
+    void appendAnalysisCsv(std::string& out, const FeatureVector& features, const AnalysisMetrics& metrics) {
+        appendAnalysisCsv(out, features.sorted(), features.totalInstances(), metrics);
+    }
+
+    void appendAnalysisCsv(std::string& out, const std::vector<PatternCountPair>& sortedFrequencies,
+        long long totalPatterns, const AnalysisMetrics& metrics) {
+        out.append("pattern_id,pattern,frequency,percentage\n");
+
+        int patternId = 1;
+        for (const auto& pair : sortedFrequencies) {
+            const int count = pair.second;
+            const double percentage = (totalPatterns > 0) ?
+                (static_cast<double>(count) / totalPatterns * 100.0) : 0.0;
+
+            appendInteger(out, patternId++);
+            out.push_back(',');
+            for (const auto& event : pair.first) {
+                out.append(event.first == EventType::KEY_DOWN ? "DOWN_" : "UP_");
+                appendKeyName(out, event.second);
+                out.push_back('|');
+            }
+            out.push_back(',');
+            appendInteger(out, count);
+            out.push_back(',');
+            appendFixed(out, percentage, 2);
+            out.push_back('\n');
+        }
+
+        // 기존 스트림 출력과 같은 형식: 패턴을 한 줄이라도 쓰면 이후 실수는 고정 소수점 2자리
+        auto appendMetric = [&](const char* name, double value) {
+            out.append(name).push_back(',');
+            if (sortedFrequencies.empty()) {
+                appendGeneral(out, value);
+            }
+            else {
+                appendFixed(out, value, 2);
+            }
+            out.push_back('\n');
+        };
+        out.append("\nmetrics\n");
+        out.append("metric,value\n");
+        appendMetric("top2_concentration", metrics.top2Concentration);
+        appendMetric("top5_concentration", metrics.top5Concentration);
+        out.append("coverage_pattern_count,");
+        appendInteger(out, metrics.coveragePatternCount);
+        out.push_back('\n');
+        appendMetric("suspicious_score", metrics.suspiciousScore);
+        appendMetric("final_score", metrics.finalScore);
+    }
+
+    void appendClusterCsv(std::string& out, const std::vector<SessionCluster>& clusters,
+        const std::vector<SessionResult>& sessions) {
+        out.append("cluster,cluster_size,mean_similarity,session,similarity,final_score,suspected\n");
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            const SessionCluster& cluster = clusters[c];
+            for (size_t i = 0; i < cluster.members.size(); ++i) {
+                const SessionResult& session = sessions[cluster.members[i]];
+                appendInteger(out, static_cast<long long>(c + 1));
+                out.push_back(',');
+                appendInteger(out, static_cast<long long>(cluster.members.size()));
+                out.push_back(',');
+                appendFixed(out, cluster.meanSimilarity, 3);
+                out.push_back(',');
+                appendCsvField(out, session.session);
+                out.push_back(',');
+                appendFixed(out, cluster.similarities[i], 3);
+                out.push_back(',');
+                appendFixed(out, session.finalScore, 2);
+                out.append(session.suspected ? ",1\n" : ",0\n");
+            }
+        }
+    }
+
+    void appendClusterJsonLines(std::string& out, const std::vector<SessionCluster>& clusters,
+        const std::vector<SessionResult>& sessions) {
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            const SessionCluster& cluster = clusters[c];
+            size_t suspectedCount = 0;
+            for (size_t member : cluster.members) {
+                if (sessions[member].suspected) {
+                    suspectedCount++;
+                }
+            }
+            out.append("{\"cluster\":");
+            appendInteger(out, static_cast<long long>(c + 1));
+            out.append(",\"size\":");
+            appendInteger(out, static_cast<long long>(cluster.members.size()));
+            out.append(",\"mean_similarity\":");
+            appendFixed(out, cluster.meanSimilarity, 3);
+            out.append(",\"suspected\":");
+            appendInteger(out, static_cast<long long>(suspectedCount));
+            out.append(",\"sessions\":[");
+            for (size_t i = 0; i < cluster.members.size(); ++i) {
+                const SessionResult& session = sessions[cluster.members[i]];
+                if (i > 0) {
+                    out.push_back(',');
+                }
+                out.append("{\"session\":");
+                appendJsonString(out, session.session);
+                out.append(",\"similarity\":");
+                appendFixed(out, cluster.similarities[i], 3);
+                out.append(",\"final_score\":");
+                appendFixed(out, session.finalScore, 2);
+                out.append(",\"suspected\":");
+                out.append(session.suspected ? "true}" : "false}");
+            }
+            out.append("]}\n");
+        }
+    }
+
+    void appendTuningCsv(std::string& out, const std::vector<TuningPoint>& points) {
+        out.append("min_length,max_length,gap_ms,top5_low,coverage_high,suspicious_high,weight_concentration,"
+            "weight_flatness,weight_suspicious,decision_threshold,auc,average_precision,tpr,fpr,precision,f1\n");
+        for (const TuningPoint& point : points) {
+            appendInteger(out, point.extraction.minLength);
+            out.push_back(',');
+            appendInteger(out, point.extraction.maxLength);
+            out.push_back(',');
+            appendInteger(out, point.extraction.timeThresholdMs);
+            for (double value : {point.scoring.top5ConcentrationLow, point.scoring.coverageHigh,
+                point.scoring.suspiciousHigh, point.scoring.weightConcentration, point.scoring.weightFlatness,
+                point.scoring.weightSuspicious, point.scoring.decisionThreshold}) {
+                out.push_back(',');
+                appendGeneral(out, value);
+            }
+            for (double value : {point.auc, point.averagePrecision, point.truePositiveRate,
+                point.falsePositiveRate, point.precision, point.f1}) {
+                out.push_back(',');
+                appendFixed(out, value, 4);
+            }
+            out.push_back('\n');
+        }
+    }
+
+    void appendTuningCurveCsv(std::string& out, const std::vector<TuningCurvePoint>& curve) {
+        out.append("threshold,tpr,fpr,precision,recall\n");
+        for (const TuningCurvePoint& point : curve) {
+            appendFixed(out, point.threshold, 4);
+            out.push_back(',');
+            appendFixed(out, point.truePositiveRate, 4);
+            out.push_back(',');
+            appendFixed(out, point.falsePositiveRate, 4);
+            out.push_back(',');
+            appendFixed(out, point.precision, 4);
+            out.push_back(',');
+            appendFixed(out, point.truePositiveRate, 4);
+            out.push_back('\n');
+        }
+    }
+
+    void writeFile(const std::string& filename, const std::string& contents) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+}
+
+FleetReportWriter::FleetReportWriter(const std::string& filename, const Options& options)
+    : options_(options), filename_(filename) {
+    std::error_code error;
+    const bool hasContents = options_.append && std::filesystem::file_size(filename, error) > 0 && !error;
+
+    file_.open(filename, options_.append ? std::ios::app : std::ios::trunc);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    buffer_.reserve(options_.flushBytes + 4096);
+
+    if (options_.format == Format::CSV && !hasContents) {
+        buffer_.append("session,events,total_instances,unique_patterns,top2_concentration,top5_concentration,"
+            "coverage_pattern_count,suspicious_score,final_score,suspected");
+        if (options_.sketchColumns) {
+            buffer_.append(",top2_lower,top5_lower,coverage_lower,coverage_upper,exact");
+        }
+        buffer_.push_back('\n');
+    }
+}
+
+FleetReportWriter::~FleetReportWriter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushLocked();
+}
+
+FleetReportWriter::Format FleetReportWriter::formatFor(const std::string& filename) {
+    const std::string extension = std::filesystem::path(filename).extension().string();
+    return (extension == ".jsonl" || extension == ".ndjson") ? Format::JSON_LINES : Format::CSV;
+}
+
+void FleetReportWriter::write(const SessionResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (options_.format == Format::JSON_LINES) {
+        appendJsonLine(result);
+    }
+    else {
+        appendCsv(result);
+    }
+    sessionsWritten_++;
+    if (buffer_.size() >= options_.flushBytes) {
+        flushLocked();
+    }
+}
+
+void FleetReportWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushLocked();
+}
+
+void FleetReportWriter::flushLocked() {
+    if (buffer_.empty()) {
+        return;
+    }
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.flush();
+    buffer_.clear();
+}
+
+void FleetReportWriter::appendCsv(const SessionResult& result) {
+    using namespace ReportWriter;
+    appendCsvField(buffer_, result.session);
+    buffer_.push_back(',');
+    appendInteger(buffer_, static_cast<long long>(result.events));
+    buffer_.push_back(',');
+    appendInteger(buffer_, result.totalInstances);
+    buffer_.push_back(',');
+    appendInteger(buffer_, static_cast<long long>(result.uniquePatterns));
+    buffer_.push_back(',');
+    appendFixed(buffer_, result.top2Concentration, 2);
+    buffer_.push_back(',');
+    appendFixed(buffer_, result.top5Concentration, 2);
+    buffer_.push_back(',');
+    appendInteger(buffer_, result.coveragePatternCount);
+    buffer_.push_back(',');
+    appendFixed(buffer_, result.suspiciousScore, 2);
+    buffer_.push_back(',');
+    appendFixed(buffer_, result.finalScore, 4);
+    buffer_.append(result.suspected ? ",1" : ",0");
+    if (options_.sketchColumns) {
+        buffer_.push_back(',');
+        appendFixed(buffer_, result.top2Lower, 2);
+        buffer_.push_back(',');
+        appendFixed(buffer_, result.top5Lower, 2);
+        buffer_.push_back(',');
+        appendInteger(buffer_, result.coverageLower);
+        buffer_.push_back(',');
+        appendInteger(buffer_, result.coverageUpper);
+        buffer_.append(result.exact ? ",1" : ",0");
+    }
+    buffer_.push_back('\n');
+}
+
+void FleetReportWriter::appendJsonLine(const SessionResult& result) {
+    using namespace ReportWriter;
+    buffer_.append("{\"session\":");
+    appendJsonString(buffer_, result.session);
+    buffer_.append(",\"events\":");
+    appendInteger(buffer_, static_cast<long long>(result.events));
+    buffer_.append(",\"total_instances\":");
+    appendInteger(buffer_, result.totalInstances);
+    buffer_.append(",\"unique_patterns\":");
+    appendInteger(buffer_, static_cast<long long>(result.uniquePatterns));
+    buffer_.append(",\"top2_concentration\":");
+    appendFixed(buffer_, result.top2Concentration, 2);
+    buffer_.append(",\"top5_concentration\":");
+    appendFixed(buffer_, result.top5Concentration, 2);
+    buffer_.append(",\"coverage_pattern_count\":");
+    appendInteger(buffer_, result.coveragePatternCount);
+    buffer_.append(",\"suspicious_score\":");
+    appendFixed(buffer_, result.suspiciousScore, 2);
+    buffer_.append(",\"final_score\":");
+    appendFixed(buffer_, result.finalScore, 4);
+    buffer_.append(",\"suspected\":").append(result.suspected ? "true" : "false");
+    if (options_.sketchColumns) {
+        buffer_.append(",\"top2_lower\":");
+        appendFixed(buffer_, result.top2Lower, 2);
+        buffer_.append(",\"top5_lower\":");
+        appendFixed(buffer_, result.top5Lower, 2);
+        buffer_.append(",\"coverage_lower\":");
+        appendInteger(buffer_, result.coverageLower);
+        buffer_.append(",\"coverage_upper\":");
+        appendInteger(buffer_, result.coverageUpper);
+        buffer_.append(",\"exact\":").append(result.exact ? "true" : "false");
+    }
+    buffer_.append("}\n");
+}
@@ -0,0 +1,155 @@
+#include "../include/SessionArena.h"
+#include <algorithm>
+#include <new>
+
+SlabPool::SlabPool(size_t slabsPerChunk) : slabsPerChunk_(std::max<size_t>(1, slabsPerChunk)) {
+}
+
+SlabPool::~SlabPool() {
+    for (void* chunk : chunks_) {
+        ::operator delete(chunk);
+    }
+}
+
+void* SlabPool::acquire() {
+    if (!free_) {
+        // 새 청크를 슬랩 단위로 잘라 자유 목록에 연결
+        char* chunk = static_cast<char*>(::operator new(slabsPerChunk_ * SLAB_SIZE));
+        chunks_.push_back(chunk);
+        for (size_t i = slabsPerChunk_; i > 0; --i) {
+            FreeSlab* slab = reinterpret_cast<FreeSlab*>(chunk + (i - 1) * SLAB_SIZE);
+            slab->next = free_;
+            free_ = slab;
+        }
+    }
+    FreeSlab* slab = free_;
+    free_ = slab->next;
+    slabsInUse_++;
+    return slab;
+}
+
+void SlabPool::releaseChain(void* first, void* last, size_t count) {
+    if (!first) {
+        return;
+    }
+    static_cast<FreeSlab*>(last)->next = free_;
+    free_ = static_cast<FreeSlab*>(first);
+    slabsInUse_ -= count;
+}
+
+SessionArena::SessionArena(SlabPool& pool, size_t budgetBytes) : pool_(pool), budgetBytes_(budgetBytes) {
+}
+
+SessionArena::~SessionArena() {
+    release();
+}
+
+void SessionArena::release() {
+    pool_.releaseChain(firstSlab_, lastSlab_, slabCount_);
+    for (const LargeBlock& block : large_) {
+        std::pmr::new_delete_resource()->deallocate(block.pointer, block.bytes, block.alignment);
+    }
+    pool_.removeLargeBytes(largeBytes_);
+
+    free_.fill(nullptr);
+    firstSlab_ = nullptr;
+    lastSlab_ = nullptr;
+    slabCount_ = 0;
+    cursor_ = nullptr;
+    limit_ = nullptr;
+    large_.clear();
+    largeBytes_ = 0;
+    bytesAllocated_ = 0;
+}
+
+size_t SessionArena::classBytes(size_t index) {
+    // 0: 16, 1: 32, 2: 48, 3: 64, 4: 96, 5: 128, ...
+    if (index == 0) {
+        return MIN_BLOCK;
+    }
+    const size_t power = MIN_BLOCK << ((index + 1) / 2);
+    return index % 2 ? power : power + power / 2;
+}
+
+size_t SessionArena::sizeClass(size_t bytes) {
+    size_t index = 0;
+    while (classBytes(index) < bytes) {
+        index++;
+    }
+    return index;
+}
+
+void SessionArena::checkBudget(size_t additionalBytes) const {
+    if (budgetBytes_ > 0 && bytesInUse() + additionalBytes > budgetBytes_) {
+        throw std::bad_alloc();
+    }
+}
+
+void* SessionArena::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes > MAX_SMALL_BLOCK || alignment > MIN_BLOCK) {
+        return allocateLarge(bytes, alignment);
+    }
+
+    const size_t index = sizeClass(bytes);
+    const size_t blockSize = classBytes(index);
+    if (FreeBlock* block = free_[index]) {
+        free_[index] = block->next;
+        bytesAllocated_ += bytes;
+        return block;
+    }
+
+    if (static_cast<size_t>(limit_ - cursor_) < blockSize) {
+        // 남은 공간(MAX_SMALL_BLOCK 미만)은 버리고 새 슬랩으로 이동
+        checkBudget(SlabPool::SLAB_SIZE);
+        char* slab = static_cast<char*>(pool_.acquire());
+        *reinterpret_cast<void**>(slab) = firstSlab_;
+        if (!lastSlab_) {
+            lastSlab_ = slab;
+        }
+        firstSlab_ = slab;
+        slabCount_++;
+        cursor_ = slab + SLAB_HEADER;
+        limit_ = slab + SlabPool::SLAB_SIZE;
+    }
+    void* pointer = cursor_;
+    cursor_ += blockSize;
+    bytesAllocated_ += bytes;
+    return pointer;
+}
+
+void SessionArena::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+    if (bytes > MAX_SMALL_BLOCK || alignment > MIN_BLOCK) {
+        deallocateLarge(pointer);
+        bytesAllocated_ -= bytes;
+        return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    const size_t index = sizeClass(bytes);
+    block->next = free_[index];
+    free_[index] = block;
+    bytesAllocated_ -= bytes;
+}
+
+void* SessionArena::allocateLarge(size_t bytes, size_t alignment) {
+    checkBudget(bytes);
+    large_.reserve(large_.size() + 1);
+    void* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    large_.push_back({pointer, bytes, alignment});
+    largeBytes_ += bytes;
+    bytesAllocated_ += bytes;
+    pool_.addLargeBytes(bytes);
+    return pointer;
+}
+
+void SessionArena::deallocateLarge(void* pointer) {
+    auto it = std::find_if(large_.begin(), large_.end(),
+        [pointer](const LargeBlock& block) { return block.pointer == pointer; });
+    if (it == large_.end()) {
+        return;
+    }
+    std::pmr::new_delete_resource()->deallocate(it->pointer, it->bytes, it->alignment);
+    largeBytes_ -= it->bytes;
+    pool_.removeLargeBytes(it->bytes);
+    *it = large_.back();
+    large_.pop_back();
+}
@@ -0,0 +1,193 @@
+#include "../include/SessionCheckpoint.h"
+#include "../include/BinaryEventLog.h"
+#include "../include/MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using BinaryEventLog::loadLE;
+using BinaryEventLog::storeLE;
+
+namespace {
+    // 임시 파일을 쓰고 디스크까지 내린 뒤 닫음 (교체 전에 내용이 남아 있어야 충돌 후에도 빈 파일이 되지 않음)
+    bool writeDurably(const std::string& filename, const std::string& header, const std::string& body) {
+#ifdef _WIN32
+        int fd = -1;
+        _sopen_s(&fd, filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _SH_DENYWR, _S_IREAD | _S_IWRITE);
+#else
+        const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = true;
+        for (const std::string* part : {&header, &body}) {
+            const char* data = part->data();
+            size_t size = part->size();
+            while (ok && size > 0) {
+#ifdef _WIN32
+                const int written = _write(fd, data, static_cast<unsigned int>(size > 0x40000000 ? 0x40000000 : size));
+#else
+                const ssize_t written = ::write(fd, data, size);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+#endif
+                ok = written > 0;
+                if (ok) {
+                    data += written;
+                    size -= static_cast<size_t>(written);
+                }
+            }
+        }
+#ifdef _WIN32
+        ok = ok && _commit(fd) == 0;
+        ok = _close(fd) == 0 && ok;
+#else
+        ok = ok && ::fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+#endif
+        return ok;
+    }
+
+    // 이름 교체(rename)를 디스크에 반영 (Windows는 디렉터리 핸들을 fsync할 수 없어 생략)
+    void syncDirectory(const fs::path& path) {
+#ifndef _WIN32
+        const fs::path directory = path.has_parent_path() ? path.parent_path() : fs::path(".");
+        const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+#else
+        (void)path;
+#endif
+    }
+}
+
+namespace SessionCheckpoint {
+    void appendRecord(std::string& out, uint64_t sessionId, const StreamingPatternAnalyzer& analyzer) {
+        // 크기 칸을 먼저 비워 두고 스냅샷을 바로 뒤에 씀 (복사 없음)
+        const size_t recordStart = out.size();
+        out.append(RECORD_HEADER_SIZE, '\0');
+        analyzer.saveState(out);
+        uint8_t* header = reinterpret_cast<uint8_t*>(&out[recordStart]);
+        storeLE<uint64_t>(header, sessionId);
+        storeLE<uint32_t>(header + 8, static_cast<uint32_t>(out.size() - recordStart - RECORD_HEADER_SIZE));
+    }
+
+    size_t write(const std::string& filename, const StreamingPatternAnalyzer::Options& options,
+        const std::vector<std::string>& records, uint64_t sessionCount) {
+        // 워커별 묶음을 한 번 이어 붙여 CRC 계산과 기록을 함께 처리
+        std::string body;
+        size_t bodySize = 0;
+        for (const std::string& part : records) {
+            bodySize += part.size();
+        }
+        body.reserve(bodySize);
+        for (const std::string& part : records) {
+            body.append(part);
+        }
+
+        const ExtractionConfig& config = options.extraction;
+        uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        storeLE<uint16_t>(header + 4, VERSION);
+        storeLE<uint16_t>(header + 6, static_cast<uint16_t>(HEADER_SIZE));
+        storeLE<uint32_t>(header + 8, BinaryEventLog::crc32(reinterpret_cast<const uint8_t*>(body.data()), body.size()));
+        storeLE<uint64_t>(header + 16, sessionCount);
+        storeLE<uint64_t>(header + 24, body.size());
+        storeLE<int64_t>(header + 32, options.windowMs);
+        storeLE<int64_t>(header + 40, config.timeThresholdMs);
+        header[48] = static_cast<uint8_t>(config.minLength);
+        header[49] = static_cast<uint8_t>(config.maxLength);
+        for (int word = 0; word < 4; ++word) {
+            storeLE<uint64_t>(header + 56 + word * 8, config.startKeys.words[word]);
+            storeLE<uint64_t>(header + 88 + word * 8, config.coreKeys.words[word]);
+        }
+
+        // 임시 파일을 fsync한 뒤 교체하고, 교체 후 디렉터리도 fsync (충돌 시 이전 체크포인트 또는 새 체크포인트 중 하나가 남음)
+        const std::string temporaryFilename = filename + ".tmp";
+        if (!writeDurably(temporaryFilename, std::string(reinterpret_cast<const char*>(header), HEADER_SIZE), body)) {
+            std::error_code ignored;
+            fs::remove(temporaryFilename, ignored);
+            throw std::runtime_error("Error: Could not write checkpoint " + temporaryFilename);
+        }
+        std::error_code error;
+        fs::rename(temporaryFilename, filename, error);
+        if (error) {
+            fs::remove(temporaryFilename);
+            throw std::runtime_error("Error: Could not replace checkpoint " + filename + " - " + error.message());
+        }
+        syncDirectory(filename);
+        return HEADER_SIZE + body.size();
+    }
+
+    size_t read(const std::string& filename, const StreamingPatternAnalyzer::Options& options,
+        const std::function<void(uint64_t sessionId, const uint8_t* state, size_t stateBytes)>& callback) {
+        if (!fs::exists(filename)) {
+            return 0;
+        }
+        MappedFile file(filename);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+        const size_t size = file.size();
+        if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("Error: Not a session checkpoint " + filename);
+        }
+        const uint16_t version = loadLE<uint16_t>(data + 4);
+        const uint16_t headerSize = loadLE<uint16_t>(data + 6);
+        if (version != VERSION || headerSize < HEADER_SIZE) {
+            throw std::runtime_error("Error: Unsupported session checkpoint version in " + filename);
+        }
+        const uint64_t sessionCount = loadLE<uint64_t>(data + 16);
+        const uint64_t recordsBytes = loadLE<uint64_t>(data + 24);
+        // 헤더 크기는 파일에서 읽은 값이므로 빼기 전에 범위를 확인
+        if (headerSize > size || size - headerSize != recordsBytes) {
+            throw std::runtime_error("Error: Truncated session checkpoint " + filename);
+        }
+        const uint8_t* records = data + headerSize;
+        if (BinaryEventLog::crc32(records, static_cast<size_t>(recordsBytes)) != loadLE<uint32_t>(data + 8)) {
+            throw std::runtime_error("Error: Checksum mismatch in session checkpoint " + filename);
+        }
+
+        const ExtractionConfig& config = options.extraction;
+        bool sameOptions = loadLE<int64_t>(data + 32) == options.windowMs &&
+            loadLE<int64_t>(data + 40) == config.timeThresholdMs &&
+            data[48] == config.minLength && data[49] == config.maxLength;
+        for (int word = 0; word < 4; ++word) {
+            sameOptions = sameOptions && loadLE<uint64_t>(data + 56 + word * 8) == config.startKeys.words[word] &&
+                loadLE<uint64_t>(data + 88 + word * 8) == config.coreKeys.words[word];
+        }
+        if (!sameOptions) {
+            throw std::runtime_error("Error: Window or extraction settings differ from session checkpoint " + filename);
+        }
+
+        const uint8_t* cursor = records;
+        const uint8_t* const end = records + recordsBytes;
+        for (uint64_t i = 0; i < sessionCount; ++i) {
+            if (static_cast<size_t>(end - cursor) < RECORD_HEADER_SIZE) {
+                throw std::runtime_error("Error: Truncated session checkpoint " + filename);
+            }
+            const uint64_t sessionId = loadLE<uint64_t>(cursor);
+            const uint32_t stateBytes = loadLE<uint32_t>(cursor + 8);
+            cursor += RECORD_HEADER_SIZE;
+            if (static_cast<size_t>(end - cursor) < stateBytes) {
+                throw std::runtime_error("Error: Truncated session checkpoint " + filename);
+            }
+            callback(sessionId, cursor, stateBytes);
+            cursor += stateBytes;
+        }
+        return static_cast<size_t>(sessionCount);
+    }
+}
@@ -0,0 +1,152 @@
+#include "../include/SessionClusterer.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    class DisjointSets {
+    public:
+        explicit DisjointSets(size_t count) : parent_(count), size_(count, 1) {
+            std::iota(parent_.begin(), parent_.end(), size_t(0));
+        }
+
+        size_t find(size_t element) {
+            while (parent_[element] != element) {
+                parent_[element] = parent_[parent_[element]];
+                element = parent_[element];
+            }
+            return element;
+        }
+
+        void unite(size_t a, size_t b) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (size_[a] < size_[b]) {
+                std::swap(a, b);
+            }
+            parent_[b] = a;
+            size_[a] += size_[b];
+        }
+
+    private:
+        std::vector<size_t> parent_;
+        std::vector<size_t> size_;
+    };
+
+    uint64_t bandHash(const std::vector<uint32_t>& values, size_t first, size_t rows, size_t band) {
+        uint64_t hash = 0x9E3779B97F4A7C15ULL * (band + 1);
+        for (size_t i = first; i < first + rows; ++i) {
+            hash ^= values[i] + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+}
+
+SessionClusterer::SessionClusterer() : SessionClusterer(Options()) {
+}
+
+SessionClusterer::SessionClusterer(const Options& options) : options_(options) {
+    if (options_.bands == 0) {
+        throw std::invalid_argument("Session clustering needs at least one band");
+    }
+}
+
+std::vector<SessionCluster> SessionClusterer::cluster(const std::vector<const SessionSignature*>& signatures) const {
+    std::vector<size_t> active;
+    size_t hashCount = 0;
+    for (size_t i = 0; i < signatures.size(); ++i) {
+        if (!signatures[i] || signatures[i]->empty()) {
+            continue;
+        }
+        if (hashCount == 0) {
+            hashCount = signatures[i]->size();
+        }
+        else if (signatures[i]->size() != hashCount) {
+            throw std::invalid_argument("Session signatures have different hash counts");
+        }
+        active.push_back(i);
+    }
+    if (active.empty()) {
+        return {};
+    }
+    if (hashCount % options_.bands != 0) {
+        throw std::invalid_argument("Signature hash count must be a multiple of the band count");
+    }
+    const size_t rows = hashCount / options_.bands;
+
+    DisjointSets sets(signatures.size());
+    std::vector<std::pair<uint64_t, size_t>> buckets(active.size());
+    for (size_t band = 0; band < options_.bands; ++band) {
+        for (size_t i = 0; i < active.size(); ++i) {
+            buckets[i] = {bandHash(signatures[active[i]]->values(), band * rows, rows, band), active[i]};
+        }
+        std::sort(buckets.begin(), buckets.end());
+
+        // 같은 구간 해시의 세션은 첫 세션과만 비교 (팜 하나가 한 구간에 몰려도 선형)
+        for (size_t first = 0; first < buckets.size();) {
+            size_t last = first + 1;
+            while (last < buckets.size() && buckets[last].first == buckets[first].first) {
+                last++;
+            }
+            const size_t leader = buckets[first].second;
+            for (size_t i = first + 1; i < last; ++i) {
+                const size_t member = buckets[i].second;
+                if (sets.find(member) != sets.find(leader) &&
+                    signatures[leader]->similarity(*signatures[member]) >= options_.similarityThreshold) {
+                    sets.unite(leader, member);
+                }
+            }
+            first = last;
+        }
+    }
+
+    std::unordered_map<size_t, size_t> clusterOf;
+    std::vector<std::vector<size_t>> groups;
+    for (size_t index : active) {
+        const size_t root = sets.find(index);
+        auto it = clusterOf.find(root);
+        if (it == clusterOf.end()) {
+            it = clusterOf.emplace(root, groups.size()).first;
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(index);
+    }
+
+    std::vector<SessionCluster> clusters;
+    for (std::vector<size_t>& group : groups) {
+        if (group.size() < std::max<size_t>(2, options_.minClusterSize)) {
+            continue;
+        }
+        // 대표: 입력 순서가 가장 빠른 세션
+        const SessionSignature& representative = *signatures[group.front()];
+        std::vector<std::pair<double, size_t>> ranked;
+        ranked.reserve(group.size() - 1);
+        for (size_t i = 1; i < group.size(); ++i) {
+            ranked.emplace_back(representative.similarity(*signatures[group[i]]), group[i]);
+        }
+        std::sort(ranked.begin(), ranked.end(),
+            [](const auto& a, const auto& b) { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+
+        SessionCluster cluster;
+        cluster.members.reserve(group.size());
+        cluster.similarities.reserve(group.size());
+        cluster.members.push_back(group.front());
+        cluster.similarities.push_back(1.0);
+        double similaritySum = 0.0;
+        for (const auto& pair : ranked) {
+            cluster.members.push_back(pair.second);
+            cluster.similarities.push_back(pair.first);
+            similaritySum += pair.first;
+        }
+        cluster.meanSimilarity = similaritySum / ranked.size();
+        clusters.push_back(std::move(cluster));
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+        [](const SessionCluster& a, const SessionCluster& b) { return a.members.size() > b.members.size(); });
+    return clusters;
+}
@@ -0,0 +1,104 @@
+#include "../include/SessionSignature.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+    uint64_t mix64(uint64_t value) {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    // splitmix64 수열의 다음 값을 (0, 1) 구간 실수로
+    double nextUnit(uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ULL;
+        return (static_cast<double>(mix64(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    // 압축할 수 없는 패턴 (VK > 0xFF)의 원소 ID
+    uint64_t patternId(const MicroPattern& pattern) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (const auto& event : pattern) {
+            hash = mix64(hash ^ (static_cast<uint64_t>(event.second) << 1 | (event.first == EventType::KEY_UP ? 1 : 0)));
+        }
+        return hash;
+    }
+}
+
+SessionSignature SessionSignature::fromWeights(const std::vector<std::pair<uint64_t, double>>& weights,
+    size_t hashCount, uint64_t seed) {
+    SessionSignature signature;
+    double totalWeight = 0.0;
+    for (const auto& element : weights) {
+        if (element.second > 0.0) {
+            totalWeight += element.second;
+        }
+    }
+    if (totalWeight <= 0.0 || hashCount == 0) {
+        return signature;
+    }
+
+    std::vector<uint64_t> hashSeeds(hashCount);
+    for (size_t k = 0; k < hashCount; ++k) {
+        hashSeeds[k] = mix64(seed + 0x632BE59BD9B4E019ULL * (k + 1));
+    }
+
+    // ICWS: 칸 k마다 원소별 난수 r, c ~ Gamma(2, 1), beta ~ U(0, 1)를 원소 ID에서 결정적으로 만들고
+    // t = floor(ln w / r + beta), ln a = ln c - r * (t - beta + 1)이 최소인 (원소, t)를 선택
+    std::vector<double> best(hashCount, std::numeric_limits<double>::infinity());
+    signature.values_.assign(hashCount, 0);
+    for (const auto& element : weights) {
+        if (element.second <= 0.0) {
+            continue;
+        }
+        const double logWeight = std::log(element.second / totalWeight);
+        for (size_t k = 0; k < hashCount; ++k) {
+            uint64_t state = element.first ^ hashSeeds[k];
+            const double r = -std::log(nextUnit(state) * nextUnit(state));
+            const double logC = std::log(-std::log(nextUnit(state) * nextUnit(state)));
+            const double beta = nextUnit(state);
+            const double t = std::floor(logWeight / r + beta);
+            const double logA = logC - r * (t - beta + 1.0);
+            if (logA < best[k]) {
+                best[k] = logA;
+                const uint64_t step = static_cast<uint64_t>(static_cast<int64_t>(t));
+                signature.values_[k] = static_cast<uint32_t>(mix64(element.first ^ mix64(step + hashSeeds[k])) >> 32);
+            }
+        }
+    }
+    return signature;
+}
+
+SessionSignature SessionSignature::fromCounter(const PatternCounter& frequencies, size_t hashCount, uint64_t seed) {
+    std::vector<std::pair<uint64_t, double>> weights;
+    weights.reserve(frequencies.size());
+    frequencies.forEachPacked([&](const PatternKey& key, int count) {
+        weights.emplace_back(key.hash(), static_cast<double>(count));
+    });
+    for (const auto& pair : frequencies.overflow()) {
+        weights.emplace_back(patternId(pair.first), static_cast<double>(pair.second));
+    }
+    return fromWeights(weights, hashCount, seed);
+}
+
+SessionSignature SessionSignature::fromSketch(const SpaceSavingSketch& sketch, size_t hashCount, uint64_t seed) {
+    std::vector<std::pair<uint64_t, double>> weights;
+    weights.reserve(sketch.size());
+    for (const SpaceSavingSketch::Counter& counter : sketch.counters()) {
+        weights.emplace_back(counter.key.hash(), static_cast<double>(counter.count));
+    }
+    return fromWeights(weights, hashCount, seed);
+}
+
+double SessionSignature::similarity(const SessionSignature& other) const {
+    if (values_.empty() || values_.size() != other.values_.size()) {
+        return 0.0;
+    }
+    size_t matches = 0;
+    for (size_t k = 0; k < values_.size(); ++k) {
+        if (values_[k] == other.values_[k]) {
+            matches++;
+        }
+    }
+    return static_cast<double>(matches) / values_.size();
+}
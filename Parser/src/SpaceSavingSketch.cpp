@@ -0,0 +1,195 @@
+#include "../include/SpaceSavingSketch.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+SpaceSavingSketch::SpaceSavingSketch(size_t capacity) : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("Sketch capacity must be positive");
+    }
+    counters_.reserve(capacity_);
+    heap_.reserve(capacity_);
+    heapPosition_.reserve(capacity_);
+    index_.reserve(capacity_ * 2);
+}
+
+void SpaceSavingSketch::increment(const PatternKey& key) {
+    totalInstances_++;
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        counters_[it->second].count++;
+        siftDown(heapPosition_[it->second]);
+        return;
+    }
+
+    if (counters_.size() < capacity_) {
+        const size_t counterIndex = counters_.size();
+        counters_.push_back({key, 1, 0});
+        index_.emplace(key, counterIndex);
+        // 새 카운터는 최소값(1)이므로 힙 앞쪽으로 올림
+        heap_.push_back(counterIndex);
+        heapPosition_.push_back(heap_.size() - 1);
+        for (size_t position = heap_.size() - 1; position > 0;) {
+            const size_t parent = (position - 1) / 2;
+            if (counters_[heap_[parent]].count <= counters_[heap_[position]].count) {
+                break;
+            }
+            swapHeap(position, parent);
+            position = parent;
+        }
+        return;
+    }
+
+    // 최소 카운터를 새 패턴으로 교체: error = 이전 최소값
+    const size_t counterIndex = heap_[0];
+    Counter& counter = counters_[counterIndex];
+    index_.erase(counter.key);
+    counter.error = counter.count;
+    counter.count++;
+    counter.key = key;
+    index_.emplace(key, counterIndex);
+    evictions_++;
+    siftDown(0);
+}
+
+long long SpaceSavingSketch::minCount() const {
+    if (counters_.size() < capacity_ && evictions_ == 0) {
+        return 0;
+    }
+    return counters_[heap_[0]].count;
+}
+
+std::vector<SpaceSavingSketch::Counter> SpaceSavingSketch::sortedCounters() const {
+    std::vector<Counter> sorted(counters_);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Counter& a, const Counter& b) { return a.count > b.count; });
+    return sorted;
+}
+
+SketchEstimate SpaceSavingSketch::count(const PatternKey& key) const {
+    SketchEstimate estimate;
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        const Counter& counter = counters_[it->second];
+        estimate.value = static_cast<double>(counter.count);
+        estimate.lower = static_cast<double>(counter.count - counter.error);
+        estimate.upper = static_cast<double>(counter.count);
+    }
+    else {
+        estimate.upper = static_cast<double>(minCount());
+    }
+    return estimate;
+}
+
+SketchEstimate SpaceSavingSketch::topNConcentration(int N) const {
+    SketchEstimate estimate;
+    if (totalInstances_ == 0 || counters_.empty() || N <= 0) {
+        return estimate;
+    }
+
+    std::vector<Counter> sorted = sortedCounters();
+    const size_t limit = std::min(static_cast<size_t>(N), sorted.size());
+
+    // 상한: 모든 패턴의 빈도수 상한 중 상위 N개 합 (추적되지 않은 패턴 상한은 minCount 이하)
+    // 하한: 추적 중인 상위 N개 패턴의 보장 빈도수(count - error) 중 상위 N개 합
+    long long upperSum = 0;
+    std::vector<long long> guaranteed;
+    guaranteed.reserve(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (i < limit) {
+            upperSum += sorted[i].count;
+        }
+        guaranteed.push_back(sorted[i].count - sorted[i].error);
+    }
+    // 압축 불가 패턴은 개별 빈도수를 모르므로 전체를 상한에 더함
+    upperSum += untrackedInstances_;
+    std::partial_sort(guaranteed.begin(), guaranteed.begin() + limit, guaranteed.end(), std::greater<long long>());
+    long long lowerSum = 0;
+    for (size_t i = 0; i < limit; ++i) {
+        lowerSum += guaranteed[i];
+    }
+
+    const double scale = 100.0 / static_cast<double>(totalInstances_);
+    estimate.value = std::min<double>(static_cast<double>(upperSum) * scale, 100.0);
+    estimate.upper = estimate.value;
+    estimate.lower = static_cast<double>(lowerSum) * scale;
+    return estimate;
+}
+
+SketchEstimate SpaceSavingSketch::coveragePatternCount(double coveragePercentage) const {
+    SketchEstimate estimate;
+    if (totalInstances_ == 0 || coveragePercentage <= 0.0) {
+        return estimate;
+    }
+    coveragePercentage = std::min(100.0, coveragePercentage);
+    long long targetCount = static_cast<long long>(totalInstances_ * (coveragePercentage / 100.0));
+    if (targetCount <= 0) {
+        estimate.value = estimate.lower = estimate.upper = 1.0;
+        return estimate;
+    }
+
+    std::vector<Counter> sorted = sortedCounters();
+
+    // 빈도수 상한으로 누적하면 필요한 패턴 수의 하한, 보장 빈도수로 누적하면 상한
+    auto patternsToReach = [&](const std::vector<long long>& counts, long long fill) -> double {
+        long long accumulated = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            accumulated += counts[i];
+            if (accumulated >= targetCount) {
+                return static_cast<double>(i + 1);
+            }
+        }
+        // 추적 목록 밖은 패턴당 최대 fill개로 채운다고 가정 (fill이 0이면 남은 인스턴스가 없으므로 목록 전체)
+        if (fill <= 0) {
+            return static_cast<double>(counts.size());
+        }
+        return static_cast<double>(counts.size() + (targetCount - accumulated + fill - 1) / fill);
+    };
+
+    std::vector<long long> upperCounts;
+    std::vector<long long> lowerCounts;
+    for (const Counter& counter : sorted) {
+        upperCounts.push_back(counter.count);
+        lowerCounts.push_back(counter.count - counter.error);
+    }
+    // 압축 불가 패턴은 개별 빈도수를 모르므로, 하한 쪽에서는 전부 한 패턴이라고 가정하여 상한 목록에 넣음
+    // (축출이 없어 minCount()가 0이어도 목록 합계가 전체 수가 되므로 항상 목표에 도달)
+    if (untrackedInstances_ > 0) {
+        upperCounts.insert(std::upper_bound(upperCounts.begin(), upperCounts.end(), untrackedInstances_,
+            std::greater<long long>()), untrackedInstances_);
+    }
+    std::sort(lowerCounts.begin(), lowerCounts.end(), std::greater<long long>());
+
+    estimate.value = patternsToReach(upperCounts, minCount());
+    estimate.lower = estimate.value;
+    // 보장 빈도수만으로 도달하지 못하면 나머지는 빈도수 1인 패턴으로 채워지는 최악의 경우
+    estimate.upper = patternsToReach(lowerCounts, 1);
+    return estimate;
+}
+
+void SpaceSavingSketch::siftDown(size_t position) {
+    const size_t size = heap_.size();
+    while (true) {
+        const size_t left = position * 2 + 1;
+        const size_t right = left + 1;
+        size_t smallest = position;
+        if (left < size && counters_[heap_[left]].count < counters_[heap_[smallest]].count) {
+            smallest = left;
+        }
+        if (right < size && counters_[heap_[right]].count < counters_[heap_[smallest]].count) {
+            smallest = right;
+        }
+        if (smallest == position) {
+            return;
+        }
+        swapHeap(position, smallest);
+        position = smallest;
+    }
+}
+
+void SpaceSavingSketch::swapHeap(size_t a, size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    heapPosition_[heap_[a]] = a;
+    heapPosition_[heap_[b]] = b;
+}
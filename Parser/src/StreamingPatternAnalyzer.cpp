@@ -0,0 +1,504 @@
+#define NOMINMAX
+#include "../include/StreamingPatternAnalyzer.h"
+#include "../include/Constants.h"
+#include "../include/BinaryEventLog.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <new>
+#include <stdexcept>
+
+using BinaryEventLog::loadLE;
+using BinaryEventLog::storeLE;
+using BinaryEventLog::zigzagDecode;
+using BinaryEventLog::zigzagEncode;
+
+namespace {
+    // 스냅샷 형식 (버전 2, 정수는 varint / 키는 16바이트 리틀 엔디언)
+    //   u8 version | u8 maxLength | zigzag windowMs | u8 flags (1 = 이전 이벤트 있음, 2 = 윈도우 상한, 4 = 축소 모드)
+    //   zigzag lastTimestampNs | eventsProcessed | earlyExpiredInstances | droppedInstances | suspiciousCount
+    //   u8 pendingCount, 접두사마다 key | u8 flags (1 = packable, 2 = containsCoreKey)
+    //   u8 recentCount, 최근 이벤트마다 u8 keyUp | keyCode
+    //   distinctPatterns, 순위 순서대로 key | count
+    //   windowCapacity | windowSize, 오래된 인스턴스부터 (rank << 1 | suspicious) | zigzag(직전 인스턴스와의 시간차)
+    constexpr uint8_t STATE_VERSION = 2;
+    constexpr size_t KEY_BYTES = 16;
+
+    void appendVarint(std::string& out, uint64_t value) {
+        uint8_t buffer[10];
+        const uint8_t* end = BinaryEventLog::writeVarint(buffer, value);
+        out.append(reinterpret_cast<const char*>(buffer), static_cast<size_t>(end - buffer));
+    }
+
+    void appendKey(std::string& out, const PatternKey& key) {
+        uint8_t buffer[KEY_BYTES];
+        storeLE<uint64_t>(buffer, key.lo);
+        storeLE<uint64_t>(buffer + 8, key.hi);
+        out.append(reinterpret_cast<const char*>(buffer), KEY_BYTES);
+    }
+
+    [[noreturn]] void corruptSnapshot() {
+        throw std::runtime_error("Error: Corrupt analyzer snapshot");
+    }
+
+    // 범위를 벗어나면 corruptSnapshot()
+    class StateReader {
+    public:
+        StateReader(const uint8_t* data, size_t size) : cursor_(data), end_(data + size) {}
+
+        size_t remaining() const { return static_cast<size_t>(end_ - cursor_); }
+
+        uint8_t byte() {
+            if (cursor_ == end_) {
+                corruptSnapshot();
+            }
+            return *cursor_++;
+        }
+
+        uint64_t varint() {
+            uint64_t value;
+            cursor_ = BinaryEventLog::readVarint(cursor_, end_, value);
+            if (cursor_ == nullptr) {
+                corruptSnapshot();
+            }
+            return value;
+        }
+
+        PatternKey key() {
+            if (remaining() < KEY_BYTES) {
+                corruptSnapshot();
+            }
+            PatternKey key;
+            key.lo = loadLE<uint64_t>(cursor_);
+            key.hi = loadLE<uint64_t>(cursor_ + 8);
+            cursor_ += KEY_BYTES;
+            return key;
+        }
+
+    private:
+        const uint8_t* cursor_;
+        const uint8_t* end_;
+    };
+}
+
+StreamingPatternAnalyzer::StreamingPatternAnalyzer() : StreamingPatternAnalyzer(Options()) {
+}
+
+StreamingPatternAnalyzer::StreamingPatternAnalyzer(const Options& options, std::pmr::memory_resource* memory)
+    : options_(options), gapLimit_(options.extraction.timeThresholdMs), counts_(memory), window_(memory) {
+    if (options_.extraction.maxLength > PatternKey::MAX_LENGTH) {
+        throw std::invalid_argument("Streaming analysis supports at most 8 events per pattern");
+    }
+}
+
+void StreamingPatternAnalyzer::setSuspiciousPatterns(const std::set<MicroPattern>& suspiciousPatterns) {
+    setSuspiciousMatcher(std::make_shared<const SuspiciousPatternMatcher>(suspiciousPatterns, options_.extraction));
+}
+
+void StreamingPatternAnalyzer::setSuspiciousMatcher(std::shared_ptr<const SuspiciousPatternMatcher> matcher) {
+    matcher_ = std::move(matcher);
+    restoreMatchState();
+
+    // 현재 윈도우 기준으로 다시 계산
+    suspiciousCount_ = 0;
+    for (size_t i = 0; i < windowSize_; ++i) {
+        Instance& instance = window_[windowIndex(i)];
+        instance.suspicious = matcher_ && matcher_->contains(instance.key) ? 1 : 0;
+        if (instance.suspicious) {
+            suspiciousCount_++;
+        }
+    }
+}
+
+void StreamingPatternAnalyzer::restoreMatchState() {
+    // 패턴 길이가 maxLength 이하이므로 최근 maxLength개 이전의 이벤트는 상태에 영향 없음
+    matchState_ = SuspiciousPatternMatcher::ROOT;
+    if (matcher_) {
+        const size_t capacity = recent_.size();
+        const size_t available = std::min(recentCount_, capacity);
+        for (size_t i = recentCount_ - available; i < recentCount_; ++i) {
+            const RecentEvent& event = recent_[i % capacity];
+            matchState_ = matcher_->next(matchState_, event.type, event.keyCode);
+        }
+    }
+}
+
+void StreamingPatternAnalyzer::addEvent(const InputEvent& event) {
+    const long long timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        event.timestamp.time_since_epoch()).count();
+    const ExtractionConfig& config = options_.extraction;
+
+    // 간격이 임계값을 넘으면 대기 중인 패턴은 모두 무효
+    if (hasLastEvent_ && !gapLimit_.within(lastEvent_, event)) {
+        pendingCount_ = 0;
+        matchState_ = SuspiciousPatternMatcher::ROOT;
+        recentCount_ = 0;
+    }
+    hasLastEvent_ = true;
+    lastEvent_ = event;
+    eventsProcessed_++;
+
+    recent_[recentCount_++ % recent_.size()] = {event.type, event.keyCode};
+    uint64_t matchedLengths = 0;
+    if (matcher_) {
+        matchState_ = matcher_->next(matchState_, event.type, event.keyCode);
+        matchedLengths = matcher_->matchedLengths(matchState_);
+    }
+
+    if (event.type == EventType::KEY_DOWN && config.startKeys.contains(event.keyCode)) {
+        pending_[pendingCount_++] = {PatternKey(), true, false};
+    }
+
+    const bool packable = PatternKey::canEncode(event.keyCode);
+    const bool isCoreKey = config.coreKeys.contains(event.keyCode);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < pendingCount_; ++i) {
+        PendingPattern pattern = pending_[i];
+        if (packable) {
+            pattern.key.push(event.type, event.keyCode);
+        }
+        else {
+            pattern.packable = false;
+        }
+        pattern.containsCoreKey = pattern.containsCoreKey || isCoreKey;
+
+        const int length = pattern.key.length();
+        if (pattern.packable && pattern.containsCoreKey && length >= config.minLength) {
+            countPattern(pattern.key, timestampMs, ((matchedLengths >> (length - 1)) & 1) != 0);
+        }
+        if (pattern.packable && length < config.maxLength) {
+            pending_[kept++] = pattern;
+        }
+    }
+    pendingCount_ = kept;
+
+    expire(timestampMs);
+}
+
+void StreamingPatternAnalyzer::reset() {
+    pendingCount_ = 0;
+    matchState_ = SuspiciousPatternMatcher::ROOT;
+    recentCount_ = 0;
+    hasLastEvent_ = false;
+    lastEvent_ = {};
+    eventsProcessed_ = 0;
+    counts_.clear();
+    windowHead_ = 0;
+    windowSize_ = 0;
+    windowCapped_ = false;
+    degraded_ = false;
+    earlyExpiredInstances_ = 0;
+    droppedInstances_ = 0;
+    suspiciousCount_ = 0;
+}
+
+void StreamingPatternAnalyzer::saveState(std::string& out) const {
+    out.push_back(static_cast<char>(STATE_VERSION));
+    out.push_back(static_cast<char>(options_.extraction.maxLength));
+    appendVarint(out, zigzagEncode(options_.windowMs));
+    out.push_back(static_cast<char>((hasLastEvent_ ? 1 : 0) | (windowCapped_ ? 2 : 0) | (degraded_ ? 4 : 0)));
+    appendVarint(out, zigzagEncode(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        lastEvent_.timestamp.time_since_epoch()).count()));
+    appendVarint(out, static_cast<uint64_t>(eventsProcessed_));
+    appendVarint(out, static_cast<uint64_t>(earlyExpiredInstances_));
+    appendVarint(out, static_cast<uint64_t>(droppedInstances_));
+    appendVarint(out, static_cast<uint64_t>(suspiciousCount_));
+
+    out.push_back(static_cast<char>(pendingCount_));
+    for (size_t i = 0; i < pendingCount_; ++i) {
+        appendKey(out, pending_[i].key);
+        out.push_back(static_cast<char>((pending_[i].packable ? 1 : 0) | (pending_[i].containsCoreKey ? 2 : 0)));
+    }
+
+    // 오래된 것부터 (복원 후 recent_[i % capacity] 위치가 그대로 유지되도록 개수만큼만)
+    const size_t capacity = recent_.size();
+    const size_t available = std::min(recentCount_, capacity);
+    out.push_back(static_cast<char>(available));
+    for (size_t i = recentCount_ - available; i < recentCount_; ++i) {
+        const RecentEvent& event = recent_[i % capacity];
+        out.push_back(static_cast<char>(event.type == EventType::KEY_UP ? 1 : 0));
+        appendVarint(out, event.keyCode);
+    }
+
+    // 같은 빈도수끼리의 순서도 순위 배열 그대로 (topPatterns 결과가 이어서 받은 경우와 같도록)
+    appendVarint(out, counts_.size());
+    for (size_t rank = 0; rank < counts_.size(); ++rank) {
+        appendKey(out, counts_.keyAt(rank));
+        appendVarint(out, static_cast<uint64_t>(counts_.countAt(rank)));
+    }
+
+    // 윈도우 인스턴스의 키는 모두 빈도수 목록에 있으므로 순위 번호로 저장
+    appendVarint(out, window_.size());
+    appendVarint(out, windowSize_);
+    long long previousMs = 0;
+    for (size_t i = 0; i < windowSize_; ++i) {
+        const Instance& instance = window_[windowIndex(i)];
+        appendVarint(out, (static_cast<uint64_t>(counts_.rank(instance.key)) << 1) | (instance.suspicious ? 1 : 0));
+        appendVarint(out, zigzagEncode(instance.timestampMs - previousMs));
+        previousMs = instance.timestampMs;
+    }
+}
+
+void StreamingPatternAnalyzer::loadState(const uint8_t* data, size_t size) {
+    reset();
+    try {
+        readState(data, size);
+    }
+    catch (...) {
+        reset();
+        throw;
+    }
+    restoreMatchState();
+}
+
+void StreamingPatternAnalyzer::readState(const uint8_t* data, size_t size) {
+    StateReader reader(data, size);
+    const uint8_t version = reader.byte();
+    if (version != STATE_VERSION) {
+        throw std::runtime_error("Error: Unsupported analyzer snapshot version");
+    }
+    const int maxLength = reader.byte();
+    const long long windowMs = zigzagDecode(reader.varint());
+    if (maxLength != options_.extraction.maxLength || windowMs != options_.windowMs) {
+        throw std::runtime_error("Error: Analyzer snapshot was taken with different window or pattern length");
+    }
+    const uint8_t flags = reader.byte();
+    hasLastEvent_ = (flags & 1) != 0;
+    windowCapped_ = (flags & 2) != 0;
+    degraded_ = (flags & 4) != 0;
+    const std::chrono::nanoseconds sinceEpoch(zigzagDecode(reader.varint()));
+    lastEvent_.timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
+        std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(sinceEpoch));
+    eventsProcessed_ = static_cast<long long>(reader.varint());
+    earlyExpiredInstances_ = static_cast<long long>(reader.varint());
+    droppedInstances_ = static_cast<long long>(reader.varint());
+    const long long suspiciousCount = static_cast<long long>(reader.varint());
+
+    const size_t pendingCount = reader.byte();
+    if (pendingCount > pending_.size()) {
+        corruptSnapshot();
+    }
+    for (size_t i = 0; i < pendingCount; ++i) {
+        PendingPattern& pattern = pending_[i];
+        pattern.key = reader.key();
+        const uint8_t patternFlags = reader.byte();
+        pattern.packable = (patternFlags & 1) != 0;
+        pattern.containsCoreKey = (patternFlags & 2) != 0;
+        if (pattern.key.length() >= maxLength) {
+            corruptSnapshot();
+        }
+    }
+    pendingCount_ = pendingCount;
+
+    const size_t recentCount = reader.byte();
+    if (recentCount > recent_.size()) {
+        corruptSnapshot();
+    }
+    for (size_t i = 0; i < recentCount; ++i) {
+        const EventType type = reader.byte() ? EventType::KEY_UP : EventType::KEY_DOWN;
+        const uint64_t keyCode = reader.varint();
+        if (keyCode > UINT_MAX) {
+            corruptSnapshot();
+        }
+        recent_[i] = {type, static_cast<unsigned int>(keyCode)};
+    }
+    recentCount_ = recentCount;
+
+    const uint64_t distinct = reader.varint();
+    if (distinct > reader.remaining() / (KEY_BYTES + 1)) {
+        corruptSnapshot();
+    }
+    for (uint64_t rank = 0; rank < distinct; ++rank) {
+        const PatternKey key = reader.key();
+        const uint64_t count = reader.varint();
+        if (count > INT_MAX || !counts_.appendRanked(key, static_cast<int>(count))) {
+            corruptSnapshot();
+        }
+    }
+
+    const uint64_t capacity = reader.varint();
+    const uint64_t windowSize = reader.varint();
+    const bool windowed = options_.windowMs > 0;
+    if (windowSize > capacity || windowSize > reader.remaining() / 2 || (!windowed && capacity != 0)) {
+        corruptSnapshot();
+    }
+    if (capacity != window_.size()) {
+        // 축소 모드의 조기 만료 시점이 같도록 용량도 그대로
+        std::pmr::vector<Instance> window(static_cast<size_t>(capacity), Instance(), window_.get_allocator());
+        window_.swap(window);
+    }
+    // 윈도우 모드에서는 빈도수 = 윈도우 안 인스턴스 수이므로 서로 맞는지 확인
+    std::vector<int> occurrences(windowed ? counts_.size() : 0, 0);
+    long long previousMs = 0;
+    long long suspiciousInstances = 0;
+    for (uint64_t i = 0; i < windowSize; ++i) {
+        const uint64_t code = reader.varint();
+        const uint64_t rank = code >> 1;
+        if (rank >= counts_.size()) {
+            corruptSnapshot();
+        }
+        Instance& instance = window_[static_cast<size_t>(i)];
+        instance.key = counts_.keyAt(static_cast<size_t>(rank));
+        instance.timestampMs = previousMs + zigzagDecode(reader.varint());
+        instance.suspicious = (code & 1) ? 1 : 0;
+        previousMs = instance.timestampMs;
+        occurrences[static_cast<size_t>(rank)]++;
+        suspiciousInstances += code & 1;
+    }
+    windowSize_ = static_cast<size_t>(windowSize);
+    if (reader.remaining() != 0) {
+        corruptSnapshot();
+    }
+    if (windowed) {
+        if (suspiciousInstances != suspiciousCount) {
+            corruptSnapshot();
+        }
+        for (size_t rank = 0; rank < occurrences.size(); ++rank) {
+            if (occurrences[rank] != counts_.countAt(rank)) {
+                corruptSnapshot();
+            }
+        }
+    }
+    suspiciousCount_ = suspiciousCount;
+}
+
+void StreamingPatternAnalyzer::countPattern(const PatternKey& key, long long timestampMs, bool suspicious) {
+    const bool windowed = options_.windowMs > 0;
+    if (windowed && !reserveWindowSlot()) {
+        droppedInstances_++;
+        return;
+    }
+    while (true) {
+        try {
+            counts_.increment(key);
+            break;
+        }
+        catch (const std::bad_alloc&) {
+            degraded_ = true;
+            if (windowSize_ == 0) {
+                droppedInstances_++;
+                return;
+            }
+            // 오래된 인스턴스를 만료하여 빈도수가 0이 된 패턴의 자리를 재사용
+            expireOldest(std::max<size_t>(1, windowSize_ / 8));
+        }
+    }
+    if (suspicious) {
+        suspiciousCount_++;
+    }
+    if (windowed) {
+        Instance& instance = window_[windowIndex(windowSize_++)];
+        instance.key = key;
+        instance.timestampMs = timestampMs;
+        instance.suspicious = suspicious ? 1 : 0;
+    }
+}
+
+bool StreamingPatternAnalyzer::reserveWindowSlot() {
+    if (windowSize_ < window_.size()) {
+        return true;
+    }
+    if (!windowCapped_) {
+        try {
+            growWindow();
+            return true;
+        }
+        catch (const std::bad_alloc&) {
+            windowCapped_ = true;
+            degraded_ = true;
+        }
+    }
+    if (windowSize_ == 0) {
+        return false;
+    }
+    expireOldest(1);
+    return true;
+}
+
+void StreamingPatternAnalyzer::growWindow() {
+    // 2배 대신 1.5배로 늘려 윈도우 크기 대비 남는 칸을 줄임
+    const size_t capacity = window_.empty() ? 64 : window_.size() + window_.size() / 2;
+    std::pmr::vector<Instance> grown(capacity, Instance(), window_.get_allocator());
+    for (size_t i = 0; i < windowSize_; ++i) {
+        grown[i] = window_[windowIndex(i)];
+    }
+    window_.swap(grown);
+    windowHead_ = 0;
+}
+
+void StreamingPatternAnalyzer::popOldest() {
+    const Instance& oldest = window_[windowHead_];
+    counts_.decrement(oldest.key);
+    if (oldest.suspicious) {
+        suspiciousCount_--;
+    }
+    windowHead_ = windowIndex(1);
+    windowSize_--;
+}
+
+void StreamingPatternAnalyzer::expireOldest(size_t count) {
+    for (size_t i = 0; i < count && windowSize_ > 0; ++i) {
+        popOldest();
+        earlyExpiredInstances_++;
+    }
+}
+
+void StreamingPatternAnalyzer::expire(long long nowMs) {
+    if (options_.windowMs <= 0) {
+        return;
+    }
+    while (windowSize_ > 0 && nowMs - window_[windowHead_].timestampMs > options_.windowMs) {
+        popOldest();
+    }
+}
+
+double StreamingPatternAnalyzer::topNConcentration(int N) const {
+    const long long totalInstances = counts_.totalInstances();
+    if (totalInstances == 0 || N <= 0) {
+        return 0.0;
+    }
+    return (static_cast<double>(counts_.topNCount(N)) / totalInstances) * 100.0;
+}
+
+// PatternAnalyzer::calculateCoveragePatternCount와 동일한 규칙
+int StreamingPatternAnalyzer::coveragePatternCount(double coveragePercentage) const {
+    const long long totalInstances = counts_.totalInstances();
+    if (totalInstances == 0 || coveragePercentage <= 0.0) {
+        return 0;
+    }
+    coveragePercentage = std::min(100.0, coveragePercentage);
+
+    long long targetCount = static_cast<long long>(totalInstances * (coveragePercentage / 100.0));
+    if (targetCount <= 0) {
+        return 1;
+    }
+    return counts_.patternsToReach(targetCount);
+}
+
+double StreamingPatternAnalyzer::suspiciousScore() const {
+    const long long totalInstances = counts_.totalInstances();
+    if (totalInstances == 0) {
+        return 0.0;
+    }
+    return (static_cast<double>(suspiciousCount_) / totalInstances) * 100.0;
+}
+
+double StreamingPatternAnalyzer::botSuspicionScore() const {
+    return PatternAnalyzer::calculateBotSuspicionScore(
+        topNConcentration(2), topNConcentration(5), coveragePatternCount(50.0), suspiciousScore());
+}
+
+bool StreamingPatternAnalyzer::isBotSuspected() const {
+    return PatternAnalyzer::isBotSuspected(botSuspicionScore());
+}
+
+std::vector<PatternCountPair> StreamingPatternAnalyzer::topPatterns(int N) const {
+    std::vector<PatternCountPair> top;
+    const size_t limit = std::min(static_cast<size_t>(std::max(N, 0)), counts_.size());
+    top.reserve(limit);
+    for (size_t rank = 0; rank < limit; ++rank) {
+        top.emplace_back(counts_.keyAt(rank).toMicroPattern(), counts_.countAt(rank));
+    }
+    return top;
+}
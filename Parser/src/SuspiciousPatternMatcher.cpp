@@ -0,0 +1,199 @@
+#include "../include/SuspiciousPatternMatcher.h"
+#include "../include/ExtractionKernel.h"
+#include <bitset>
+#include <deque>
+#include <stdexcept>
+
+namespace {
+    size_t edgeHash(uint64_t key) {
+        uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    const size_t kRootTableSize = 512; // (VK <= 0xFF) x (DOWN, UP)
+}
+
+SuspiciousPatternMatcher::SuspiciousPatternMatcher() : SuspiciousPatternMatcher(std::set<MicroPattern>()) {
+}
+
+SuspiciousPatternMatcher::SuspiciousPatternMatcher(const std::set<MicroPattern>& patterns, const ExtractionConfig& config)
+    : config_(config), rootTransitions_(kRootTableSize, ROOT), edges_(1024), edgeMask_(edges_.size() - 1) {
+    if (config_.maxLength > MAX_PATTERN_LENGTH) {
+        throw std::invalid_argument("Suspicious pattern matcher supports at most 64 events per pattern");
+    }
+
+    fail_.push_back(ROOT);
+    outputs_.push_back(0);
+
+    // 트라이 구성 (BFS용 자식 목록은 구성 중에만 유지)
+    std::vector<std::vector<std::pair<uint32_t, NodeId>>> children(1);
+    for (const MicroPattern& pattern : patterns) {
+        if (!accepts(pattern)) {
+            skippedPatterns_++;
+            continue;
+        }
+        NodeId node = ROOT;
+        for (const auto& eventPair : pattern) {
+            const uint32_t symbol = symbolOf(eventPair.first, eventPair.second);
+            NodeId child = findChild(node, symbol);
+            if (child == ROOT) {
+                child = addChild(node, symbol);
+                children.emplace_back();
+                children[node].push_back({symbol, child});
+            }
+            node = child;
+        }
+        outputs_[node] |= uint64_t(1) << (pattern.size() - 1);
+        patternCount_++;
+    }
+
+    buildFailureLinks(children);
+}
+
+bool SuspiciousPatternMatcher::accepts(const MicroPattern& pattern) const {
+    const int length = static_cast<int>(pattern.size());
+    if (length == 0 || length < config_.minLength || length > config_.maxLength) {
+        return false;
+    }
+    if (pattern[0].first != EventType::KEY_DOWN || !config_.startKeys.contains(pattern[0].second)) {
+        return false;
+    }
+    for (const auto& eventPair : pattern) {
+        if (config_.coreKeys.contains(eventPair.second)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SuspiciousPatternMatcher::NodeId SuspiciousPatternMatcher::findChild(NodeId node, uint32_t symbol) const {
+    if (node == ROOT && symbol < kRootTableSize) {
+        return rootTransitions_[symbol];
+    }
+    const uint64_t key = edgeKey(node, symbol);
+    for (size_t index = edgeHash(key) & edgeMask_; edges_[index].child != ROOT; index = (index + 1) & edgeMask_) {
+        if (edges_[index].key == key) {
+            return edges_[index].child;
+        }
+    }
+    return ROOT;
+}
+
+SuspiciousPatternMatcher::NodeId SuspiciousPatternMatcher::addChild(NodeId node, uint32_t symbol) {
+    const NodeId child = static_cast<NodeId>(fail_.size());
+    fail_.push_back(ROOT);
+    outputs_.push_back(0);
+
+    if (node == ROOT && symbol < kRootTableSize) {
+        rootTransitions_[symbol] = child;
+        return child;
+    }
+    if ((edgeCount_ + 1) * 2 > edges_.size()) {
+        std::vector<Edge> oldEdges(edges_.size() * 2);
+        oldEdges.swap(edges_);
+        edgeMask_ = edges_.size() - 1;
+        edgeCount_ = 0;
+        for (const Edge& edge : oldEdges) {
+            if (edge.child != ROOT) {
+                insertEdge(edge.key, edge.child);
+            }
+        }
+    }
+    insertEdge(edgeKey(node, symbol), child);
+    return child;
+}
+
+void SuspiciousPatternMatcher::insertEdge(uint64_t key, NodeId child) {
+    size_t index = edgeHash(key) & edgeMask_;
+    while (edges_[index].child != ROOT) {
+        index = (index + 1) & edgeMask_;
+    }
+    edges_[index] = {key, child};
+    edgeCount_++;
+}
+
+void SuspiciousPatternMatcher::buildFailureLinks(const std::vector<std::vector<std::pair<uint32_t, NodeId>>>& children) {
+    // BFS 순서로 실패 링크와 출력(자신 | 실패 노드의 출력) 계산
+    std::deque<NodeId> queue;
+    for (const auto& edge : children[ROOT]) {
+        fail_[edge.second] = ROOT;
+        queue.push_back(edge.second);
+    }
+    while (!queue.empty()) {
+        const NodeId node = queue.front();
+        queue.pop_front();
+        for (const auto& edge : children[node]) {
+            const uint32_t symbol = edge.first;
+            const NodeId child = edge.second;
+
+            NodeId fallback = fail_[node];
+            NodeId target = findChild(fallback, symbol);
+            while (target == ROOT && fallback != ROOT) {
+                fallback = fail_[fallback];
+                target = findChild(fallback, symbol);
+            }
+            fail_[child] = target;
+            outputs_[child] |= outputs_[target];
+            queue.push_back(child);
+        }
+    }
+}
+
+SuspiciousPatternMatcher::NodeId SuspiciousPatternMatcher::next(NodeId state, EventType type, unsigned int keyCode) const {
+    const uint32_t symbol = symbolOf(type, keyCode);
+    while (true) {
+        const NodeId child = findChild(state, symbol);
+        if (child != ROOT || state == ROOT) {
+            return child;
+        }
+        state = fail_[state];
+    }
+}
+
+int SuspiciousPatternMatcher::matchCount(NodeId state) const {
+    return static_cast<int>(std::bitset<64>(outputs_[state]).count());
+}
+
+bool SuspiciousPatternMatcher::contains(const MicroPattern& pattern) const {
+    if (pattern.empty() || pattern.size() > static_cast<size_t>(MAX_PATTERN_LENGTH)) {
+        return false;
+    }
+    NodeId node = ROOT;
+    for (const auto& eventPair : pattern) {
+        node = findChild(node, symbolOf(eventPair.first, eventPair.second));
+        if (node == ROOT) {
+            return false;
+        }
+    }
+    return ((outputs_[node] >> (pattern.size() - 1)) & 1) != 0;
+}
+
+bool SuspiciousPatternMatcher::contains(const PatternKey& key) const {
+    NodeId node = ROOT;
+    for (int i = 0; i < key.length(); ++i) {
+        node = findChild(node, symbolOf(key.typeAt(i), key.keyCodeAt(i)));
+        if (node == ROOT) {
+            return false;
+        }
+    }
+    return !key.empty() && ((outputs_[node] >> (key.length() - 1)) & 1) != 0;
+}
+
+long long SuspiciousPatternMatcher::countMatches(const std::vector<InputEvent>& events) const {
+    if (empty()) {
+        return 0;
+    }
+    const ExtractionKernel::GapLimit gapLimit(config_.timeThresholdMs);
+    long long matches = 0;
+    NodeId state = ROOT;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (i > 0 && !gapLimit.within(events[i - 1], events[i])) {
+            state = ROOT;
+        }
+        state = next(state, events[i].type, events[i].keyCode);
+        if (outputs_[state] != 0) {
+            matches += matchCount(state);
+        }
+    }
+    return matches;
+}
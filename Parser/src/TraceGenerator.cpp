@@ -0,0 +1,159 @@
+#include "../include/TraceGenerator.h"
+#include "../include/Constants.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+    // 공격/스킬 키 (Constants::patternStartKeys 외의 행동 키)
+    const unsigned int kActionKeys[] = { 'A', 'C', 'Z', 'X', 'S', 'D', VK_SPACE, VK_LCONTROL };
+    const size_t kActionKeyCount = sizeof(kActionKeys) / sizeof(kActionKeys[0]);
+    // 사람이 선호하는 공격키 가중치 (앞쪽일수록 자주 사용)
+    const double kHumanKeyWeights[] = { 40.0, 18.0, 8.0, 4.0, 2.0, 1.0, 1.0, 0.5 };
+    const unsigned int kMoveKeys[] = { VK_LEFT, VK_RIGHT, VK_UP, VK_DOWN };
+}
+
+TraceGenerator::TraceGenerator(const Options& options)
+    : options_(options), random_(options.seed), timestampMs_(options.startTimestampMs) {
+}
+
+bool TraceGenerator::parseProfile(const std::string& name, Profile& profile) {
+    if (name == "bot") {
+        profile = Profile::BOT;
+        return true;
+    }
+    if (name == "human") {
+        profile = Profile::HUMAN;
+        return true;
+    }
+    return false;
+}
+
+void TraceGenerator::queuePress(unsigned int keyCode, bool keyUpFirst, long long holdMs) {
+    if (keyUpFirst) {
+        pending_.push_back({0, EventType::KEY_UP, keyCode});
+        pending_.push_back({holdMs, EventType::KEY_DOWN, keyCode});
+    }
+    else {
+        pending_.push_back({0, EventType::KEY_DOWN, keyCode});
+        pending_.push_back({holdMs, EventType::KEY_UP, keyCode});
+    }
+}
+
+void TraceGenerator::queueBotAction() {
+    // press(alt) press(alt) press(공격키): 각 press의 down/up 순서를 무작위로 바꾸고 간격은 균등 분포
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::uniform_int_distribution<size_t> keyIndex(0, kActionKeyCount - 1);
+    std::uniform_int_distribution<long long> hold(30, 80);
+    std::uniform_int_distribution<long long> between(40, 120);
+    std::uniform_int_distribution<long long> idle(350, 700);
+
+    const size_t first = pending_.size();
+    queuePress(VK_LMENU, coin(random_) == 1, hold(random_));
+    queuePress(VK_LMENU, coin(random_) == 1, hold(random_));
+    queuePress(kActionKeys[keyIndex(random_)], coin(random_) == 1, hold(random_));
+    pending_[first].delayMs = idle(random_);
+    pending_[first + 2].delayMs = between(random_);
+    pending_[first + 4].delayMs = between(random_);
+
+    // 가끔 이동키 입력 (패턴에는 포함되지 않음)
+    if (std::uniform_int_distribution<int>(0, 9)(random_) == 0) {
+        const unsigned int moveKey = kMoveKeys[std::uniform_int_distribution<size_t>(0, 3)(random_)];
+        queuePress(moveKey, false, hold(random_));
+        pending_[pending_.size() - 2].delayMs = idle(random_);
+    }
+}
+
+long long TraceGenerator::humanDelay(double meanMs, double jitterMs) {
+    std::normal_distribution<double> delay(meanMs, jitterMs);
+    return std::max(5LL, static_cast<long long>(delay(random_)));
+}
+
+void TraceGenerator::queueHumanAction() {
+    std::discrete_distribution<size_t> keyIndex(std::begin(kHumanKeyWeights), std::end(kHumanKeyWeights));
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    const size_t first = pending_.size();
+    queuePress(VK_LMENU, false, humanDelay(70.0, 15.0));
+    queuePress(VK_LMENU, false, humanDelay(65.0, 15.0));
+    queuePress(kActionKeys[keyIndex(random_)], false, humanDelay(90.0, 25.0));
+    pending_[first + 2].delayMs = humanDelay(80.0, 25.0);
+    pending_[first + 4].delayMs = humanDelay(90.0, 30.0);
+
+    // 습관적인 겹침: 두 번째 alt를 떼기 전에 공격키를 누름
+    if (uniform(random_) < 0.15) {
+        std::swap(pending_[first + 3].type, pending_[first + 4].type);
+        std::swap(pending_[first + 3].keyCode, pending_[first + 4].keyCode);
+    }
+
+    // 행동 사이 간격: 대부분 짧은 리듬, 가끔 긴 휴식
+    if (uniform(random_) < 0.03) {
+        pending_[first].delayMs = humanDelay(3000.0, 1500.0);
+    }
+    else {
+        pending_[first].delayMs = humanDelay(450.0, 150.0);
+    }
+
+    if (uniform(random_) < 0.2) {
+        const unsigned int moveKey = kMoveKeys[std::uniform_int_distribution<size_t>(0, 3)(random_)];
+        queuePress(moveKey, false, humanDelay(200.0, 80.0));
+        pending_[pending_.size() - 2].delayMs = humanDelay(250.0, 100.0);
+    }
+}
+
+void TraceGenerator::generate(size_t count, std::vector<InputEvent>& events) {
+    events.reserve(events.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        if (pending_.empty()) {
+            if (options_.profile == Profile::BOT) {
+                queueBotAction();
+            }
+            else {
+                queueHumanAction();
+            }
+        }
+        const PendingEvent next = pending_.front();
+        pending_.pop_front();
+        timestampMs_ += next.delayMs;
+
+        InputEvent event;
+        event.timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>(
+            std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                std::chrono::milliseconds(timestampMs_)));
+        event.type = next.type;
+        event.keyCode = next.keyCode;
+        events.push_back(event);
+    }
+}
+
+std::vector<InputEvent> TraceGenerator::generate(size_t count) {
+    std::vector<InputEvent> events;
+    generate(count, events);
+    return events;
+}
+
+void TraceGenerator::writeCsv(const std::string& filename, size_t count) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+
+    const size_t chunkEvents = 1 << 16;
+    std::vector<InputEvent> events;
+    std::string buffer = "Timestamp,EventType,KeyCode\n";
+    for (size_t written = 0; written < count;) {
+        const size_t chunk = std::min(chunkEvents, count - written);
+        events.clear();
+        generate(chunk, events);
+        for (const InputEvent& event : events) {
+            buffer += std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                event.timestamp.time_since_epoch()).count());
+            buffer += event.type == EventType::KEY_DOWN ? ",KEY_DOWN," : ",KEY_UP,";
+            buffer += std::to_string(event.keyCode);
+            buffer += '\n';
+        }
+        file.write(buffer.data(), buffer.size());
+        buffer.clear();
+        written += chunk;
+    }
+}
@@ -0,0 +1,487 @@
+#include "../include/TuningEngine.h"
+#include "../include/BatchAnalyzer.h"
+#include "../include/RankedPatternCounts.h"
+#include "../include/WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+    using Duration = std::chrono::high_resolution_clock::duration;
+
+    // 패턴 인스턴스 후보: 패턴 내부 최대 간격(tick)이 임계값 경계보다 작으면 집계됨
+    struct Candidate {
+        Duration::rep maxGap;
+        PatternKey key;
+    };
+
+    // ExtractionKernel::GapLimit과 같은 경계: 밀리초 절삭 후 <= thresholdMs 이면 간격 안
+    Duration::rep gapBound(long long thresholdMs) {
+        return std::chrono::duration_cast<Duration>(std::chrono::milliseconds(thresholdMs + 1)).count();
+    }
+
+    // 시작 이벤트마다 maxLength까지 한 번 전진하며 [minLength, maxLength] 길이의 후보를 만듦
+    std::vector<Candidate> collectCandidates(const std::vector<InputEvent>& events, int minLength, int maxLength,
+        const ExtractionConfig& keys) {
+        std::vector<Candidate> candidates;
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (events[i].type != EventType::KEY_DOWN || !keys.startKeys.contains(events[i].keyCode)) {
+                continue;
+            }
+            PatternKey currentPattern;
+            bool containsCoreKey = false;
+            Duration::rep maxGap = std::numeric_limits<Duration::rep>::min();
+            for (int j = 0; j < maxLength && i + j < events.size(); ++j) {
+                const InputEvent& event = events[i + j];
+                if (!PatternKey::canEncode(event.keyCode)) {
+                    break;
+                }
+                if (j > 0) {
+                    maxGap = std::max(maxGap, (event.timestamp - events[i + j - 1].timestamp).count());
+                }
+                currentPattern.push(event.type, event.keyCode);
+                containsCoreKey = containsCoreKey || keys.coreKeys.contains(event.keyCode);
+                if (j + 1 >= minLength && containsCoreKey) {
+                    candidates.push_back({maxGap, currentPattern});
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.maxGap < b.maxGap; });
+        return candidates;
+    }
+
+    // 길이 범위마다 후보를 한 번 만들고 간격 임계값을 오름차순으로 훑으며 누적
+    // visit(추출 설정 인덱스, 그 설정의 빈도수)
+    template <typename Visit>
+    void sweepExtractions(const std::vector<InputEvent>& events, const std::vector<std::pair<int, int>>& lengthRanges,
+        const std::vector<long long>& gapThresholdsMs, Visit visit) {
+        const ExtractionConfig keys;
+        for (size_t range = 0; range < lengthRanges.size(); ++range) {
+            const std::vector<Candidate> candidates =
+                collectCandidates(events, lengthRanges[range].first, lengthRanges[range].second, keys);
+            RankedPatternCounts counts;
+            size_t next = 0;
+            for (size_t gap = 0; gap < gapThresholdsMs.size(); ++gap) {
+                const Duration::rep bound = gapBound(gapThresholdsMs[gap]);
+                while (next < candidates.size() && candidates[next].maxGap < bound) {
+                    counts.increment(candidates[next].key);
+                    next++;
+                }
+                visit(range * gapThresholdsMs.size() + gap, counts);
+            }
+        }
+    }
+
+    // PatternAnalyzer::calculateCoveragePatternCount와 동일한 규칙
+    int coveragePatternCount(const RankedPatternCounts& counts, double coveragePercentage) {
+        const long long totalInstances = counts.totalInstances();
+        if (totalInstances == 0) {
+            return 0;
+        }
+        const long long targetCount = static_cast<long long>(totalInstances * (coveragePercentage / 100.0));
+        if (targetCount <= 0) {
+            return 1;
+        }
+        return counts.patternsToReach(targetCount);
+    }
+
+    double ratio(long long numerator, long long denominator) {
+        return denominator > 0 ? static_cast<double>(numerator) / denominator : 0.0;
+    }
+
+    std::vector<double> parseValues(std::istringstream& values, const std::string& name) {
+        std::vector<double> parsed;
+        std::string token;
+        while (values >> token) {
+            try {
+                parsed.push_back(std::stod(token));
+            }
+            catch (const std::exception&) {
+                throw std::runtime_error("Error: Invalid value '" + token + "' for " + name + " in tuning grid");
+            }
+        }
+        if (parsed.empty()) {
+            throw std::runtime_error("Error: No values for " + name + " in tuning grid");
+        }
+        return parsed;
+    }
+}
+
+TuningGrid TuningGrid::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error: Could not open tuning grid " + filename);
+    }
+    TuningGrid grid;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream values(line);
+        std::string name;
+        if (!(values >> name) || name[0] == '#') {
+            continue;
+        }
+
+        if (name == "length") {
+            grid.lengthRanges.clear();
+            std::string token;
+            while (values >> token) {
+                const size_t dash = token.find('-');
+                try {
+                    const int minLength = std::stoi(token.substr(0, dash));
+                    const int maxLength = dash == std::string::npos ? minLength : std::stoi(token.substr(dash + 1));
+                    grid.lengthRanges.emplace_back(minLength, maxLength);
+                }
+                catch (const std::exception&) {
+                    throw std::runtime_error("Error: Invalid length range '" + token + "' in tuning grid");
+                }
+            }
+        }
+        else if (name == "gap_ms") {
+            grid.gapThresholdsMs.clear();
+            for (double value : parseValues(values, name)) {
+                grid.gapThresholdsMs.push_back(static_cast<long long>(value));
+            }
+        }
+        else if (name == "top5_low") {
+            grid.top5ConcentrationLow = parseValues(values, name);
+        }
+        else if (name == "coverage_high") {
+            grid.coverageHigh = parseValues(values, name);
+        }
+        else if (name == "suspicious_high") {
+            grid.suspiciousHigh = parseValues(values, name);
+        }
+        else if (name == "weight_concentration") {
+            grid.weightConcentration = parseValues(values, name);
+        }
+        else if (name == "weight_flatness") {
+            grid.weightFlatness = parseValues(values, name);
+        }
+        else if (name == "decision") {
+            grid.decisionThresholds = parseValues(values, name);
+        }
+        else {
+            throw std::runtime_error("Error: Unknown tuning grid parameter " + name);
+        }
+    }
+    return grid;
+}
+
+std::vector<ScoringParams> TuningGrid::scoringParams() const {
+    std::vector<ScoringParams> combinations;
+    for (double top5Low : top5ConcentrationLow) {
+        for (double coverage : coverageHigh) {
+            for (double suspicious : suspiciousHigh) {
+                for (double concentration : weightConcentration) {
+                    for (double flatness : weightFlatness) {
+                        const double remaining = 1.0 - concentration - flatness;
+                        if (remaining < -1e-9) {
+                            continue;
+                        }
+                        ScoringParams params;
+                        params.top5ConcentrationLow = top5Low;
+                        params.coverageHigh = coverage;
+                        params.suspiciousHigh = suspicious;
+                        params.weightConcentration = concentration;
+                        params.weightFlatness = flatness;
+                        // 1 - 0.5 - 0.4가 0.1과 정확히 같도록 반올림 (기본 격자 점이 기본 점수와 일치)
+                        params.weightSuspicious = std::max(0.0, std::round(remaining * 1e9) / 1e9);
+                        combinations.push_back(params);
+                    }
+                }
+            }
+        }
+    }
+    return combinations;
+}
+
+TuningEngine::TuningEngine(const Options& options) : options_(options) {
+    for (const auto& range : options_.grid.lengthRanges) {
+        if (range.first < 1 || range.first > range.second || range.second > PatternKey::MAX_LENGTH) {
+            throw std::invalid_argument("Tuning length ranges must satisfy 1 <= min <= max <= 8");
+        }
+    }
+    gapThresholdsMs_ = options_.grid.gapThresholdsMs;
+    std::sort(gapThresholdsMs_.begin(), gapThresholdsMs_.end());
+    gapThresholdsMs_.erase(std::unique(gapThresholdsMs_.begin(), gapThresholdsMs_.end()), gapThresholdsMs_.end());
+    if (options_.grid.lengthRanges.empty() || gapThresholdsMs_.empty() || gapThresholdsMs_.front() < 0) {
+        throw std::invalid_argument("Tuning grid needs a length range and non-negative gap thresholds");
+    }
+    options_.grid.gapThresholdsMs = gapThresholdsMs_;
+    // 가중치 합이 1을 넘는 조합은 건너뛰므로 모두 걸러지면 평가할 점이 없음
+    if (options_.grid.decisionThresholds.empty() || options_.grid.scoringParams().empty()) {
+        throw std::invalid_argument(
+            "Tuning grid needs a decision threshold and at least one weight pair with concentration + flatness <= 1");
+    }
+}
+
+std::vector<LabeledSession> TuningEngine::loadCorpus(const std::string& path) {
+    std::vector<LabeledSession> sessions;
+    if (fs::is_directory(path)) {
+        for (const char* label : {"human", "bot"}) {
+            const fs::path directory = fs::path(path) / label;
+            if (!fs::is_directory(directory)) {
+                continue;
+            }
+            for (const std::string& filename : BatchAnalyzer::collectInputs(directory.string())) {
+                sessions.push_back({filename, std::string(label) == "bot"});
+            }
+        }
+        return sessions;
+    }
+
+    std::ifstream manifest(path);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Error: Could not open corpus manifest " + path);
+    }
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const size_t separator = line.find_first_of(" \t,");
+        const std::string label = line.substr(0, separator);
+        const size_t start = separator == std::string::npos ? std::string::npos : line.find_first_not_of(" \t,", separator);
+        if ((label != "human" && label != "bot") || start == std::string::npos) {
+            std::cerr << "Warning: Skipping corpus line (expected 'human <path>' or 'bot <path>'): " << line << std::endl;
+            continue;
+        }
+        sessions.push_back({line.substr(start), label == "bot"});
+    }
+    return sessions;
+}
+
+void TuningEngine::setBaselineEvents(const std::vector<InputEvent>& events) {
+    suspiciousKeys_.assign(options_.grid.extractionCount(), {});
+    sweepExtractions(events, options_.grid.lengthRanges, gapThresholdsMs_,
+        [this](size_t extraction, const RankedPatternCounts& counts) {
+            auto& keys = suspiciousKeys_[extraction];
+            keys.clear();
+            // 빈도수 내림차순이므로 뒤에서부터 2 이하인 구간만 확인
+            for (size_t rank = counts.size(); rank > 0 && counts.countAt(rank - 1) <= 2; --rank) {
+                keys.insert(counts.keyAt(rank - 1));
+            }
+        });
+}
+
+size_t TuningEngine::extractionIndex(const ExtractionConfig& config) const {
+    const auto& ranges = options_.grid.lengthRanges;
+    const auto range = std::find(ranges.begin(), ranges.end(), std::make_pair(config.minLength, config.maxLength));
+    const auto gap = std::find(gapThresholdsMs_.begin(), gapThresholdsMs_.end(), config.timeThresholdMs);
+    if (range == ranges.end() || gap == gapThresholdsMs_.end()) {
+        throw std::invalid_argument("Extraction config is not part of the tuning grid");
+    }
+    return static_cast<size_t>(range - ranges.begin()) * gapThresholdsMs_.size() +
+        static_cast<size_t>(gap - gapThresholdsMs_.begin());
+}
+
+ExtractionConfig TuningEngine::extractionAt(size_t index) const {
+    ExtractionConfig config;
+    const auto& range = options_.grid.lengthRanges[index / gapThresholdsMs_.size()];
+    config.minLength = range.first;
+    config.maxLength = range.second;
+    config.timeThresholdMs = gapThresholdsMs_[index % gapThresholdsMs_.size()];
+    return config;
+}
+
+TuningSummary TuningEngine::run(const std::vector<LabeledSession>& sessions) {
+    TuningSummary summary;
+    const size_t extractionCount = options_.grid.extractionCount();
+    std::vector<std::vector<SessionFeatures>> features(extractionCount, std::vector<SessionFeatures>(sessions.size()));
+    std::vector<char> parsed(sessions.size(), 0);
+    std::atomic<long long> totalEvents{0};
+
+    // 1단계: 세션마다 한 번 파싱하여 모든 추출 설정의 특징을 계산 (이벤트는 특징 계산 후 해제)
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(options_.threadCount);
+        for (size_t i = 0; i < sessions.size(); ++i) {
+            pool.submit([this, i, &sessions, &features, &parsed, &totalEvents]() {
+                try {
+                    const std::vector<InputEvent> events = PatternAnalyzer::parseEventLogFile(sessions[i].filename);
+                    totalEvents += static_cast<long long>(events.size());
+                    sweepExtractions(events, options_.grid.lengthRanges, gapThresholdsMs_,
+                        [&](size_t extraction, const RankedPatternCounts& counts) {
+                            SessionFeatures& feature = features[extraction][i];
+                            const long long totalInstances = counts.totalInstances();
+                            feature.top2Concentration = ratio(counts.topNCount(2), totalInstances) * 100.0;
+                            feature.top5Concentration = ratio(counts.topNCount(5), totalInstances) * 100.0;
+                            feature.coveragePatternCount = coveragePatternCount(counts, 50.0);
+                            if (!suspiciousKeys_.empty() && !suspiciousKeys_[extraction].empty()) {
+                                long long suspiciousCount = 0;
+                                for (size_t rank = 0; rank < counts.size(); ++rank) {
+                                    if (suspiciousKeys_[extraction].count(counts.keyAt(rank))) {
+                                        suspiciousCount += counts.countAt(rank);
+                                    }
+                                }
+                                feature.suspiciousScore = ratio(suspiciousCount, totalInstances) * 100.0;
+                            }
+                        });
+                    parsed[i] = 1;
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Warning: Skipping " << sessions[i].filename << " - " << e.what() << std::endl;
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    // 파싱에 성공한 세션만 평가
+    labels_.clear();
+    features_.assign(extractionCount, {});
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        if (!parsed[i]) {
+            summary.failedFiles++;
+            continue;
+        }
+        labels_.push_back(sessions[i].bot);
+        (sessions[i].bot ? summary.botSessions : summary.humanSessions)++;
+        for (size_t extraction = 0; extraction < extractionCount; ++extraction) {
+            features_[extraction].push_back(features[extraction][i]);
+        }
+    }
+    summary.events = totalEvents;
+    summary.extractionSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (summary.botSessions == 0 || summary.humanSessions == 0) {
+        throw std::runtime_error("Error: Tuning corpus needs both human and bot sessions");
+    }
+
+    // 2단계: 추출 설정마다 점수 격자를 평가 (점수 설정마다 AUC 한 번, 결정 임계값마다 판정 지표)
+    startTime = std::chrono::steady_clock::now();
+    const std::vector<ScoringParams> scoring = options_.grid.scoringParams();
+    const std::vector<double>& decisions = options_.grid.decisionThresholds;
+    const size_t pointsPerExtraction = scoring.size() * decisions.size();
+    points_.assign(extractionCount * pointsPerExtraction, TuningPoint());
+    {
+        WorkStealingPool pool(options_.threadCount);
+        for (size_t extraction = 0; extraction < extractionCount; ++extraction) {
+            pool.submit([this, extraction, &scoring, &decisions, pointsPerExtraction]() {
+                const ExtractionConfig config = extractionAt(extraction);
+                for (size_t s = 0; s < scoring.size(); ++s) {
+                    const std::vector<double> scores = scoreSessions(extraction, scoring[s]);
+
+                    // AUC / 평균 정밀도: 점수 내림차순으로 같은 점수 묶음마다 한 점 (동점은 사다리꼴)
+                    std::vector<std::pair<double, bool>> ranked(scores.size());
+                    for (size_t i = 0; i < scores.size(); ++i) {
+                        ranked[i] = {scores[i], labels_[i]};
+                    }
+                    std::sort(ranked.begin(), ranked.end(),
+                        [](const auto& a, const auto& b) { return a.first > b.first; });
+                    long long positives = 0;
+                    for (const auto& pair : ranked) {
+                        positives += pair.second ? 1 : 0;
+                    }
+                    const long long negatives = static_cast<long long>(ranked.size()) - positives;
+                    double auc = 0.0;
+                    double averagePrecision = 0.0;
+                    long long truePositives = 0;
+                    long long falsePositives = 0;
+                    for (size_t first = 0; first < ranked.size();) {
+                        long long groupPositives = 0;
+                        size_t last = first;
+                        while (last < ranked.size() && ranked[last].first == ranked[first].first) {
+                            groupPositives += ranked[last].second ? 1 : 0;
+                            last++;
+                        }
+                        const long long groupNegatives = static_cast<long long>(last - first) - groupPositives;
+                        auc += groupNegatives * (truePositives + groupPositives * 0.5);
+                        truePositives += groupPositives;
+                        falsePositives += groupNegatives;
+                        averagePrecision += groupPositives * ratio(truePositives, truePositives + falsePositives);
+                        first = last;
+                    }
+
+                    for (size_t d = 0; d < decisions.size(); ++d) {
+                        TuningPoint& point = points_[extraction * pointsPerExtraction + s * decisions.size() + d];
+                        point.extraction = config;
+                        point.scoring = scoring[s];
+                        point.scoring.decisionThreshold = decisions[d];
+                        point.auc = auc / (static_cast<double>(positives) * negatives);
+                        point.averagePrecision = averagePrecision / positives;
+
+                        long long detected = 0;
+                        long long falseAlarms = 0;
+                        for (size_t i = 0; i < scores.size(); ++i) {
+                            if (PatternAnalyzer::isBotSuspected(scores[i], point.scoring)) {
+                                (labels_[i] ? detected : falseAlarms)++;
+                            }
+                        }
+                        point.truePositiveRate = ratio(detected, positives);
+                        point.falsePositiveRate = ratio(falseAlarms, negatives);
+                        point.precision = ratio(detected, detected + falseAlarms);
+                        point.f1 = point.precision + point.truePositiveRate > 0.0
+                            ? 2.0 * point.precision * point.truePositiveRate / (point.precision + point.truePositiveRate) : 0.0;
+                    }
+                }
+            });
+        }
+        pool.wait();
+    }
+    summary.scoringSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return summary;
+}
+
+std::vector<double> TuningEngine::scoreSessions(size_t extraction, const ScoringParams& params) const {
+    const std::vector<SessionFeatures>& features = features_[extraction];
+    std::vector<double> scores(features.size());
+    for (size_t i = 0; i < features.size(); ++i) {
+        scores[i] = PatternAnalyzer::calculateBotSuspicionScore(features[i].top2Concentration,
+            features[i].top5Concentration, features[i].coveragePatternCount, features[i].suspiciousScore, params);
+    }
+    return scores;
+}
+
+const TuningPoint* TuningEngine::best() const {
+    const TuningPoint* best = nullptr;
+    for (const TuningPoint& point : points_) {
+        if (!best || point.auc > best->auc || (point.auc == best->auc && point.f1 > best->f1)) {
+            best = &point;
+        }
+    }
+    return best;
+}
+
+std::vector<TuningCurvePoint> TuningEngine::curve(const TuningPoint& point) const {
+    const std::vector<double> scores = scoreSessions(extractionIndex(point.extraction), point.scoring);
+    std::vector<std::pair<double, bool>> ranked(scores.size());
+    long long positives = 0;
+    for (size_t i = 0; i < scores.size(); ++i) {
+        ranked[i] = {scores[i], labels_[i]};
+        positives += labels_[i] ? 1 : 0;
+    }
+    const long long negatives = static_cast<long long>(scores.size()) - positives;
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // 같은 점수 묶음마다 한 점: 그 점수 이상을 모두 봇으로 판정했을 때
+    std::vector<TuningCurvePoint> curve;
+    long long truePositives = 0;
+    long long falsePositives = 0;
+    for (size_t first = 0; first < ranked.size();) {
+        size_t last = first;
+        while (last < ranked.size() && ranked[last].first == ranked[first].first) {
+            (ranked[last].second ? truePositives : falsePositives)++;
+            last++;
+        }
+        curve.push_back({ranked[first].first, ratio(truePositives, positives), ratio(falsePositives, negatives),
+            ratio(truePositives, truePositives + falsePositives)});
+        first = last;
+    }
+    return curve;
+}
@@ -0,0 +1,104 @@
+#include "../include/WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) {
+            threadCount = 1;
+        }
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wakeCondition_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    submit(nextQueue_.fetch_add(1) % queues_.size(), std::move(task));
+}
+
+void WorkStealingPool::submit(size_t worker, Task task) {
+    pending_++;
+    {
+        WorkerQueue& queue = *queues_[worker % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        generation_++;
+    }
+    wakeCondition_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    idleCondition_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+bool WorkStealingPool::popLocal(size_t index, Task& task) {
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, Task& task) {
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkerQueue& queue = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    while (true) {
+        size_t observedGeneration;
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            observedGeneration = generation_;
+        }
+
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            task();
+            if (--pending_ == 0) {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                idleCondition_.notify_all();
+            }
+            continue;
+        }
+
+        // 큐를 확인한 뒤 새로 제출된 작업이 없을 때만 대기
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait(lock, [this, observedGeneration]() {
+            return stopping_ || generation_ != observedGeneration;
+        });
+        if (stopping_ && generation_ == observedGeneration) {
+            return;
+        }
+    }
+}
@@ -1,60 +1,639 @@
 #include "../include/PatternAnalyzer.h"
+#include "../include/StreamingPatternAnalyzer.h"
+#include "../include/BatchAnalyzer.h"
+#include "../include/SuspiciousPatternMatcher.h"
+#include "../include/BaselineProfile.h"
+#include "../include/Metrics.h"
+#include "../include/DetectorServer.h"
+#include "../include/SessionClusterer.h"
+#include "../include/ReportWriter.h"
+#include "../include/TuningEngine.h"
+#include "../include/PipelinedIngest.h"
+#include <csignal>
+#include <filesystem>
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <numeric>
 #include <set>
 #include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// 로그를 이벤트 단위로 재생하며 1분(로그 시간)마다 최근 10분 윈도우 기준 판정 출력
+// snapshotEvery > 0이면 그 이벤트 수마다 상태를 스냅샷으로 저장하고 새 분석기에 복원하여 이어서 재생
+// (재시작 후 재개를 흉내 냄, 판정 줄은 끊김 없이 재생한 경우와 같아야 함)
+void replayStreaming(const std::vector<InputEvent>& events, const std::string& label,
+    const std::shared_ptr<const SuspiciousPatternMatcher>& suspiciousMatcher, size_t snapshotEvery = 0) {
+    auto analyzerPtr = std::make_unique<StreamingPatternAnalyzer>();
+    analyzerPtr->setSuspiciousMatcher(suspiciousMatcher);
+    size_t snapshots = 0;
+    size_t largestSnapshot = 0;
+
+    const long long reportIntervalMs = 60 * 1000;
+    long long nextReportMs = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const InputEvent& event = events[i];
+        if (snapshotEvery > 0 && i > 0 && i % snapshotEvery == 0) {
+            std::string state;
+            analyzerPtr->saveState(state);
+            analyzerPtr = std::make_unique<StreamingPatternAnalyzer>();
+            analyzerPtr->setSuspiciousMatcher(suspiciousMatcher);
+            analyzerPtr->loadState(reinterpret_cast<const uint8_t*>(state.data()), state.size());
+            snapshots++;
+            largestSnapshot = std::max(largestSnapshot, state.size());
+        }
+        StreamingPatternAnalyzer& analyzer = *analyzerPtr;
+        analyzer.addEvent(event);
+
+        long long timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            event.timestamp.time_since_epoch()).count();
+        if (nextReportMs == 0) {
+            nextReportMs = timestampMs + reportIntervalMs;
+        }
+        if (timestampMs >= nextReportMs) {
+            double score = analyzer.botSuspicionScore();
+            std::cout << "[" << label << " stream] events: " << analyzer.eventsProcessed()
+                << ", instances: " << analyzer.totalInstances()
+                << ", top5: " << std::fixed << std::setprecision(2) << analyzer.topNConcentration(5) << "%"
+                << ", cover50: " << analyzer.coveragePatternCount(50.0)
+                << ", score: " << std::setprecision(4) << score
+                << ", suspected: " << (PatternAnalyzer::isBotSuspected(score) ? "Yes" : "No") << std::endl;
+            nextReportMs = timestampMs + reportIntervalMs;
+        }
+    }
+    if (snapshots > 0) {
+        std::cout << "[" << label << " stream] resumed from " << snapshots << " snapshots (largest "
+            << largestSnapshot << " bytes)" << std::endl;
+    }
+}
+
+// 사람 로그에서 빈도수 2 이하인 패턴을 의심 패턴으로 정의
+std::set<MicroPattern> buildSuspiciousPatternSet(const std::vector<PatternCountPair>& humanFrequencies) {
+    std::set<MicroPattern> suspiciousPatternSet;
+    for (const auto& pair : humanFrequencies) {
+        if (pair.second <= 2) {
+            suspiciousPatternSet.insert(pair.first);
+        }
+    }
+    return suspiciousPatternSet;
+}
+
+// 저장된 기준 프로필(.kmbp)을 매핑하고 판정 전에 한 번 CRC 검사 (손상된 기준으로 판정하지 않도록)
+std::shared_ptr<const BaselineProfile> openBaselineProfile(const std::string& baselineFilename) {
+    auto profile = std::make_shared<const BaselineProfile>(BaselineProfile::open(baselineFilename));
+    if (!profile->verify()) {
+        throw std::runtime_error("Error: Checksum mismatch in baseline profile " + baselineFilename);
+    }
+    return profile;
+}
+
+// 기준이 프로필이면 의심 패턴 집합으로 펼치고, 아니면 사람 로그를 분석하여 의심 패턴 정의
+// (프로필은 가능한 경로에서 openBaselineProfile()로 항목을 직접 조회하고, 이벤트 스트림용 오토마톤이 필요할 때만 사용)
+std::set<MicroPattern> loadSuspiciousPatterns(const std::string& baselineFilename) {
+    if (BaselineProfile::isProfileFile(baselineFilename)) {
+        return openBaselineProfile(baselineFilename)->suspiciousPatterns();
+    }
+    std::vector<InputEvent> baselineEvents = PatternAnalyzer::parseLogFileMapped(baselineFilename);
+    PatternCounter baselineFrequencies = PatternAnalyzer::calculatePackedPatternFrequencies(baselineEvents);
+    return buildSuspiciousPatternSet(baselineFrequencies.toSortedPairs());
+}
+
+// 세션 로그를 플레이어 기준 프로필에 병합 (기존 로그 재처리 없음)
+int updateBaseline(const std::string& profileFilename, const std::string& logFilename) {
+    std::vector<InputEvent> events = PatternAnalyzer::parseEventLogFile(logFilename);
+    PatternCounter frequencies = PatternAnalyzer::calculatePackedPatternFrequencies(events);
+    BaselineProfile::Stats stats = BaselineProfile::merge(profileFilename, frequencies, events.size());
+
+    std::cout << "Baseline " << profileFilename << ": " << stats.sessions << " sessions, "
+        << stats.events << " events, " << stats.totalInstances << " instances, "
+        << stats.distinctPatterns << " patterns" << std::endl;
+    std::cout << "Baseline Top 2 Conc.: " << std::fixed << std::setprecision(2) << stats.top2Concentration << "%" << std::endl;
+    std::cout << "Baseline Top 5 Conc.: " << stats.top5Concentration << "%" << std::endl;
+    std::cout << "Baseline 50% Cover #: " << stats.coveragePatternCount << std::endl;
+    return 0;
+}
+
+// 세션 하나를 저장된 기준(프로필 또는 사람 로그)과 비교하여 판정
+int scoreSession(const std::string& logFilename, const std::string& baselineFilename) {
+    std::vector<InputEvent> events = PatternAnalyzer::parseEventLogFile(logFilename);
+    const PatternCounter frequencies = PatternAnalyzer::calculatePackedPatternFrequencies(events);
+    const FeatureVector features(frequencies);
+    const long long totalInstances = features.totalInstances();
+
+    double top2 = features.topNConcentration(2);
+    double top5 = features.topNConcentration(5);
+    int coverageCount = features.coveragePatternCount(50.0);
+    double suspiciousScore = 0.0;
+    if (!baselineFilename.empty() && BaselineProfile::isProfileFile(baselineFilename)) {
+        // 프로필은 세션 패턴마다 매핑된 항목을 조회 (프로필 크기와 무관)
+        const long long suspiciousCount = openBaselineProfile(baselineFilename)->suspiciousInstances(frequencies);
+        suspiciousScore = totalInstances == 0 ? 0.0 : (static_cast<double>(suspiciousCount) / totalInstances) * 100.0;
+    }
+    else {
+        SuspiciousPatternMatcher matcher(baselineFilename.empty()
+            ? std::set<MicroPattern>() : loadSuspiciousPatterns(baselineFilename));
+        suspiciousScore = PatternAnalyzer::calculateSuspiciousPatternScore(events, totalInstances, matcher);
+    }
+    double finalScore = PatternAnalyzer::calculateBotSuspicionScore(top2, top5, coverageCount, suspiciousScore);
+
+    std::cout << "Session: " << logFilename << " (" << events.size() << " events, "
+        << totalInstances << " instances)" << std::endl;
+    std::cout << "Top 2 Conc.: " << std::fixed << std::setprecision(2) << top2 << "%" << std::endl;
+    std::cout << "Top 5 Conc.: " << top5 << "%" << std::endl;
+    std::cout << "50% Cover #: " << coverageCount << std::endl;
+    std::cout << "Suspicious %: " << suspiciousScore << "%" << std::endl;
+    std::cout << "Final Score: " << std::setprecision(4) << finalScore << std::endl;
+    std::cout << "Suspected: " << (PatternAnalyzer::isBotSuspected(finalScore) ? "Yes" : "No") << std::endl;
+    return 0;
+}
+
+// 파일 / 표준 입력("-")을 청크 단위로 읽으며 파싱과 추출을 겹쳐 수행하고 세션 하나로 판정 (메모리 일정)
+int scorePipelined(const std::string& input, const std::string& baselineFilename, size_t chunkKb) {
+    PipelinedIngest::Options options;
+    if (chunkKb > 0) {
+        options.chunkBytes = chunkKb * 1024;
+    }
+    PipelinedIngest ingest(options);
+    // 프로필은 끝난 뒤 세션 빈도수로 조회하고, 사람 로그 기준만 청크마다 오토마톤으로 집계
+    std::shared_ptr<const BaselineProfile> profile;
+    if (!baselineFilename.empty() && BaselineProfile::isProfileFile(baselineFilename)) {
+        profile = openBaselineProfile(baselineFilename);
+    }
+    else if (!baselineFilename.empty()) {
+        ingest.setSuspiciousMatcher(std::make_shared<SuspiciousPatternMatcher>(loadSuspiciousPatterns(baselineFilename)));
+    }
+
+    PipelinedIngestSummary summary = ingest.run(input);
+    const FeatureVector features(ingest.frequencies());
+    const long long totalInstances = features.totalInstances();
+    double top2 = features.topNConcentration(2);
+    double top5 = features.topNConcentration(5);
+    int coverageCount = features.coveragePatternCount(50.0);
+    const long long suspiciousCount = profile ? profile->suspiciousInstances(ingest.frequencies()) : summary.suspiciousMatches;
+    double suspiciousScore = totalInstances == 0 ? 0.0
+        : (static_cast<double>(suspiciousCount) / totalInstances) * 100.0;
+    double finalScore = PatternAnalyzer::calculateBotSuspicionScore(top2, top5, coverageCount, suspiciousScore);
+
+    std::cout << "Session: " << input << " (" << summary.events << " events, "
+        << totalInstances << " instances)" << std::endl;
+    std::cout << "Top 2 Conc.: " << std::fixed << std::setprecision(2) << top2 << "%" << std::endl;
+    std::cout << "Top 5 Conc.: " << top5 << "%" << std::endl;
+    std::cout << "50% Cover #: " << coverageCount << std::endl;
+    std::cout << "Suspicious %: " << suspiciousScore << "%" << std::endl;
+    std::cout << "Final Score: " << std::setprecision(4) << finalScore << std::endl;
+    std::cout << "Suspected: " << (PatternAnalyzer::isBotSuspected(finalScore) ? "Yes" : "No") << std::endl;
+    std::cout << "Pipeline: " << std::setprecision(1) << summary.bytesRead / (1024.0 * 1024.0) << " MB in "
+        << summary.chunks << " chunks, parse " << std::setprecision(3) << summary.parseSeconds << " s / extract "
+        << summary.extractSeconds << " s (elapsed " << summary.elapsedSeconds << " s), buffers "
+        << summary.bufferBytes / 1024 << " KB" << std::endl;
+    return 0;
+}
+
+// 계측 결과를 Prometheus 텍스트 / JSON lines 파일로 내보냄 (KMD_METRICS 빌드에서만 값이 채워짐)
+void exportMetrics(const std::string& prometheusFilename, const std::string& jsonLinesFilename,
+    const std::string& label) {
+    if (prometheusFilename.empty() && jsonLinesFilename.empty()) {
+        return;
+    }
+    if (!Metrics::enabled()) {
+        std::cerr << "Warning: Built without KMD_METRICS, exported metrics will be empty" << std::endl;
+    }
+    if (!prometheusFilename.empty()) {
+        Metrics::writePrometheus(prometheusFilename);
+    }
+    if (!jsonLinesFilename.empty()) {
+        Metrics::appendJsonLine(jsonLinesFilename, label);
+    }
+}
+
+// 디렉터리/매니페스트의 모든 세션 로그를 병렬 분석하여 하나의 결과 파일(CSV 또는 JSON lines)로 저장
+int runBatch(const std::string& inputPath, const std::string& outputFilename, bool appendOutput,
+    size_t threadCount, const std::string& baselineFilename, size_t sketchCapacity, const std::string& clusterFilename) {
+    BatchAnalyzer::Options options;
+    options.threadCount = threadCount;
+    options.sketchCapacity = sketchCapacity;
+    options.signatureHashes = clusterFilename.empty() ? 0 : SessionSignature::DEFAULT_HASHES;
+    options.outputFilename = outputFilename;
+    options.appendOutput = appendOutput;
+    BatchAnalyzer analyzer(options);
+
+    if (!baselineFilename.empty() && BaselineProfile::isProfileFile(baselineFilename)) {
+        analyzer.setBaselineProfile(openBaselineProfile(baselineFilename));
+    }
+    else if (!baselineFilename.empty()) {
+        analyzer.setSuspiciousPatterns(loadSuspiciousPatterns(baselineFilename));
+    }
+
+    std::vector<std::string> filenames = BatchAnalyzer::collectInputs(inputPath);
+    std::cout << "Analyzing " << filenames.size() << " session logs..." << std::endl;
+
+    BatchSummary summary = analyzer.run(filenames);
+    double seconds = summary.elapsedSeconds > 0.0 ? summary.elapsedSeconds : 1e-9;
+    std::cout << "Processed " << summary.files << " files (" << summary.failedFiles << " failed), "
+        << summary.events << " events in " << std::fixed << std::setprecision(3) << seconds << " s" << std::endl;
+    std::cout << "Throughput: " << std::setprecision(1) << (summary.files / seconds) << " files/s, "
+        << (summary.events / seconds) << " events/s" << std::endl;
+    std::cout << "Results: " << outputFilename << std::endl;
+
+    if (!clusterFilename.empty()) {
+        // 같은 스크립트로 보이는 세션 묶음 (LSH 후보 쌍만 비교)
+        auto clusterStart = std::chrono::steady_clock::now();
+        const std::vector<SessionResult>& sessions = analyzer.sessions();
+        std::vector<const SessionSignature*> signatures;
+        signatures.reserve(sessions.size());
+        for (const SessionResult& session : sessions) {
+            signatures.push_back(&session.signature);
+        }
+        std::vector<SessionCluster> clusters = SessionClusterer().cluster(signatures);
+
+        size_t clusteredSessions = 0;
+        for (const SessionCluster& cluster : clusters) {
+            clusteredSessions += cluster.members.size();
+        }
+        std::string contents;
+        if (FleetReportWriter::formatFor(clusterFilename) == FleetReportWriter::Format::JSON_LINES) {
+            ReportWriter::appendClusterJsonLines(contents, clusters, sessions);
+        }
+        else {
+            ReportWriter::appendClusterCsv(contents, clusters, sessions);
+        }
+        ReportWriter::writeFile(clusterFilename, contents);
+        const double clusterSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - clusterStart).count();
+        std::cout << "Clusters: " << clusters.size() << " (" << clusteredSessions << " of " << sessions.size()
+            << " sessions) in " << std::setprecision(3) << clusterSeconds << " s -> " << clusterFilename << std::endl;
+    }
+    return summary.failedFiles == 0 ? 0 : 1;
+}
+
+// 라벨이 붙은 코퍼스로 추출/점수 파라미터 격자를 평가하여 격자 결과와 최적 점의 ROC / PR 곡선 저장
+int runTuning(const std::string& corpusPath, const std::string& outputFilename, const std::string& gridFilename,
+    size_t threadCount, const std::string& baselineFilename) {
+    TuningEngine::Options options;
+    options.threadCount = threadCount;
+    if (!gridFilename.empty()) {
+        options.grid = TuningGrid::load(gridFilename);
+    }
+    TuningEngine engine(options);
+    if (!baselineFilename.empty()) {
+        if (BaselineProfile::isProfileFile(baselineFilename)) {
+            throw std::runtime_error("Error: Tuning needs a human log as baseline (profiles have a fixed extraction config)");
+        }
+        engine.setBaselineEvents(PatternAnalyzer::parseEventLogFile(baselineFilename));
+    }
+
+    std::vector<LabeledSession> sessions = TuningEngine::loadCorpus(corpusPath);
+    std::cout << "Tuning on " << sessions.size() << " labeled session logs, "
+        << options.grid.extractionCount() << " extraction configs x "
+        << options.grid.scoringParams().size() * options.grid.decisionThresholds.size() << " scoring configs..." << std::endl;
+
+    TuningSummary summary = engine.run(sessions);
+    std::cout << "Extracted " << summary.humanSessions << " human / " << summary.botSessions << " bot sessions ("
+        << summary.failedFiles << " failed), " << summary.events << " events in "
+        << std::fixed << std::setprecision(3) << summary.extractionSeconds << " s" << std::endl;
+    std::cout << "Evaluated " << engine.points().size() << " grid points in " << summary.scoringSeconds << " s" << std::endl;
+
+    std::string contents;
+    ReportWriter::appendTuningCsv(contents, engine.points());
+    ReportWriter::writeFile(outputFilename, contents);
+
+    const TuningPoint* best = engine.best();
+    if (best == nullptr) {
+        std::cerr << "Error: No grid point was evaluated" << std::endl;
+        return 1;
+    }
+    const std::filesystem::path outputPath(outputFilename);
+    const std::string curveFilename = (outputPath.parent_path() / (outputPath.stem().string() + "_roc.csv")).string();
+    contents.clear();
+    ReportWriter::appendTuningCurveCsv(contents, engine.curve(*best));
+    ReportWriter::writeFile(curveFilename, contents);
+
+    std::cout << "Best: length " << best->extraction.minLength << "-" << best->extraction.maxLength
+        << ", gap " << best->extraction.timeThresholdMs << " ms, top5 low " << std::setprecision(1)
+        << best->scoring.top5ConcentrationLow << ", coverage high " << best->scoring.coverageHigh
+        << ", suspicious high " << best->scoring.suspiciousHigh << ", weights " << std::setprecision(2)
+        << best->scoring.weightConcentration << "/" << best->scoring.weightFlatness << "/"
+        << best->scoring.weightSuspicious << ", decision " << best->scoring.decisionThreshold << std::endl;
+    std::cout << "      AUC " << std::setprecision(4) << best->auc << ", AP " << best->averagePrecision
+        << ", TPR " << best->truePositiveRate << ", FPR " << best->falsePositiveRate
+        << ", precision " << best->precision << ", F1 " << best->f1 << std::endl;
+    std::cout << "Results: " << outputFilename << ", ROC/PR: " << curveFilename << std::endl;
+    return summary.failedFiles == 0 ? 0 : 1;
+}
+
+#ifdef __linux__
+DetectorServer* runningServer = nullptr;
+
+void stopServer(int) {
+    if (runningServer != nullptr) {
+        runningServer->stop();
+    }
+}
+
+// 탐지 데몬: SIGINT/SIGTERM을 받을 때까지 클라이언트 이벤트 묶음을 받아 세션별 판정 응답
+int runServer(const std::string& endpoint, size_t threadCount, const std::string& baselineFilename,
+    long long idleTimeoutSeconds, long long sessionBudgetKb, const std::string& checkpointFilename,
+    long long checkpointIntervalSeconds) {
+    DetectorServer::Options options;
+    options.endpoint = endpoint;
+    options.workerThreads = threadCount;
+    if (idleTimeoutSeconds > 0) {
+        options.idleTimeoutMs = idleTimeoutSeconds * 1000;
+    }
+    if (sessionBudgetKb >= 0) {
+        options.sessionMemoryBudget = static_cast<size_t>(sessionBudgetKb) * 1024;
+    }
+    options.checkpointFile = checkpointFilename;
+    if (checkpointIntervalSeconds > 0) {
+        options.checkpointIntervalMs = checkpointIntervalSeconds * 1000;
+    }
+    DetectorServer server(options);
+    // 데몬은 이벤트마다 의심 패턴을 판정하므로 시작 시 한 번 오토마톤을 만들어 계속 사용 (프로필도 검사 후 펼침)
+    if (!baselineFilename.empty()) {
+        server.setSuspiciousMatcher(std::make_shared<SuspiciousPatternMatcher>(loadSuspiciousPatterns(baselineFilename)));
+    }
+
+    runningServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::cout << "Listening on " << endpoint << std::endl;
+    auto startTime = std::chrono::steady_clock::now();
+    server.run();
+    runningServer = nullptr;
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const DetectorServer::Stats stats = server.stats();
+    std::cout << "Served " << stats.connectionsAccepted << " connections, "
+        << stats.sessionsEnded + stats.sessionsEvicted + stats.activeSessions << " sessions ("
+        << stats.sessionsEvicted << " evicted), " << stats.framesReceived << " frames, "
+        << stats.eventsProcessed << " events in " << std::fixed << std::setprecision(1) << seconds << " s" << std::endl;
+    std::cout << "Backpressure pauses: " << stats.backpressurePauses
+        << ", protocol errors: " << stats.protocolErrors << std::endl;
+    std::cout << "Session memory peak: " << stats.peakSessionMemoryBytes / (1024.0 * 1024.0) << " MB for up to "
+        << stats.peakActiveSessions << " sessions ("
+        << stats.peakSessionMemoryBytes / std::max<uint64_t>(1, stats.peakActiveSessions) << " bytes/session), "
+        << stats.degradedSessions << " sessions hit the budget" << std::endl;
+    if (!checkpointFilename.empty()) {
+        std::cout << "Checkpoint: " << stats.sessionsRestored << " sessions restored, "
+            << stats.checkpointsWritten << " snapshots written to " << checkpointFilename
+            << " (last " << stats.checkpointBytes / 1024.0 << " KB)" << std::endl;
+    }
+    return 0;
+}
+#endif
+
+void printUsage(std::ostream& out, const char* program) {
+    out << "Usage: " << program << " [--mmap] [--stream [--snapshot-every <events>]] [--parallel [--threads <n>]]"
+        << " [--columns] [--timing]\n"
+        << "       " << program << " --batch <dir|manifest> [--out <csv|jsonl>] [--append] [--threads <n>]"
+        << " [--baseline <log|profile.kmbp>] [--sketch <capacity>] [--clusters <csv|jsonl>]\n"
+        << "       " << program << " --tune <dir|manifest> [--out <csv>] [--grid <file>] [--threads <n>] [--baseline <log>]\n"
+        << "       " << program << " --update-baseline <profile.kmbp> <log>\n"
+        << "       " << program << " --score <log> [--baseline <log|profile.kmbp>]\n"
+        << "       " << program << " --pipe <log|-> [--baseline <log|profile.kmbp>] [--chunk <KB>]\n"
+        << "       " << program << " --serve <unix:path|host:port> [--threads <n>] [--baseline <log|profile.kmbp>]"
+        << " [--idle-timeout <s>] [--session-budget <KB>] [--checkpoint <file.kmck> [--checkpoint-interval <s>]]\n"
+        << "Common: [--metrics <file.prom>] [--metrics-jsonl <file.jsonl>]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // --mmap: 메모리 맵 기반 파서 사용
+    // --stream: 분석 후 스트리밍 분석기로 로그를 재생하며 세션 중간 판정 출력
+    //   --snapshot-every <events>: 재생 중 그 이벤트 수마다 상태를 저장하고 새 분석기에 복원하여 이어서 재생
+    // --parallel [--threads <n>]: 긴 유휴 간격에서 로그를 나눠 패턴 추출을 병렬 수행
+    // --columns: 열 지향 저장소(EventColumns)와 벡터화 스캔으로 패턴 추출
+    // --timing: 같은 추출 패스에서 패턴 내부 타이밍 통계를 누적하여 주력 패턴 타이밍 변동 특징 출력
+    // --batch <dir|manifest> [--out <csv|jsonl>] [--threads <n>] [--baseline <human log|profile.kmbp>]: 다중 세션 병렬 분석
+    //   --append: 기존 결과 파일 뒤에 이어 쓰기 (CSV 헤더는 빈 파일일 때만)
+    //   --sketch <capacity>: 세션당 카운터 수를 제한한 근사 집계 (결과 파일에 오차 범위 추가)
+    //   --clusters <csv|jsonl>: 패턴 분포가 거의 같은 세션(같은 스크립트로 추정) 묶음 저장
+    // --tune <dir|manifest> [--out <csv>] [--grid <file>] [--threads <n>] [--baseline <human log>]:
+    //   라벨이 붙은 사람/봇 로그로 추출 길이, 간격 임계값, 점수 임계값/가중치 격자를 평가 (ROC / PR)
+    // --update-baseline <profile.kmbp> <log>: 세션 로그를 플레이어 기준 프로필에 병합 (없으면 생성)
+    // --score <log> [--baseline <human log|profile.kmbp>]: 세션 하나를 저장된 기준과 비교하여 판정
+    // --pipe <log|-> [--baseline <...>] [--chunk <KB>]: --score와 같은 판정을 청크 단위 파이프라인으로 수행
+    //   ("-"는 표준 입력, 예: zcat huge.csv.gz | detector -). 파싱/추출 스레드가 겹쳐 돌고 메모리는 입력 크기와 무관
+    // --serve <unix:path|host:port> [--threads <n>] [--baseline <...>] [--idle-timeout <s>]: 탐지 데몬 (Linux)
+    //   --session-budget <KB>: 세션당 메모리 예산 (기본 256, 0이면 제한 없음)
+    //   --checkpoint <file.kmck> [--checkpoint-interval <s>]: 세션 상태를 주기적으로(기본 60초) 저장하고 시작 시 복원
+    // --metrics <file.prom> / --metrics-jsonl <file.jsonl>: 단계별 지연 시간/카운터 내보내기
+    // 알 수 없는 인자, 값이 빠진 옵션, 둘 이상의 실행 모드는 사용법을 출력하고 1로 종료 (--help / -h는 0)
+    bool useMappedParser = false;
+    bool replayStream = false;
+    size_t snapshotEvery = 0;
+    bool parallelExtraction = false;
+    bool columnExtraction = false;
+    bool timingFeatures = false;
+    std::string batchInput;
+    std::string batchOutput;
+    std::string tuneInput;
+    std::string gridFilename;
+    std::string clusterFilename;
+    bool appendOutput = false;
+    std::string baselineFilename;
+    std::string profileFilename;
+    std::string sessionFilename;
+    std::string pipeInput;
+    size_t chunkKb = 0;
+    size_t threadCount = 0;
+    size_t sketchCapacity = 0;
+    std::string serveEndpoint;
+    long long idleTimeoutSeconds = 0;
+    long long sessionBudgetKb = -1;
+    std::string checkpointFilename;
+    long long checkpointIntervalSeconds = 0;
+    std::string metricsFilename;
+    std::string metricsJsonLinesFilename;
+    // 실행 모드 (--batch, --tune, --update-baseline, --score, --pipe / -, --serve)는 한 번만 지정 가능
+    std::vector<std::string> modes;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            printUsage(std::cout, argv[0]);
+            return 0;
+        }
+        else if (arg == "--mmap") {
+            useMappedParser = true;
+        }
+        else if (arg == "--stream") {
+            replayStream = true;
+        }
+        else if (arg == "--snapshot-every" && hasValue) {
+            snapshotEvery = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--parallel") {
+            parallelExtraction = true;
+        }
+        else if (arg == "--columns") {
+            columnExtraction = true;
+        }
+        else if (arg == "--timing") {
+            timingFeatures = true;
+        }
+        else if (arg == "--batch" && hasValue) {
+            modes.push_back(arg);
+            batchInput = argv[++i];
+        }
+        else if (arg == "--tune" && hasValue) {
+            modes.push_back(arg);
+            tuneInput = argv[++i];
+        }
+        else if (arg == "--grid" && hasValue) {
+            gridFilename = argv[++i];
+        }
+        else if (arg == "--clusters" && hasValue) {
+            clusterFilename = argv[++i];
+        }
+        else if (arg == "--append") {
+            appendOutput = true;
+        }
+        else if (arg == "--out" && hasValue) {
+            batchOutput = argv[++i];
+        }
+        else if (arg == "--threads" && hasValue) {
+            threadCount = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--baseline" && hasValue) {
+            baselineFilename = argv[++i];
+        }
+        else if (arg == "--update-baseline" && i + 2 < argc) {
+            modes.push_back(arg);
+            profileFilename = argv[++i];
+            sessionFilename = argv[++i];
+        }
+        else if (arg == "--score" && hasValue) {
+            modes.push_back(arg);
+            sessionFilename = argv[++i];
+        }
+        else if (arg == "--pipe" && hasValue) {
+            modes.push_back(arg);
+            pipeInput = argv[++i];
+        }
+        else if (arg == "-") {
+            modes.push_back(arg);
+            pipeInput = arg;
+        }
+        else if (arg == "--chunk" && hasValue) {
+            chunkKb = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--sketch" && hasValue) {
+            sketchCapacity = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--serve" && hasValue) {
+            modes.push_back(arg);
+            serveEndpoint = argv[++i];
+        }
+        else if (arg == "--idle-timeout" && hasValue) {
+            idleTimeoutSeconds = std::stoll(argv[++i]);
+        }
+        else if (arg == "--session-budget" && hasValue) {
+            sessionBudgetKb = std::stoll(argv[++i]);
+        }
+        else if (arg == "--checkpoint" && hasValue) {
+            checkpointFilename = argv[++i];
+        }
+        else if (arg == "--checkpoint-interval" && hasValue) {
+            checkpointIntervalSeconds = std::stoll(argv[++i]);
+        }
+        else if (arg == "--metrics" && hasValue) {
+            metricsFilename = argv[++i];
+        }
+        else if (arg == "--metrics-jsonl" && hasValue) {
+            metricsJsonLinesFilename = argv[++i];
+        }
+        else {
+            std::cerr << "Error: Unknown argument or missing value: " << arg << std::endl;
+            printUsage(std::cerr, argv[0]);
+            return 1;
+        }
+    }
+    if (modes.size() > 1) {
+        std::cerr << "Error: Conflicting modes: " << modes[0] << " and " << modes[1] << std::endl;
+        printUsage(std::cerr, argv[0]);
+        return 1;
+    }
+
+    if (!serveEndpoint.empty()) {
+#ifdef __linux__
+        return runServer(serveEndpoint, threadCount, baselineFilename, idleTimeoutSeconds, sessionBudgetKb,
+            checkpointFilename, checkpointIntervalSeconds);
+#else
+        std::cerr << "Error: --serve is only supported on Linux" << std::endl;
+        return 1;
+#endif
+    }
+    if (!batchInput.empty()) {
+        int result = runBatch(batchInput, batchOutput.empty() ? "batch_results.csv" : batchOutput, appendOutput,
+            threadCount, baselineFilename, sketchCapacity, clusterFilename);
+        exportMetrics(metricsFilename, metricsJsonLinesFilename, "batch:" + batchInput);
+        return result;
+    }
+    if (!tuneInput.empty()) {
+        return runTuning(tuneInput, batchOutput.empty() ? "tuning_results.csv" : batchOutput, gridFilename,
+            threadCount, baselineFilename);
+    }
+    if (!profileFilename.empty()) {
+        return updateBaseline(profileFilename, sessionFilename);
+    }
+    if (!sessionFilename.empty()) {
+        return scoreSession(sessionFilename, baselineFilename);
+    }
+    if (!pipeInput.empty()) {
+        return scorePipelined(pipeInput, baselineFilename, chunkKb);
+    }
+    auto parseLog = useMappedParser ? PatternAnalyzer::parseLogFileMapped : PatternAnalyzer::parseLogFile;
+    auto extractPatterns = [parallelExtraction, columnExtraction, timingFeatures, threadCount](
+        const std::vector<InputEvent>& events, PatternTimingTable& timing) {
+        if (timingFeatures) {
+            return PatternAnalyzer::calculatePackedPatternFrequencies(events, ExtractionConfig(), timing);
+        }
+        if (columnExtraction) {
+            return PatternAnalyzer::calculatePackedPatternFrequencies(EventColumns::fromEvents(events));
+        }
+        return parallelExtraction
+            ? PatternAnalyzer::calculatePackedPatternFrequenciesParallel(events, ExtractionConfig(), threadCount)
+            : PatternAnalyzer::calculatePackedPatternFrequencies(events);
+    };
 
-int main() {
     // --- 로그 파일 파싱 및 패턴 분석 ---
     std::string botLogFilename = "MacroPattern.csv";
     std::string humanLogFilename = "UserPattern.csv";
 
-    std::vector<InputEvent> botEvents = PatternAnalyzer::parseLogFile(botLogFilename);
+    std::vector<InputEvent> botEvents = parseLog(botLogFilename);
     std::cout << "Parsed " << botEvents.size() << " events from bot log." << std::endl;
 
-    std::vector<InputEvent> humanEvents = PatternAnalyzer::parseLogFile(humanLogFilename);
+    std::vector<InputEvent> humanEvents = parseLog(humanLogFilename);
     std::cout << "Parsed " << humanEvents.size() << " events from human log." << std::endl;
 
     std::cout << "\n=== Bot Pattern Analysis ===" << std::endl;
-    PatternFrequencyMap botFrequencies = PatternAnalyzer::calculateMicroPatternFrequencies(botEvents);
-    PatternAnalyzer::printFrequencies(botFrequencies, "Bot");
+    PatternTimingTable botTiming;
+    PatternCounter botFrequencies = extractPatterns(botEvents, botTiming);
+    // 빈도수는 한 번만 정렬하여 출력/특징/저장이 같은 특징 벡터(정렬 목록 + 누적 합)를 사용
+    const FeatureVector botFeatures(botFrequencies);
+    PatternAnalyzer::printFrequencies(botFeatures, "Bot");
 
     std::cout << "\n=== Human Pattern Analysis ===" << std::endl;
-    PatternFrequencyMap humanFrequencies = PatternAnalyzer::calculateMicroPatternFrequencies(humanEvents);
-    PatternAnalyzer::printFrequencies(humanFrequencies, "Human");
-
-    // --- 빈도수 정렬 및 총 인스턴스 계산 ---
-    std::vector<PatternCountPair> sortedBotFreqs(botFrequencies.begin(), botFrequencies.end());
-    std::vector<PatternCountPair> sortedHumanFreqs(humanFrequencies.begin(), humanFrequencies.end());
-    
-    std::sort(sortedBotFreqs.begin(), sortedBotFreqs.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
-    std::sort(sortedHumanFreqs.begin(), sortedHumanFreqs.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
-
-    long long totalBotInstances = std::accumulate(sortedBotFreqs.begin(), sortedBotFreqs.end(), 0LL,
-        [](long long sum, const auto& pair) { return sum + pair.second; });
-    long long totalHumanInstances = std::accumulate(sortedHumanFreqs.begin(), sortedHumanFreqs.end(), 0LL,
-        [](long long sum, const auto& pair) { return sum + pair.second; });
+    PatternTimingTable humanTiming;
+    PatternCounter humanFrequencies = extractPatterns(humanEvents, humanTiming);
+    const FeatureVector humanFeatures(humanFrequencies);
+    PatternAnalyzer::printFrequencies(humanFeatures, "Human");
+
+    // --- 총 인스턴스 (특징 벡터의 누적 합) ---
+    long long totalBotInstances = botFeatures.totalInstances();
+    long long totalHumanInstances = humanFeatures.totalInstances();
 
     // --- 의심 패턴 목록 정의 ---
-    std::set<MicroPattern> suspiciousPatternSet;
-    
     // humanFrequencies에서 빈도수가 2 이하인 패턴들을 의심 패턴으로 추가
-    for (const auto& pair : humanFrequencies) {
-        if (pair.second <= 2) {
-            suspiciousPatternSet.insert(pair.first);
-        }
-    }
+    // 집합을 한 번 오토마톤으로 컴파일하여 봇/사람 점수와 스트리밍 재생에서 공유
+    auto suspiciousMatcher = std::make_shared<const SuspiciousPatternMatcher>(buildSuspiciousPatternSet(humanFeatures.sorted()));
 
     // --- 봇 데이터 분석 및 판정 ---
     std::cout << "\n=== Analyzing Bot Data ===" << std::endl;
-    double botTop2 = PatternAnalyzer::calculateTopNConcentration(sortedBotFreqs, totalBotInstances, 2);
-    double botTop5 = PatternAnalyzer::calculateTopNConcentration(sortedBotFreqs, totalBotInstances, 5);
-    int botCoverageCount = PatternAnalyzer::calculateCoveragePatternCount(sortedBotFreqs, totalBotInstances, 50.0);
-    double botSuspiciousScore = PatternAnalyzer::calculateSuspiciousPatternScore(botFrequencies, totalBotInstances, suspiciousPatternSet);
+    double botTop2 = botFeatures.topNConcentration(2);
+    double botTop5 = botFeatures.topNConcentration(5);
+    int botCoverageCount = botFeatures.coveragePatternCount(50.0);
+    double botSuspiciousScore = PatternAnalyzer::calculateSuspiciousPatternScore(botEvents, totalBotInstances, *suspiciousMatcher);
 
     std::cout << "Bot Top 2 Conc.: " << std::fixed << std::setprecision(2) << botTop2 << "%" << std::endl;
     std::cout << "Bot Top 5 Conc.: " << std::fixed << std::setprecision(2) << botTop5 << "%" << std::endl;
@@ -62,15 +641,23 @@ int main() {
     std::cout << "Bot Suspicious %: " << std::fixed << std::setprecision(2) << botSuspiciousScore << "%" << std::endl;
 
     double botFinalScore = PatternAnalyzer::calculateBotSuspicionScore(botTop2, botTop5, botCoverageCount, botSuspiciousScore);
+    if (timingFeatures) {
+        double botTimingVariation = PatternAnalyzer::calculateDominantTimingVariation(botFrequencies, botTiming);
+        std::cout << "Bot Timing CV (top 5): " << std::fixed << std::setprecision(4) << botTimingVariation
+            << " (gap mean " << std::setprecision(2) << botTiming.overall().gaps.mean << " ms, hold mean "
+            << botTiming.overall().holds.mean << " ms)" << std::endl;
+        botFinalScore = PatternAnalyzer::calculateBotSuspicionScore(botTop2, botTop5, botCoverageCount,
+            botSuspiciousScore, botTimingVariation);
+    }
     std::cout << "Bot Final Score: " << std::fixed << std::setprecision(4) << botFinalScore << std::endl;
     std::cout << "Bot Suspected: " << (PatternAnalyzer::isBotSuspected(botFinalScore) ? "Yes" : "No") << std::endl;
 
     // --- 사람 데이터 분석 및 판정 ---
     std::cout << "\n=== Analyzing Human Data ===" << std::endl;
-    double humanTop2 = PatternAnalyzer::calculateTopNConcentration(sortedHumanFreqs, totalHumanInstances, 2);
-    double humanTop5 = PatternAnalyzer::calculateTopNConcentration(sortedHumanFreqs, totalHumanInstances, 5);
-    int humanCoverageCount = PatternAnalyzer::calculateCoveragePatternCount(sortedHumanFreqs, totalHumanInstances, 50.0);
-    double humanSuspiciousScore = PatternAnalyzer::calculateSuspiciousPatternScore(humanFrequencies, totalHumanInstances, suspiciousPatternSet);
+    double humanTop2 = humanFeatures.topNConcentration(2);
+    double humanTop5 = humanFeatures.topNConcentration(5);
+    int humanCoverageCount = humanFeatures.coveragePatternCount(50.0);
+    double humanSuspiciousScore = PatternAnalyzer::calculateSuspiciousPatternScore(humanEvents, totalHumanInstances, *suspiciousMatcher);
 
     std::cout << "Human Top 2 Conc.: " << std::fixed << std::setprecision(2) << humanTop2 << "%" << std::endl;
     std::cout << "Human Top 5 Conc.: " << std::fixed << std::setprecision(2) << humanTop5 << "%" << std::endl;
@@ -78,13 +665,27 @@ int main() {
     std::cout << "Human Suspicious %: " << std::fixed << std::setprecision(2) << humanSuspiciousScore << "%" << std::endl;
 
     double humanFinalScore = PatternAnalyzer::calculateBotSuspicionScore(humanTop2, humanTop5, humanCoverageCount, humanSuspiciousScore);
+    if (timingFeatures) {
+        double humanTimingVariation = PatternAnalyzer::calculateDominantTimingVariation(humanFrequencies, humanTiming);
+        std::cout << "Human Timing CV (top 5): " << std::fixed << std::setprecision(4) << humanTimingVariation
+            << " (gap mean " << std::setprecision(2) << humanTiming.overall().gaps.mean << " ms, hold mean "
+            << humanTiming.overall().holds.mean << " ms)" << std::endl;
+        humanFinalScore = PatternAnalyzer::calculateBotSuspicionScore(humanTop2, humanTop5, humanCoverageCount,
+            humanSuspiciousScore, humanTimingVariation);
+    }
     std::cout << "Human Final Score: " << std::fixed << std::setprecision(4) << humanFinalScore << std::endl;
     std::cout << "Human Suspected: " << (PatternAnalyzer::isBotSuspected(humanFinalScore) ? "Yes" : "No") << std::endl;
 
+    if (replayStream) {
+        std::cout << "\n=== Streaming Replay ===" << std::endl;
+        replayStreaming(botEvents, "Bot", suspiciousMatcher, snapshotEvery);
+        replayStreaming(humanEvents, "Human", suspiciousMatcher, snapshotEvery);
+    }
+
     // 봇 데이터 분석 결과 저장
     PatternAnalyzer::saveAnalysisResults(
         "bot_analysis.csv",
-        sortedBotFreqs,
+        botFeatures,
         botTop2,
         botTop5,
         botCoverageCount,
@@ -95,7 +696,7 @@ int main() {
     // 사람 데이터 분석 결과 저장
     PatternAnalyzer::saveAnalysisResults(
         "human_analysis.csv",
-        sortedHumanFreqs,
+        humanFeatures,
         humanTop2,
         humanTop5,
         humanCoverageCount,
@@ -103,6 +704,8 @@ int main() {
         humanFinalScore
     );
 
+    exportMetrics(metricsFilename, metricsJsonLinesFilename, botLogFilename + "," + humanLogFilename);
+
     std::cout << "\nPress Enter to exit..." << std::endl;
     getchar();
     return 0;
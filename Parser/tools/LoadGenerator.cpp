@@ -0,0 +1,399 @@
+// 탐지 데몬(--serve) 부하 생성기: CSV/KMDL 로그를 여러 세션으로 재생하여 처리량과 판정 지연 측정 (Linux)
+// 사용법:
+//   LoadGenerator --connect <unix:path|host:port> [--sessions <n>] [--connections <n>]
+//                 [--rate <세션당 events/s, 0이면 최대 속도>] [--batch <프레임당 이벤트 수>]
+//                 [--verdicts <file.csv|file.jsonl>] <log> [<log> ...]
+// 세션 i는 로그 (i % 로그 수)를 처음부터 끝까지 재생한 뒤 END_SESSION으로 마지막 판정을 받음
+// 판정 지연 = EVENTS/END_SESSION 프레임을 보낸 시각부터 같은 sequence의 VERDICT를 받은 시각까지
+#include "../include/PatternAnalyzer.h"
+#include "../include/DetectorProtocol.h"
+#include "../include/DetectorServer.h"
+#include "../include/BatchAnalyzer.h"
+#include "../include/ReportWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t SEND_COALESCE_BYTES = 64 * 1024;
+
+    struct ReplaySession {
+        uint64_t sessionId = 0;
+        size_t logIndex = 0;
+        size_t nextEvent = 0;
+        bool ended = false;
+        DetectorProtocol::Verdict finalVerdict;
+    };
+
+    struct ConnectionResult {
+        std::vector<double> latenciesMs;
+        uint64_t frames = 0;
+        uint64_t events = 0;
+        uint64_t evictions = 0;
+        uint64_t degraded = 0; // 마지막 판정이 FLAG_DEGRADED인 세션
+        std::atomic<bool> failed{false}; // 송신/수신 스레드 모두 기록
+    };
+
+    void sendAll(int fd, const std::string& bytes) {
+        size_t offset = 0;
+        while (offset < bytes.size()) {
+            const ssize_t sent = send(fd, bytes.data() + offset, bytes.size() - offset, MSG_NOSIGNAL);
+            if (sent <= 0) {
+                if (sent < 0 && errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Error: Connection closed while sending");
+            }
+            offset += static_cast<size_t>(sent);
+        }
+    }
+
+    // 연결 하나: 송신 스레드가 세션들을 속도에 맞춰 번갈아 보내고, 수신 스레드가 판정을 모음
+    class ReplayConnection {
+    public:
+        ReplayConnection(const std::string& endpoint, std::vector<ReplaySession*> sessions,
+            const std::vector<std::vector<InputEvent>>& logs, double rate, size_t batchEvents)
+            : fd_(DetectorEndpoint::connectTo(endpoint)), sessions_(std::move(sessions)), logs_(logs),
+              rate_(rate), batchEvents_(batchEvents) {
+            size_t frames = 0;
+            for (const ReplaySession* session : sessions_) {
+                frames += (logs_[session->logIndex].size() + batchEvents_ - 1) / batchEvents_ + 1;
+            }
+            sendTimes_.reset(new std::atomic<int64_t>[frames]);
+            frameCount_ = frames;
+        }
+
+        ~ReplayConnection() {
+            close(fd_);
+        }
+
+        void start(Clock::time_point startTime) {
+            receiver_ = std::thread(&ReplayConnection::receiveLoop, this, startTime);
+            sender_ = std::thread(&ReplayConnection::sendLoop, this, startTime);
+        }
+
+        void join() {
+            sender_.join();
+            receiver_.join();
+        }
+
+        ConnectionResult& result() { return result_; }
+
+    private:
+        void sendLoop(Clock::time_point startTime) {
+            // (예정 시각, 세션 인덱스) 최소 힙. 세션마다 batchEvents / rate 초 간격으로 프레임 전송
+            using Due = std::pair<double, size_t>;
+            std::priority_queue<Due, std::vector<Due>, std::greater<Due>> schedule;
+            const double interval = rate_ > 0.0 ? static_cast<double>(batchEvents_) / rate_ : 0.0;
+            for (size_t i = 0; i < sessions_.size(); ++i) {
+                schedule.push({interval * static_cast<double>(i) / static_cast<double>(sessions_.size()), i});
+            }
+
+            BinaryEventLog::BlockEncoder encoder(static_cast<uint32_t>(batchEvents_));
+            std::string block;
+            std::string buffer;
+            std::vector<uint32_t> bufferedSequences;
+            uint32_t nextSequence = 0;
+
+            auto flush = [&]() {
+                const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - startTime).count();
+                for (uint32_t sequence : bufferedSequences) {
+                    sendTimes_[sequence].store(now, std::memory_order_release);
+                }
+                sendAll(fd_, buffer);
+                buffer.clear();
+                bufferedSequences.clear();
+            };
+
+            try {
+                while (!schedule.empty()) {
+                    const Due due = schedule.top();
+                    const auto dueTime = startTime + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(due.first));
+                    if (rate_ > 0.0 && Clock::now() < dueTime) {
+                        if (!buffer.empty()) {
+                            flush();
+                        }
+                        std::this_thread::sleep_until(dueTime);
+                    }
+                    schedule.pop();
+
+                    ReplaySession& session = *sessions_[due.second];
+                    const std::vector<InputEvent>& events = logs_[session.logIndex];
+                    const uint32_t sequence = nextSequence++;
+                    if (session.nextEvent < events.size()) {
+                        const size_t end = std::min(events.size(), session.nextEvent + batchEvents_);
+                        block.clear();
+                        for (size_t i = session.nextEvent; i < end; ++i) {
+                            const InputEvent& event = events[i];
+                            BinaryEventLog::Event encoded;
+                            encoded.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                event.timestamp.time_since_epoch()).count();
+                            encoded.keyUp = event.type == EventType::KEY_UP;
+                            encoded.keyCode = event.keyCode;
+                            encoder.add(encoded, block);
+                        }
+                        encoder.flushBlock(block);
+                        DetectorProtocol::appendEventsFrame(buffer, session.sessionId, sequence, block);
+                        result_.events += end - session.nextEvent;
+                        session.nextEvent = end;
+                        schedule.push({due.first + interval, due.second});
+                    }
+                    else {
+                        DetectorProtocol::appendEndSessionFrame(buffer, session.sessionId, sequence);
+                    }
+                    bufferedSequences.push_back(sequence);
+                    result_.frames++;
+                    if (buffer.size() >= SEND_COALESCE_BYTES) {
+                        flush();
+                    }
+                }
+                if (!buffer.empty()) {
+                    flush();
+                }
+            }
+            catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                result_.failed = true;
+                shutdown(fd_, SHUT_RDWR);
+            }
+        }
+
+        void receiveLoop(Clock::time_point startTime) {
+            std::vector<uint8_t> input;
+            std::vector<uint8_t> chunk(64 * 1024);
+            size_t finals = 0;
+            size_t verdicts = 0;
+            result_.latenciesMs.reserve(frameCount_);
+
+            while (finals < sessions_.size()) {
+                const ssize_t received = recv(fd_, chunk.data(), chunk.size(), 0);
+                if (received <= 0) {
+                    if (received < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    std::cerr << "Error: Connection closed by detector after " << verdicts << " verdicts" << std::endl;
+                    result_.failed = true;
+                    return;
+                }
+                const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - startTime).count();
+                input.insert(input.end(), chunk.begin(), chunk.begin() + received);
+
+                size_t offset = 0;
+                while (input.size() - offset >= DetectorProtocol::HEADER_SIZE) {
+                    const DetectorProtocol::FrameHeader header = DetectorProtocol::readHeader(input.data() + offset);
+                    if (input.size() - offset - DetectorProtocol::HEADER_SIZE < header.payloadSize) {
+                        break;
+                    }
+                    const uint8_t* payload = input.data() + offset + DetectorProtocol::HEADER_SIZE;
+                    offset += DetectorProtocol::HEADER_SIZE + header.payloadSize;
+
+                    if (header.type == DetectorProtocol::MessageType::PROTOCOL_ERROR) {
+                        std::cerr << "Error: Detector rejected stream - "
+                            << std::string(reinterpret_cast<const char*>(payload), header.payloadSize) << std::endl;
+                        result_.failed = true;
+                        return;
+                    }
+                    if (header.type != DetectorProtocol::MessageType::VERDICT ||
+                        header.payloadSize != DetectorProtocol::VERDICT_SIZE) {
+                        continue;
+                    }
+                    if (header.flags & DetectorProtocol::FLAG_EVICTED) {
+                        result_.evictions++;
+                        continue;
+                    }
+                    verdicts++;
+                    if (header.sequence < frameCount_) {
+                        const int64_t sent = sendTimes_[header.sequence].load(std::memory_order_acquire);
+                        result_.latenciesMs.push_back(static_cast<double>(now - sent) / 1e6);
+                    }
+                    if (header.flags & DetectorProtocol::FLAG_FINAL) {
+                        if (header.flags & DetectorProtocol::FLAG_DEGRADED) {
+                            result_.degraded++;
+                        }
+                        for (ReplaySession* session : sessions_) {
+                            if (session->sessionId == header.sessionId) {
+                                session->finalVerdict = DetectorProtocol::readVerdict(payload);
+                                session->ended = true;
+                            }
+                        }
+                        finals++;
+                    }
+                }
+                input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(offset));
+            }
+        }
+
+        int fd_;
+        std::vector<ReplaySession*> sessions_;
+        const std::vector<std::vector<InputEvent>>& logs_;
+        double rate_;
+        size_t batchEvents_;
+        std::unique_ptr<std::atomic<int64_t>[]> sendTimes_;
+        size_t frameCount_ = 0;
+        std::thread sender_;
+        std::thread receiver_;
+        ConnectionResult result_;
+    };
+
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+        return sorted[index];
+    }
+}
+#endif
+
+int main(int argc, char* argv[]) {
+#ifndef __linux__
+    (void)argc;
+    (void)argv;
+    std::cerr << "LoadGenerator is only supported on Linux" << std::endl;
+    return 1;
+#else
+    std::string endpoint;
+    size_t sessionCount = 100;
+    size_t connectionCount = 4;
+    double rate = 0.0;
+    size_t batchEvents = 64;
+    std::string verdictsFilename;
+    std::vector<std::string> logFilenames;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--connect" && hasValue) {
+                endpoint = argv[++i];
+            }
+            else if (arg == "--sessions" && hasValue) {
+                sessionCount = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--connections" && hasValue) {
+                connectionCount = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--rate" && hasValue) {
+                rate = std::stod(argv[++i]);
+            }
+            else if (arg == "--batch" && hasValue) {
+                batchEvents = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--verdicts" && hasValue) {
+                verdictsFilename = argv[++i];
+            }
+            else {
+                logFilenames.push_back(arg);
+            }
+        }
+        if (endpoint.empty() || logFilenames.empty() || sessionCount == 0 || connectionCount == 0 || batchEvents == 0) {
+            std::cerr << "Usage: LoadGenerator --connect <unix:path|host:port> [--sessions <n>] [--connections <n>]"
+                " [--rate <events/s per session>] [--batch <events>] [--verdicts <file>] <log>..." << std::endl;
+            return 1;
+        }
+        connectionCount = std::min(connectionCount, sessionCount);
+
+        std::vector<std::vector<InputEvent>> logs;
+        for (const std::string& filename : logFilenames) {
+            logs.push_back(PatternAnalyzer::parseEventLogFile(filename));
+        }
+
+        std::vector<ReplaySession> sessions;
+        sessions.reserve(sessionCount);
+        for (size_t i = 0; i < sessionCount; ++i) {
+            ReplaySession session;
+            session.sessionId = static_cast<uint64_t>(i + 1);
+            session.logIndex = i % logs.size();
+            sessions.push_back(session);
+        }
+        std::vector<std::unique_ptr<ReplayConnection>> connections;
+        for (size_t c = 0; c < connectionCount; ++c) {
+            std::vector<ReplaySession*> assigned;
+            for (size_t i = c; i < sessionCount; i += connectionCount) {
+                assigned.push_back(&sessions[i]);
+            }
+            connections.push_back(std::make_unique<ReplayConnection>(endpoint, assigned, logs, rate, batchEvents));
+        }
+
+        const auto startTime = Clock::now();
+        for (auto& connection : connections) {
+            connection->start(startTime);
+        }
+        for (auto& connection : connections) {
+            connection->join();
+        }
+        const double seconds = std::max(1e-9, std::chrono::duration<double>(Clock::now() - startTime).count());
+
+        std::vector<double> latencies;
+        uint64_t frames = 0;
+        uint64_t events = 0;
+        uint64_t evictions = 0;
+        uint64_t degraded = 0;
+        bool failed = false;
+        for (auto& connection : connections) {
+            ConnectionResult& result = connection->result();
+            latencies.insert(latencies.end(), result.latenciesMs.begin(), result.latenciesMs.end());
+            frames += result.frames;
+            events += result.events;
+            evictions += result.evictions;
+            degraded += result.degraded;
+            failed = failed || result.failed;
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        std::cout << "Sessions: " << sessionCount << " on " << connectionCount << " connections, "
+            << events << " events, " << frames << " frames in " << std::fixed << std::setprecision(3) << seconds << " s"
+            << (evictions > 0 ? " (" + std::to_string(evictions) + " evicted)" : "")
+            << (degraded > 0 ? " (" + std::to_string(degraded) + " over memory budget)" : "") << std::endl;
+        std::cout << "Throughput: " << std::setprecision(1) << (sessionCount / seconds) << " sessions/s, "
+            << (events / seconds) << " events/s, " << (frames / seconds) << " frames/s" << std::endl;
+        std::cout << "Verdict latency (ms): p50 " << std::setprecision(3) << percentile(latencies, 0.50)
+            << ", p90 " << percentile(latencies, 0.90)
+            << ", p99 " << percentile(latencies, 0.99)
+            << ", p99.9 " << percentile(latencies, 0.999)
+            << ", max " << (latencies.empty() ? 0.0 : latencies.back()) << std::endl;
+
+        if (!verdictsFilename.empty()) {
+            FleetReportWriter::Options options;
+            options.format = FleetReportWriter::formatFor(verdictsFilename);
+            FleetReportWriter writer(verdictsFilename, options);
+            for (const ReplaySession& session : sessions) {
+                const DetectorProtocol::Verdict& verdict = session.finalVerdict;
+                SessionResult result;
+                result.session = logFilenames[session.logIndex] + "#" + std::to_string(session.sessionId);
+                result.events = static_cast<size_t>(verdict.eventsProcessed);
+                result.totalInstances = static_cast<long long>(verdict.totalInstances);
+                result.uniquePatterns = verdict.distinctPatterns;
+                result.top2Concentration = verdict.top2Concentration;
+                result.top5Concentration = verdict.top5Concentration;
+                result.coveragePatternCount = verdict.coveragePatternCount;
+                result.suspiciousScore = verdict.suspiciousScore;
+                result.finalScore = verdict.finalScore;
+                result.suspected = verdict.suspected;
+                writer.write(result);
+            }
+        }
+        return failed ? 1 : 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+#endif
+}
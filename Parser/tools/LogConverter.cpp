@@ -0,0 +1,110 @@
+// CSV <-> 이진 이벤트 로그(.kmdl) 변환기
+// 사용법: LogConverter <input> <output>   (출력 확장자가 .kmdl이면 이진, 아니면 CSV로 저장)
+#include "../include/PatternAnalyzer.h"
+#include "../include/BinaryEventLog.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+    bool endsWith(const std::string& value, const std::string& suffix) {
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    long long timestampMs(const InputEvent& event) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(event.timestamp.time_since_epoch()).count();
+    }
+
+    void writeBinary(const std::vector<InputEvent>& events, const std::string& filename) {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        std::string buffer = BinaryEventLog::fileHeader();
+        BinaryEventLog::BlockEncoder encoder;
+        for (const InputEvent& event : events) {
+            encoder.add({timestampMs(event), event.type == EventType::KEY_UP, event.keyCode}, buffer);
+            if (buffer.size() >= (1 << 20)) {
+                file.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        encoder.flushBlock(buffer);
+        file.write(buffer.data(), buffer.size());
+    }
+
+    void writeCsv(const std::vector<InputEvent>& events, const std::string& filename) {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        std::string buffer = "Timestamp,EventType,KeyCode\n";
+        for (const InputEvent& event : events) {
+            buffer += std::to_string(timestampMs(event));
+            buffer += event.type == EventType::KEY_DOWN ? ",KEY_DOWN," : ",KEY_UP,";
+            buffer += std::to_string(event.keyCode);
+            buffer += '\n';
+            if (buffer.size() >= (1 << 20)) {
+                file.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        file.write(buffer.data(), buffer.size());
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    long long fileSize(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        return file.is_open() ? static_cast<long long>(file.tellg()) : 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: LogConverter <input.csv|input.kmdl> <output.kmdl|output.csv>" << std::endl;
+        return 1;
+    }
+    const std::string inputFilename = argv[1];
+    const std::string outputFilename = argv[2];
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<InputEvent> events = PatternAnalyzer::parseEventLogFile(inputFilename);
+        double parseSeconds = secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        if (endsWith(outputFilename, ".kmdl")) {
+            writeBinary(events, outputFilename);
+        }
+        else {
+            writeCsv(events, outputFilename);
+        }
+        double writeSeconds = secondsSince(start);
+
+        long long inputSize = fileSize(inputFilename);
+        long long outputSize = fileSize(outputFilename);
+        std::cout << "Events: " << events.size() << std::endl;
+        std::cout << "Input:  " << inputFilename << " (" << inputSize << " bytes, parsed in "
+            << std::fixed << std::setprecision(3) << parseSeconds << " s)" << std::endl;
+        std::cout << "Output: " << outputFilename << " (" << outputSize << " bytes, written in "
+            << writeSeconds << " s)" << std::endl;
+        if (!events.empty() && outputSize > 0) {
+            std::cout << "Bytes/event: " << std::setprecision(2)
+                << static_cast<double>(inputSize) / events.size() << " -> "
+                << static_cast<double>(outputSize) / events.size()
+                << " (ratio " << static_cast<double>(inputSize) / outputSize << "x)" << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
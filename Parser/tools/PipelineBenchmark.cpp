@@ -0,0 +1,329 @@
+// Parser 파이프라인 단계별 벤치마크 (합성 트레이스 사용)
+// 사용법:
+//   PipelineBenchmark [--sizes 1e3,1e4,...] [--max-events <n>] [--profile bot|human] [--seed <n>]
+//                     [--dir <임시 디렉터리>] [--csv <결과 파일>] [--keep]
+//   PipelineBenchmark --generate <file.csv> --events <n> [--profile bot|human] [--seed <n>]
+// 크기는 작은 것부터 실행하므로 각 행의 peak RSS는 해당 크기까지의 프로세스 최대값
+#define NOMINMAX
+#include "../include/PatternAnalyzer.h"
+#include "../include/TraceGenerator.h"
+#include "../include/EventColumns.h"
+#include "../include/ColumnScan.h"
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    struct StageResult {
+        std::string stage;
+        size_t events;
+        double seconds;
+        double unitsPerSecond;
+        std::string unit;
+        double peakRssMb;
+    };
+
+    double peakRssMb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+        }
+        return 0.0;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+        return usage.ru_maxrss / 1024.0;
+#endif
+#endif
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // "1e6", "250000" 형식 모두 허용
+    size_t parseCount(const std::string& text) {
+        return static_cast<size_t>(std::stod(text));
+    }
+
+    std::vector<size_t> parseSizes(const std::string& text) {
+        std::vector<size_t> sizes;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) {
+                sizes.push_back(parseCount(item));
+            }
+        }
+        return sizes;
+    }
+
+    class StageTimer {
+    public:
+        StageTimer(std::vector<StageResult>& results, const std::string& stage, size_t events,
+            double units, const std::string& unit)
+            : results_(results), stage_(stage), events_(events), units_(units), unit_(unit),
+              start_(std::chrono::steady_clock::now()) {
+        }
+
+        ~StageTimer() {
+            double seconds = secondsSince(start_);
+            double rate = seconds > 0.0 ? units_ / seconds : 0.0;
+            results_.push_back({stage_, events_, seconds, rate, unit_, peakRssMb()});
+        }
+
+    private:
+        std::vector<StageResult>& results_;
+        std::string stage_;
+        size_t events_;
+        double units_;
+        std::string unit_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    std::set<MicroPattern> buildSuspiciousPatterns(uint64_t seed) {
+        // main.cpp와 같은 규칙: 사람 기준 로그에서 2회 이하로 나온 패턴
+        TraceGenerator::Options options;
+        options.profile = TraceGenerator::Profile::HUMAN;
+        options.seed = seed + 1000;
+        TraceGenerator generator(options);
+        PatternCounter baseline = PatternAnalyzer::calculatePackedPatternFrequencies(generator.generate(100000));
+
+        std::set<MicroPattern> suspiciousPatterns;
+        for (const auto& pair : baseline.toSortedPairs()) {
+            if (pair.second <= 2) {
+                suspiciousPatterns.insert(pair.first);
+            }
+        }
+        return suspiciousPatterns;
+    }
+
+    void runSize(size_t eventCount, const TraceGenerator::Options& generatorOptions, const std::string& directory,
+        bool keepFiles, const std::set<MicroPattern>& suspiciousPatterns, std::vector<StageResult>& results) {
+        const std::string logFilename = directory + "/bench_" + std::to_string(eventCount) + ".csv";
+        const std::string outputFilename = directory + "/bench_" + std::to_string(eventCount) + "_analysis.csv";
+
+        {
+            StageTimer timer(results, "generate", eventCount, static_cast<double>(eventCount), "events/s");
+            TraceGenerator generator(generatorOptions);
+            generator.writeCsv(logFilename, eventCount);
+        }
+
+        std::vector<InputEvent> events;
+        {
+            StageTimer timer(results, "parseLogFile", eventCount, static_cast<double>(eventCount), "events/s");
+            events = PatternAnalyzer::parseLogFile(logFilename);
+        }
+        events.clear();
+        events.shrink_to_fit();
+        {
+            StageTimer timer(results, "parseLogFileMapped", eventCount, static_cast<double>(eventCount), "events/s");
+            events = PatternAnalyzer::parseLogFileMapped(logFilename);
+        }
+
+        {
+            StageTimer timer(results, "calculateMicroPatternFrequencies", eventCount,
+                static_cast<double>(eventCount), "events/s");
+            PatternFrequencyMap frequencies = PatternAnalyzer::calculateMicroPatternFrequencies(events);
+        }
+
+        PatternCounter frequencies;
+        {
+            StageTimer timer(results, "calculatePackedPatternFrequencies", eventCount,
+                static_cast<double>(eventCount), "events/s");
+            frequencies = PatternAnalyzer::calculatePackedPatternFrequencies(events);
+        }
+        const long long totalInstances = frequencies.totalInstances();
+
+        // 열 지향 스캔: 빌드에 포함된 커널과 스칼라 구현을 각각 측정하고 두 결과가 같은지 확인
+        {
+            const ExtractionConfig config;
+            const EventColumns columns = EventColumns::fromEvents(events);
+            ColumnScan::Masks masks;
+            ColumnScan::Masks scalarMasks;
+            {
+                StageTimer timer(results, std::string("ColumnScan::scan (") + ColumnScan::kernelName() + ")", eventCount,
+                    static_cast<double>(eventCount), "events/s");
+                ColumnScan::scan(columns, config.startKeys, config.timeThresholdMs, masks);
+            }
+            {
+                StageTimer timer(results, "ColumnScan::scanScalar", eventCount, static_cast<double>(eventCount), "events/s");
+                ColumnScan::scanScalar(columns, config.startKeys, config.timeThresholdMs, scalarMasks);
+            }
+            if (masks.starts != scalarMasks.starts || masks.breaks != scalarMasks.breaks) {
+                throw std::runtime_error(std::string("Column scan kernel ") + ColumnScan::kernelName() +
+                    " does not match the scalar scan at " + std::to_string(eventCount) + " events");
+            }
+        }
+
+        FeatureVector features;
+        double top2 = 0.0;
+        double top5 = 0.0;
+        int coverage = 0;
+        double suspicious = 0.0;
+        {
+            StageTimer timer(results, "sort+features", eventCount, static_cast<double>(frequencies.size()), "patterns/s");
+            features = FeatureVector(frequencies);
+            top2 = features.topNConcentration(2);
+            top5 = features.topNConcentration(5);
+            coverage = features.coveragePatternCount(50.0);
+            suspicious = PatternAnalyzer::calculateSuspiciousPatternScore(frequencies, totalInstances, suspiciousPatterns);
+        }
+
+        // 점수 계산은 O(1)이라 한 번으로는 측정되지 않으므로 반복 호출
+        const int scoreIterations = 1000000;
+        double finalScore = 0.0;
+        {
+            StageTimer timer(results, "calculateBotSuspicionScore", eventCount,
+                static_cast<double>(scoreIterations), "calls/s");
+            volatile double sink = 0.0;
+            for (int i = 0; i < scoreIterations; ++i) {
+                sink = sink + PatternAnalyzer::calculateBotSuspicionScore(top2 + i * 1e-9, top5, coverage, suspicious);
+            }
+            finalScore = PatternAnalyzer::calculateBotSuspicionScore(top2, top5, coverage, suspicious);
+        }
+
+        {
+            StageTimer timer(results, "saveAnalysisResults", eventCount,
+                static_cast<double>(features.uniquePatterns()), "patterns/s");
+            PatternAnalyzer::saveAnalysisResults(outputFilename, features, top2, top5, coverage,
+                suspicious, finalScore);
+        }
+
+        std::cout << "  " << eventCount << " events: " << features.uniquePatterns() << " patterns, "
+            << totalInstances << " instances, final score " << std::fixed << std::setprecision(4) << finalScore
+            << (PatternAnalyzer::isBotSuspected(finalScore) ? " (bot)" : " (human)") << std::endl;
+
+        if (!keepFiles) {
+            std::remove(logFilename.c_str());
+            std::remove(outputFilename.c_str());
+        }
+    }
+
+    void printResults(const std::vector<StageResult>& results) {
+        std::cout << std::left << std::setw(36) << "stage" << std::right << std::setw(12) << "events"
+            << std::setw(12) << "seconds" << std::setw(16) << "throughput" << "  " << std::left << std::setw(12) << "unit"
+            << std::right << std::setw(12) << "peak RSS MB" << std::endl;
+        for (const StageResult& result : results) {
+            std::cout << std::left << std::setw(36) << result.stage << std::right << std::setw(12) << result.events
+                << std::setw(12) << std::fixed << std::setprecision(4) << result.seconds
+                << std::setw(16) << std::setprecision(0) << result.unitsPerSecond << "  "
+                << std::left << std::setw(12) << result.unit
+                << std::right << std::setw(12) << std::setprecision(1) << result.peakRssMb << std::endl;
+        }
+    }
+
+    void saveResults(const std::vector<StageResult>& results, const std::string& filename) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+        file << "stage,events,seconds,throughput,unit,peak_rss_mb\n";
+        for (const StageResult& result : results) {
+            file << result.stage << "," << result.events << "," << std::fixed << std::setprecision(6) << result.seconds
+                << "," << std::setprecision(1) << result.unitsPerSecond << "," << result.unit << ","
+                << result.peakRssMb << "\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    TraceGenerator::Options generatorOptions;
+    std::vector<size_t> sizes = { 1000, 10000, 100000, 1000000, 10000000 };
+    size_t maxEvents = 10000000;
+    std::string directory = ".";
+    std::string resultFilename;
+    std::string generateFilename;
+    size_t generateEvents = 100000;
+    bool keepFiles = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--sizes" && hasValue) {
+                sizes = parseSizes(argv[++i]);
+            }
+            else if (arg == "--max-events" && hasValue) {
+                maxEvents = parseCount(argv[++i]);
+            }
+            else if (arg == "--profile" && hasValue) {
+                if (!TraceGenerator::parseProfile(argv[++i], generatorOptions.profile)) {
+                    std::cerr << "Unknown profile: " << argv[i] << " (bot|human)" << std::endl;
+                    return 1;
+                }
+            }
+            else if (arg == "--seed" && hasValue) {
+                generatorOptions.seed = std::stoull(argv[++i]);
+            }
+            else if (arg == "--dir" && hasValue) {
+                directory = argv[++i];
+            }
+            else if (arg == "--csv" && hasValue) {
+                resultFilename = argv[++i];
+            }
+            else if (arg == "--keep") {
+                keepFiles = true;
+            }
+            else if (arg == "--generate" && hasValue) {
+                generateFilename = argv[++i];
+            }
+            else if (arg == "--events" && hasValue) {
+                generateEvents = parseCount(argv[++i]);
+            }
+            else {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                return 1;
+            }
+        }
+
+        if (!generateFilename.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            TraceGenerator generator(generatorOptions);
+            generator.writeCsv(generateFilename, generateEvents);
+            std::cout << "Wrote " << generateEvents << " events to " << generateFilename << " in "
+                << std::fixed << std::setprecision(3) << secondsSince(start) << " s" << std::endl;
+            return 0;
+        }
+
+        // 10^8 이벤트 CSV는 약 2.5GB이므로 --max-events로 명시해야 실행
+        const std::set<MicroPattern> suspiciousPatterns = buildSuspiciousPatterns(generatorOptions.seed);
+        std::vector<StageResult> results;
+        std::cout << "Profile: " << (generatorOptions.profile == TraceGenerator::Profile::BOT ? "bot" : "human")
+            << ", seed " << generatorOptions.seed << ", column scan kernel " << ColumnScan::kernelName() << std::endl;
+        for (size_t eventCount : sizes) {
+            if (eventCount > maxEvents) {
+                std::cout << "  skipping " << eventCount << " events (above --max-events " << maxEvents << ")" << std::endl;
+                continue;
+            }
+            runSize(eventCount, generatorOptions, directory, keepFiles, suspiciousPatterns, results);
+        }
+
+        printResults(results);
+        if (!resultFilename.empty()) {
+            saveResults(results, resultFilename);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+// 동시 세션 메모리 벤치마크: 세션 N개의 StreamingPatternAnalyzer를 동시에 유지하며 세션당/이벤트당 바이트 측정
+// 사용법:
+//   SessionMemoryBench [--sessions <n>] [--events <세션당 이벤트 수>] [--batch <n>] [--budget <KB>] [--heap]
+//                      [<log> ...]
+// - 로그를 주지 않으면 합성 트레이스(봇/사람 번갈아 16개)를 사용, 세션 i는 로그 (i % 로그 수)를 재생
+// - 탐지 데몬처럼 모든 세션에 batch개씩 번갈아 넣으므로 세션들의 할당이 서로 섞임
+// - 기본은 워커 하나의 SlabPool + 세션별 SessionArena, --heap이면 기본 힙(new/delete)과 비교
+// - bytes/event = 세션 상태 전체 / 세션들이 처리한 이벤트 수 (이벤트가 윈도우 안에 있을 때 의미 있음)
+#define NOMINMAX
+#include "../include/PatternAnalyzer.h"
+#include "../include/SessionArena.h"
+#include "../include/StreamingPatternAnalyzer.h"
+#include "../include/TraceGenerator.h"
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#include <fstream>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    // 현재 상주 메모리 (바이트)
+    size_t currentRssBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.WorkingSetSize;
+        }
+        return 0;
+#else
+        std::ifstream statm("/proc/self/statm");
+        size_t totalPages = 0;
+        size_t residentPages = 0;
+        statm >> totalPages >> residentPages;
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct BenchSession {
+        std::unique_ptr<SessionArena> arena; // --heap이면 없음
+        std::unique_ptr<StreamingPatternAnalyzer> analyzer;
+        size_t logIndex = 0;
+        size_t nextEvent = 0;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    size_t sessionCount = 50000;
+    size_t eventsPerSession = 5000;
+    size_t batchEvents = 64;
+    size_t budgetBytes = 0;
+    bool useHeap = false;
+    std::vector<std::string> logFilenames;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--sessions" && hasValue) {
+                sessionCount = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--events" && hasValue) {
+                eventsPerSession = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--batch" && hasValue) {
+                batchEvents = std::max<size_t>(1, std::stoul(argv[++i]));
+            }
+            else if (arg == "--budget" && hasValue) {
+                budgetBytes = static_cast<size_t>(std::stoul(argv[++i])) * 1024;
+            }
+            else if (arg == "--heap") {
+                useHeap = true;
+            }
+            else {
+                logFilenames.push_back(arg);
+            }
+        }
+
+        std::vector<std::vector<InputEvent>> logs;
+        for (const std::string& filename : logFilenames) {
+            logs.push_back(PatternAnalyzer::parseEventLogFile(filename));
+        }
+        if (logs.empty()) {
+            for (uint64_t seed = 1; seed <= 16; ++seed) {
+                TraceGenerator::Options options;
+                options.profile = seed % 2 ? TraceGenerator::Profile::BOT : TraceGenerator::Profile::HUMAN;
+                options.seed = seed;
+                logs.push_back(TraceGenerator(options).generate(eventsPerSession));
+            }
+        }
+
+        const size_t rssBefore = currentRssBytes();
+        SlabPool pool;
+        std::vector<BenchSession> sessions(sessionCount);
+        StreamingPatternAnalyzer::Options options;
+        for (size_t i = 0; i < sessionCount; ++i) {
+            BenchSession& session = sessions[i];
+            session.logIndex = i % logs.size();
+            std::pmr::memory_resource* memory = std::pmr::get_default_resource();
+            if (!useHeap) {
+                session.arena = std::make_unique<SessionArena>(pool, budgetBytes);
+                memory = session.arena.get();
+            }
+            session.analyzer = std::make_unique<StreamingPatternAnalyzer>(options, memory);
+        }
+
+        // 모든 세션에 batchEvents개씩 번갈아 입력
+        auto startTime = std::chrono::steady_clock::now();
+        bool remaining = true;
+        while (remaining) {
+            remaining = false;
+            for (BenchSession& session : sessions) {
+                const std::vector<InputEvent>& log = logs[session.logIndex];
+                const size_t end = std::min({log.size(), eventsPerSession, session.nextEvent + batchEvents});
+                for (; session.nextEvent < end; ++session.nextEvent) {
+                    session.analyzer->addEvent(log[session.nextEvent]);
+                }
+                remaining = remaining || end < std::min(log.size(), eventsPerSession);
+            }
+        }
+        const double feedSeconds = secondsSince(startTime);
+
+        uint64_t totalEvents = 0;
+        uint64_t windowInstances = 0;
+        size_t degradedSessions = 0;
+        long long droppedInstances = 0;
+        long long earlyExpiredInstances = 0;
+        for (const BenchSession& session : sessions) {
+            totalEvents += static_cast<uint64_t>(session.analyzer->eventsProcessed());
+            windowInstances += session.analyzer->windowInstances();
+            if (session.analyzer->isDegraded()) {
+                degradedSessions++;
+            }
+            droppedInstances += session.analyzer->droppedInstances();
+            earlyExpiredInstances += session.analyzer->earlyExpiredInstances();
+        }
+        const size_t rssAfter = currentRssBytes();
+        const size_t rssBytes = rssAfter > rssBefore ? rssAfter - rssBefore : 0;
+        const size_t sessionBytes = pool.bytesInUse();
+
+        startTime = std::chrono::steady_clock::now();
+        sessions.clear();
+        const double freeSeconds = secondsSince(startTime);
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << sessionCount << " sessions (" << (useHeap ? "heap" : "slab arena");
+        if (!useHeap && budgetBytes > 0) {
+            std::cout << ", budget " << budgetBytes / 1024 << " KB";
+        }
+        std::cout << "), " << totalEvents << " events, " << windowInstances << " window instances" << std::endl;
+        std::cout << "Feed: " << feedSeconds << " s (" << std::setprecision(0) << totalEvents / std::max(feedSeconds, 1e-9)
+            << " events/s)" << std::endl;
+        std::cout << std::setprecision(1);
+        if (!useHeap) {
+            std::cout << "Session state: " << sessionBytes / (1024.0 * 1024.0) << " MB, "
+                << static_cast<double>(sessionBytes) / sessionCount << " bytes/session, "
+                << static_cast<double>(sessionBytes) / std::max<uint64_t>(1, totalEvents) << " bytes/event, "
+                << static_cast<double>(sessionBytes) / std::max<uint64_t>(1, windowInstances) << " bytes/instance"
+                << std::endl;
+        }
+        std::cout << "RSS growth: " << rssBytes / (1024.0 * 1024.0) << " MB, "
+            << static_cast<double>(rssBytes) / sessionCount << " bytes/session, "
+            << static_cast<double>(rssBytes) / std::max<uint64_t>(1, totalEvents) << " bytes/event" << std::endl;
+        std::cout << "Degraded sessions: " << degradedSessions << " (early expired " << earlyExpiredInstances
+            << ", dropped " << droppedInstances << " instances)" << std::endl;
+        std::cout << "Teardown: " << std::setprecision(3) << freeSeconds * 1e6 / std::max<size_t>(1, sessionCount)
+            << " us/session" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,3 +1,5 @@
+import os
+
 import pandas as pd
 import matplotlib.pyplot as plt
 import seaborn as sns
@@ -19,6 +21,13 @@ def load_analysis(filename):
     return patterns, metrics
 
 
+# 배치 분석 결과 로드 (--batch --out 의 CSV 또는 JSON lines)
+def load_fleet(filename):
+    if filename.endswith((".jsonl", ".ndjson")):
+        return pd.read_json(filename, lines=True)
+    return pd.read_csv(filename)
+
+
 # 봇과 사람 데이터 로드
 bot_patterns, bot_metrics = load_analysis("./build/bot_analysis.csv")
 human_patterns, human_metrics = load_analysis("./build/human_analysis.csv")
@@ -71,3 +80,22 @@ plt.ylabel("Count")
 plt.tight_layout()
 plt.savefig("boxplot_comparison.png", dpi=300, bbox_inches="tight")
 plt.close()
+
+# 4. 세션별 최종 점수 분포 (배치 분석 결과가 있을 때)
+fleet_files = [f for f in ("./build/batch_results.jsonl", "./build/batch_results.csv") if os.path.exists(f)]
+if fleet_files:
+    fleet = load_fleet(fleet_files[0])
+    plt.figure(figsize=(10, 6))
+    plt.hist(
+        [fleet.loc[fleet["suspected"] == 1, "final_score"], fleet.loc[fleet["suspected"] == 0, "final_score"]],
+        bins=20,
+        stacked=True,
+        label=["Suspected", "Not suspected"],
+        edgecolor="black",
+    )
+    plt.xlabel("Final Score")
+    plt.ylabel("Sessions")
+    plt.title(f"Session Score Distribution ({len(fleet)} sessions)")
+    plt.legend()
+    plt.savefig("fleet_score_distribution.png", dpi=300, bbox_inches="tight")
+    plt.close()